@@ -0,0 +1,171 @@
+#pragma once
+
+#include <cstdint>
+
+// BITBOARDS
+// Whole-board tile sets as 256-bit masks, shared by c.cpp and
+// semi_ai_smitmax.cpp. League maps are at most 20x10 (GridMaker.MAX_HEIGHT
+// with GRID_W_RATIO) and the tutorial map is 17x12, so every map fits in four
+// 64-bit words. Tile (x, y) is bit y * width + x; the row stride is the real
+// map width, and horizontal shifts are masked so they never wrap between rows.
+
+struct Bitboard {
+    uint64_t w[4] = {0, 0, 0, 0};
+
+    bool test(int index) const { return (w[index >> 6] >> (index & 63)) & 1; }
+    void set(int index) { w[index >> 6] |= uint64_t(1) << (index & 63); }
+    void reset(int index) { w[index >> 6] &= ~(uint64_t(1) << (index & 63)); }
+
+    bool any() const { return (w[0] | w[1] | w[2] | w[3]) != 0; }
+    int count() const {
+        return __builtin_popcountll(w[0]) + __builtin_popcountll(w[1])
+             + __builtin_popcountll(w[2]) + __builtin_popcountll(w[3]);
+    }
+
+    Bitboard operator&(const Bitboard& o) const { Bitboard r; for (int i = 0; i < 4; i++) r.w[i] = w[i] & o.w[i]; return r; }
+    Bitboard operator|(const Bitboard& o) const { Bitboard r; for (int i = 0; i < 4; i++) r.w[i] = w[i] | o.w[i]; return r; }
+    Bitboard operator^(const Bitboard& o) const { Bitboard r; for (int i = 0; i < 4; i++) r.w[i] = w[i] ^ o.w[i]; return r; }
+    Bitboard& operator&=(const Bitboard& o) { for (int i = 0; i < 4; i++) w[i] &= o.w[i]; return *this; }
+    Bitboard& operator|=(const Bitboard& o) { for (int i = 0; i < 4; i++) w[i] |= o.w[i]; return *this; }
+    // Bits of this board that are not in o
+    Bitboard minus(const Bitboard& o) const { Bitboard r; for (int i = 0; i < 4; i++) r.w[i] = w[i] & ~o.w[i]; return r; }
+
+    bool operator==(const Bitboard& o) const {
+        return w[0] == o.w[0] && w[1] == o.w[1] && w[2] == o.w[2] && w[3] == o.w[3];
+    }
+
+    // Shift towards higher / lower tile indices. Bits shifted past bit 255 are
+    // dropped; callers mask the result with the board.
+    Bitboard shl(int n) const {
+        Bitboard r;
+        int q = n >> 6, s = n & 63;
+        for (int i = 3; i >= q; i--) {
+            r.w[i] = w[i - q] << s;
+            if (s && i - q > 0) r.w[i] |= w[i - q - 1] >> (64 - s);
+        }
+        return r;
+    }
+    Bitboard shr(int n) const {
+        Bitboard r;
+        int q = n >> 6, s = n & 63;
+        for (int i = 0; i + q < 4; i++) {
+            r.w[i] = w[i + q] >> s;
+            if (s && i + q < 3) r.w[i] |= w[i + q + 1] << (64 - s);
+        }
+        return r;
+    }
+
+    // Calls f(index) for every set bit, lowest index first
+    template <typename F>
+    void for_each(F f) const {
+        for (int i = 0; i < 4; i++) {
+            uint64_t word = w[i];
+            while (word) {
+                f(i * 64 + __builtin_ctzll(word));
+                word &= word - 1;
+            }
+        }
+    }
+};
+
+// Map dimensions plus the masks every shift needs
+struct BoardGeometry {
+    static const int MAX_TILES = 256;
+
+    int width = 0, height = 0;
+    Bitboard board;      // Every tile of the map
+    Bitboard not_west;   // Every tile except column 0
+    Bitboard not_east;   // Every tile except column width - 1
+
+    void init(int w, int h) {
+        width = w;
+        height = h;
+        board = not_west = not_east = Bitboard();
+        for (int y = 0; y < h; y++) {
+            for (int x = 0; x < w; x++) {
+                int i = index(x, y);
+                if (i >= MAX_TILES) continue;
+                board.set(i);
+                if (x > 0) not_west.set(i);
+                if (x < w - 1) not_east.set(i);
+            }
+        }
+    }
+
+    bool contains(int x, int y) const {
+        return x >= 0 && x < width && y >= 0 && y < height && index(x, y) < MAX_TILES;
+    }
+    int index(int x, int y) const { return y * width + x; }
+    int x_of(int index) const { return index % width; }
+    int y_of(int index) const { return index / width; }
+
+    Bitboard bit(int x, int y) const {
+        Bitboard b;
+        if (contains(x, y)) b.set(index(x, y));
+        return b;
+    }
+
+    // One-tile shifts; tiles pushed off the map disappear
+    Bitboard east(const Bitboard& b) const { return (b & not_east).shl(1); }
+    Bitboard west(const Bitboard& b) const { return (b & not_west).shr(1); }
+    Bitboard north(const Bitboard& b) const { return b.shr(width); }
+    Bitboard south(const Bitboard& b) const { return b.shl(width) & board; }
+
+    // b plus every tile orthogonally adjacent to it
+    Bitboard dilate4(const Bitboard& b) const {
+        return b | east(b) | west(b) | north(b) | south(b);
+    }
+    // b plus every tile king-adjacent to it (the 3x3 around each bit)
+    Bitboard dilate8(const Bitboard& b) const {
+        Bitboard row = b | east(b) | west(b);
+        return row | north(row) | south(row);
+    }
+
+    // Tiles at Manhattan distance <= radius of some bit of b
+    Bitboard within_manhattan(Bitboard b, int radius) const {
+        for (int i = 0; i < radius; i++) b = dilate4(b);
+        return b;
+    }
+    // Tiles at Chebyshev distance <= radius of some bit of b
+    Bitboard within_chebyshev(Bitboard b, int radius) const {
+        for (int i = 0; i < radius; i++) b = dilate8(b);
+        return b;
+    }
+};
+
+// Static tile layers of one map, built once from the initial grid input
+struct BoardLayers {
+    BoardGeometry geo;
+    Bitboard floor;       // Walkable tiles (type 0)
+    Bitboard low_cover;   // Type 1
+    Bitboard high_cover;  // Type 2
+
+    void init(int width, int height) {
+        geo.init(width, height);
+        floor = geo.board;
+        low_cover = high_cover = Bitboard();
+    }
+
+    void set_tile(int x, int y, int tile_type) {
+        if (!geo.contains(x, y)) return;
+        int i = geo.index(x, y);
+        floor.reset(i);
+        low_cover.reset(i);
+        high_cover.reset(i);
+        if (tile_type == 1) low_cover.set(i);
+        else if (tile_type == 2) high_cover.set(i);
+        else floor.set(i);
+    }
+
+    Bitboard cover() const { return low_cover | high_cover; }
+
+    // Tiles a MOVE can end on, given which tiles agents stand on
+    Bitboard walkable(const Bitboard& occupied) const { return floor.minus(occupied); }
+};
+
+// Tiles held by live agents, one mask per team
+struct Occupancy {
+    Bitboard team[2];
+
+    Bitboard all() const { return team[0] | team[1]; }
+};
@@ -13,13 +13,25 @@
 #include <stdexcept>
 #include <memory>
 #include <limits>
-#include <fstream>
+#include <cstdlib>
+#include "packed_action.h"
+#include "node_arena.h"
+#include "bitboard.h"
+#include "rules_engine.h"
+#include "threat_map.h"
+#include "root_parallel.h"
+#include "time_manager.h"
+#include "transposition_table.h"
 using namespace std;
 
-const bool WETNESS_AFFECTS_DISTANCE = true;
 const bool COLLISIONS = true;
-const int THROW_DAMAGE = 30;
 const int THROW_DISTANCE_MAX = 4;
+// Each iteration expands at most 8 children; searches run 20-30 iterations
+const int SMITSIMAX_ARENA_CAPACITY = 1024;
+// 2^14 buckets of 4 entries, 1 MB; kept across turns
+const int SMITSIMAX_TT_LOG2_BUCKETS = 14;
+// Most virtual visits a transposition's mean is worth to a new node
+const int SMITSIMAX_TT_PRIOR_VISITS = 4;
 
 enum class GameAgentClass {
     GUNNER,
@@ -30,71 +42,9 @@ enum class GameAgentClass {
 };
 
 struct GameMechanics {
-    static int calculate_exact_shooting_damage(int soaking_power, int optimal_range, int distance) {
-        if (distance > optimal_range || distance == 0) return 0;
-        
-        int base_damage = soaking_power;
-        
-        
-        if (distance > 1) {
-            double penalty = 0.25 * (distance - 1);
-            base_damage = (int)(base_damage * (1.0 - penalty));
-        }
-        
-        return max(0, base_damage);
-    }
-    
-    
-    static int calculate_exact_bomb_damage(int splash_distance, bool is_hunkered) {
-        if (splash_distance > 1) return 0; 
-        
-        int damage = THROW_DAMAGE;
-        if (is_hunkered) {
-            damage = damage / 2; 
-        }
-        
-        return damage;
-    }
-    
-    
-    static int calculate_movement_cost(int wetness) {
-        if (!WETNESS_AFFECTS_DISTANCE) return 1;
-        
-        double wetness_factor = 1.0 + (wetness * 0.01); 
-        return (int)ceil(wetness_factor);
-    }
-    
-    
-    static bool is_valid_movement_position(int x, int y, int board_width, int board_height, 
-                                         const vector<vector<int>>& tile_map,
-                                         const vector<pair<int, int>>& occupied_positions) {
-        
-        if (x < 0 || x >= board_width || y < 0 || y >= board_height) return false;
-        
-        
-        for (const auto& pos : occupied_positions) {
-            if (pos.first == x && pos.second == y) return false;
-        }
-        
-        
-        
-        return true;
-    }
-    
-    
-    static bool provides_cover(int x, int y, int board_width, int board_height, 
-                              const vector<vector<int>>& tile_map) {
-        if (x < 0 || x >= board_width || y < 0 || y >= board_height) return false;
-        if (y >= 0 && y < tile_map.size() && x >= 0 && x < tile_map[0].size()) {
-            return tile_map[y][x] == 1; 
-        }
-        return false;
-    }
-    
-    
-    static double calculate_kill_probability(int current_wetness, int damage) {
-        if (current_wetness + damage >= 100) return 1.0;
-        return (double)(current_wetness + damage) / 100.0;
+    static bool is_valid_movement_position(int x, int y, const BoardLayers& board, const Bitboard& occupied) {
+        if (!board.geo.contains(x, y)) return false;
+        return board.walkable(occupied).test(board.geo.index(x, y));
     }
     
     
@@ -130,10 +80,7 @@ struct SmartGameAI {
     };
 
     struct TacticalDecision {
-        string action_type;
-        int target_x = -1, target_y = -1;
-        int target_agent_id = -1;
-        int bomb_x = -1, bomb_y = -1;  
+        PackedAction action;
         double expected_value = 0.0;
         double kill_probability = 0.0;
         int expected_damage = 0;
@@ -144,52 +91,41 @@ struct SmartGameAI {
     vector<int> my_agent_ids;
     vector<int> enemy_agent_ids;
     int board_width, board_height;
-    vector<vector<int>> tile_map;
-
-    struct GameSimulator {
-        string game_folder_path;
-        int simulation_id;
-        
-        GameSimulator() : game_folder_path("./game/"), simulation_id(0) {}
-        
-        void save_game_state(const vector<AgentState>& my_agents, const vector<AgentState>& enemies,
-                           int board_width, int board_height, const vector<vector<int>>& tile_map) {
-            
-            string state_file = game_folder_path + "simulation_state_" + to_string(simulation_id++) + ".txt";
-            ofstream file(state_file);
-            
-            if (file.is_open()) {
-                file << board_width << " " << board_height << "\n";
-                
-                for (int y = 0; y < board_height; y++) {
-                    for (int x = 0; x < board_width; x++) {
-                        if (y < (int)tile_map.size() && x < (int)tile_map[y].size()) {
-                            file << x << " " << y << " " << tile_map[y][x] << "\n";
-                        } else {
-                            file << x << " " << y << " 0\n";
-                        }
-                    }
-                }
-                
-                file << (my_agents.size() + enemies.size()) << "\n";
-                
-                for (const auto& agent : my_agents) {
-                    file << agent.agent_id << " " << agent.x << " " << agent.y << " "
-                         << agent.cooldown << "\n";
-                }
-                
-                for (const auto& agent : enemies) {
-                    file << agent.agent_id << " " << agent.x << " " << agent.y << " "
-                         << agent.cooldown << "\n";
-                }
-                
-                file.close();
-                cerr << "📁 Game state saved to: " << state_file << endl;
-            } else {
-                cerr << "❌ Failed to save game state to: " << state_file << endl;
-            }
+    RulesTable table;  // The map and its cover and distance lookups, built once; the search fills the slots
+    RulesPathfinder pathfinder;  // Main thread only; search workers bring their own
+    ThreatMap threats;
+    
+    
+    Occupancy build_occupancy(const vector<AgentState>& allies, const vector<AgentState>& enemies) const {
+        Occupancy occupancy;
+        for (const auto& ally : allies) {
+            if (ally.is_alive()) occupancy.team[0] |= table.board.geo.bit(ally.x, ally.y);
         }
-    };
+        for (const auto& enemy : enemies) {
+            if (enemy.is_alive()) occupancy.team[1] |= table.board.geo.bit(enemy.x, enemy.y);
+        }
+        return occupancy;
+    }
+    
+    int walking_distance(int x1, int y1, int x2, int y2) const {
+        return table.distance.steps(table.board.geo.index(x1, y1), table.board.geo.index(x2, y2));
+    }
+    
+    void update_threats(const vector<AgentState>& allies, const vector<AgentState>& enemies) {
+        vector<ThreatSource> sources;
+        for (const auto& enemy : enemies) {
+            if (!enemy.is_alive()) continue;
+            const AgentData& data = all_agents_data.at(enemy.agent_id);
+            sources.push_back({enemy.x, enemy.y, data.optimal_range, data.soaking_power, enemy.cooldown, enemy.splash_bombs});
+        }
+        threats.build(table.board, table.cover, build_occupancy(allies, enemies).all(), sources.data(), (int)sources.size());
+    }
+    
+    int move_landing(RulesPathfinder& finder, const AgentState& agent, int x, int y, const Bitboard& occupied) const {
+        int from = table.board.geo.index(agent.x, agent.y);
+        int step = finder.next_step(table.board, from, x, y, occupied);
+        return step >= 0 ? step : from;
+    }
 
     GameAgentClass determine_agent_class(const AgentData& data) {
         if (data.optimal_range == 6 && data.soaking_power == 24) return GameAgentClass::SNIPER;
@@ -209,157 +145,15 @@ struct SmartGameAI {
         }
     }
 
-    TacticalDecision evaluate_exact_shooting(const AgentState& agent, const vector<AgentState>& enemies) {
-        TacticalDecision best_shot;
-        best_shot.action_type = "HUNKER_DOWN";
-        best_shot.expected_value = 0;
-        
-        if (agent.cooldown > 0) {
-            best_shot.tactical_reasoning = "Agent on cooldown";
-            return best_shot;
-        }
-        
-        if (enemies.empty()) {
-            best_shot.tactical_reasoning = "No enemies visible";
-            return best_shot;
-        }
-        
-        const AgentData& data = all_agents_data.at(agent.agent_id);
-        GameAgentClass agent_class = data.agent_class;
-        
-        cerr << "Evaluating shooting for agent " << agent.agent_id << " against " << enemies.size() << " enemies" << endl;
-        
-        for (const auto& enemy : enemies) {
-            if (!enemy.is_alive()) continue;
-            
-            int distance = abs(agent.x - enemy.x) + abs(agent.y - enemy.y);
-            int damage = GameMechanics::calculate_exact_shooting_damage(data.soaking_power, data.optimal_range, distance);
-            
-            cerr << "  Enemy " << enemy.agent_id << " at distance " << distance << " -> damage " << damage << endl;
-            
-            if (damage > 0) {
-                double kill_prob = GameMechanics::calculate_kill_probability(enemy.wetness, damage);
-                double expected_value = damage * 100.0; 
-                
-                
-                if (kill_prob >= 1.0) {
-                    expected_value += 5000.0; 
-                } else {
-                    expected_value += kill_prob * 3000.0; 
-                }
-                
-                if (agent_class == GameAgentClass::SNIPER && distance >= 4) {
-                    expected_value += 2000.0; 
-                }
-                if (agent_class == GameAgentClass::GUNNER && distance <= 2) {
-                    expected_value += 1000.0; 
-                }
-                if (agent_class == GameAgentClass::BERSERKER && distance <= 2) {
-                    expected_value += 1500.0;
-                }
-                
-                double wound_multiplier = 1.0 + (enemy.wetness / 100.0);
-                expected_value *= wound_multiplier;
-                
-                cerr << "    Expected value: " << (int)expected_value << " (kill prob: " << (int)(kill_prob*100) << "%)" << endl;
-                
-                if (expected_value > best_shot.expected_value) {
-                    best_shot.action_type = "SHOOT";
-                    best_shot.target_agent_id = enemy.agent_id;
-                    best_shot.expected_value = expected_value;
-                    best_shot.kill_probability = kill_prob;
-                    best_shot.expected_damage = damage;
-                    best_shot.tactical_reasoning = "Shoot enemy " + to_string(enemy.agent_id) + 
-                        " for " + to_string(damage) + " damage (kill prob: " + 
-                        to_string((int)(kill_prob * 100)) + "%) at distance " + to_string(distance);
-                }
-            }
-        }
-        
-        return best_shot;
-    }
-
-    TacticalDecision evaluate_exact_bombing(const AgentState& agent, const vector<AgentState>& enemies) {
-        TacticalDecision best_bomb;
-        best_bomb.action_type = "HUNKER_DOWN";
-        best_bomb.expected_value = 0;
-        
-        if (agent.cooldown > 0 || agent.splash_bombs <= 0) {
-            best_bomb.tactical_reasoning = "No bombs available or on cooldown";
-            return best_bomb;
-        }
-        
-        for (const auto& primary_target : enemies) {
-            if (!primary_target.is_alive()) continue;
-            
-            int throw_distance = abs(agent.x - primary_target.x) + abs(agent.y - primary_target.y);
-            if (throw_distance > THROW_DISTANCE_MAX) continue;
-            
-            vector<int> targets_hit;
-            int total_expected_damage = 0;
-            double total_kill_probability = 0.0;
-            
-            for (const auto& enemy : enemies) {
-                if (!enemy.is_alive()) continue;
-                
-                int splash_distance = abs(primary_target.x - enemy.x) + abs(primary_target.y - enemy.y);
-                int damage = GameMechanics::calculate_exact_bomb_damage(splash_distance, false);
-                
-                if (damage > 0) {
-                    targets_hit.push_back(enemy.agent_id);
-                    total_expected_damage += damage;
-                    total_kill_probability += GameMechanics::calculate_kill_probability(enemy.wetness, damage);
-                }
-            }
-            
-            if (!targets_hit.empty()) {
-                double expected_value = total_expected_damage * 40.0;
-                expected_value += total_kill_probability * 1500.0; 
-                
-                if (targets_hit.size() > 1) {
-                    expected_value += targets_hit.size() * 1200.0;
-                }
-                
-                if (expected_value > best_bomb.expected_value) {
-                    best_bomb.action_type = "THROW";
-                    best_bomb.target_x = primary_target.x;
-                    best_bomb.target_y = primary_target.y;
-                    best_bomb.expected_value = expected_value;
-                    best_bomb.expected_damage = total_expected_damage;
-                    best_bomb.kill_probability = total_kill_probability;
-                    best_bomb.tactical_reasoning = "Bomb at (" + to_string(primary_target.x) + 
-                        "," + to_string(primary_target.y) + ") hits " + to_string(targets_hit.size()) + 
-                        " enemies for " + to_string(total_expected_damage) + " total damage";
-                }
-            }
-        }
-        
-        return best_bomb;
-    }
-
     TacticalDecision evaluate_cover_strategy(const AgentState& agent, const vector<AgentState>& enemies, const vector<AgentState>& allies) {
         TacticalDecision cover_decision;
-        cover_decision.action_type = "HUNKER_DOWN";
+        cover_decision.action = PackedAction::hunker_down();
         cover_decision.expected_value = 0;
         
-        int immediate_threats = 0;
-        int total_enemy_damage_potential = 0;
-        bool under_heavy_fire = false;
-        
-        for (const auto& enemy : enemies) {
-            if (!enemy.is_alive()) continue;
-            
-            int distance = abs(agent.x - enemy.x) + abs(agent.y - enemy.y);
-            
-            if (distance <= 4) {
-                immediate_threats++;
-                total_enemy_damage_potential += 20;
-            }
-            if (enemy.splash_bombs > 0 && distance <= 4) {
-                total_enemy_damage_potential += 30;
-                under_heavy_fire = true;
-            }
-        }
+        int here = table.board.geo.index(agent.x, agent.y);
+        int immediate_threats = threats.shooters[here];
+        int total_enemy_damage_potential = threats.incoming[here];
+        bool under_heavy_fire = threats.splashing[here] > 0;
         bool should_seek_cover = false;
         string cover_reason = "";
         if (agent.get_health() <= 50 && immediate_threats >= 2) {
@@ -382,56 +176,42 @@ struct SmartGameAI {
             cover_decision.tactical_reasoning = "No need for cover - continue aggressive tactics";
             return cover_decision;
         }
-        vector<pair<int, int>> cover_positions;
+        Bitboard occupied;
+        for (const auto& ally : allies) {
+            if (ally.agent_id != agent.agent_id && ally.is_alive()) occupied.set(table.board.geo.index(ally.x, ally.y));
+        }
+        for (const auto& enemy : enemies) {
+            if (enemy.is_alive()) occupied.set(table.board.geo.index(enemy.x, enemy.y));
+        }
+        Bitboard free_tiles = table.board.walkable(occupied);
+        
+        int best_incoming = INT_MAX, best_distance = INT_MAX;
+        pair<int, int> best_cover = {-1, -1};
         for (int dx = -2; dx <= 2; dx++) {
             for (int dy = -2; dy <= 2; dy++) {
                 int cx = agent.x + dx;
                 int cy = agent.y + dy;
-                
-                if (GameMechanics::provides_cover(cx, cy, board_width, board_height, tile_map)) {
-                    bool occupied = false;
-                    for (const auto& ally : allies) {
-                        if (ally.agent_id != agent.agent_id && ally.x == cx && ally.y == cy) {
-                            occupied = true;
-                            break;
-                        }
-                    }
-                    for (const auto& enemy : enemies) {
-                        if (enemy.x == cx && enemy.y == cy) {
-                            occupied = true;
-                            break;
-                        }
-                    }
-                    
-                    if (!occupied) {
-                        cover_positions.push_back({cx, cy});
-                    }
+                if (!table.board.geo.contains(cx, cy)) continue;
+                int tile = table.board.geo.index(cx, cy);
+                if (!free_tiles.test(tile) && !(dx == 0 && dy == 0)) continue;
+                
+                int incoming = threats.incoming[tile];
+                int distance = abs(dx) + abs(dy);
+                if (incoming < best_incoming || (incoming == best_incoming && distance < best_distance)) {
+                    best_incoming = incoming;
+                    best_distance = distance;
+                    best_cover = {cx, cy};
                 }
             }
         }
         
-        if (!cover_positions.empty()) {
-            int best_distance = INT_MAX;
-            pair<int, int> best_cover = {-1, -1};
+        if (best_incoming < threats.incoming[here] && best_distance > 0) {
+            cover_decision.action = PackedAction::move(best_cover.first, best_cover.second);
+            cover_decision.expected_value = 3000.0; 
+            cover_decision.tactical_reasoning = "🛡️ SEEK COVER at (" + to_string(best_cover.first) + 
+                "," + to_string(best_cover.second) + ") - " + cover_reason;
             
-            for (const auto& pos : cover_positions) {
-                int distance = abs(agent.x - pos.first) + abs(agent.y - pos.second);
-                if (distance < best_distance) {
-                    best_distance = distance;
-                    best_cover = pos;
-                }
-            }
-            
-            if (best_cover.first != -1) {
-                cover_decision.action_type = "MOVE";
-                cover_decision.target_x = best_cover.first;
-                cover_decision.target_y = best_cover.second;
-                cover_decision.expected_value = 3000.0; 
-                cover_decision.tactical_reasoning = "🛡️ SEEK COVER at (" + to_string(best_cover.first) + 
-                    "," + to_string(best_cover.second) + ") - " + cover_reason;
-                
-                cerr << "🛡️ Agent " << agent.agent_id << " seeking cover: " << cover_reason << endl;
-            }
+            cerr << "🛡️ Agent " << agent.agent_id << " seeking cover: " << cover_reason << endl;
         }
         
         return cover_decision;
@@ -439,7 +219,7 @@ struct SmartGameAI {
     
     TacticalDecision evaluate_sniper_strategy(const AgentState& agent, const vector<AgentState>& enemies, const vector<AgentState>& allies) {
         TacticalDecision sniper_decision;
-        sniper_decision.action_type = "HUNKER_DOWN";
+        sniper_decision.action = PackedAction::hunker_down();
         sniper_decision.expected_value = 0;
         
         const AgentData& data = all_agents_data.at(agent.agent_id);
@@ -450,7 +230,6 @@ struct SmartGameAI {
         
         int my_team_health = 0;
         int enemy_team_health = 0;
-        int bombers_nearby = 0;
         
         for (const auto& ally : allies) {
             my_team_health += ally.get_health();
@@ -458,17 +237,12 @@ struct SmartGameAI {
         
         for (const auto& enemy : enemies) {
             enemy_team_health += enemy.get_health();
-            
-            int distance = abs(agent.x - enemy.x) + abs(agent.y - enemy.y);
-            if (enemy.splash_bombs > 0 && distance <= 6) {
-                bombers_nearby++;
-            }
         }
         
         
         bool team_advantage = (my_team_health >= enemy_team_health) && (allies.size() >= enemies.size());
         bool low_personal_health = agent.get_health() <= 60;
-        bool bomber_threat = bombers_nearby > 0;
+        bool bomber_threat = threats.splashing[table.board.geo.index(agent.x, agent.y)] > 0;
         
         
         bool should_keep_distance = false;
@@ -520,17 +294,10 @@ struct SmartGameAI {
                     target_y = max(0, min(board_height-1, target_y));
                     
                     
-                    vector<pair<int, int>> occupied;
-                    for (const auto& ally : allies) {
-                        if (ally.agent_id != agent.agent_id && ally.is_alive()) {
-                            occupied.push_back({ally.x, ally.y});
-                        }
-                    }
+                    Bitboard occupied = build_occupancy(allies, {}).team[0].minus(table.board.geo.bit(agent.x, agent.y));
                     
-                    if (GameMechanics::is_valid_movement_position(target_x, target_y, board_width, board_height, tile_map, occupied)) {
-                        sniper_decision.action_type = "MOVE";
-                        sniper_decision.target_x = target_x;
-                        sniper_decision.target_y = target_y;
+                    if (GameMechanics::is_valid_movement_position(target_x, target_y, table.board, occupied)) {
+                        sniper_decision.action = PackedAction::move(target_x, target_y);
                         sniper_decision.expected_value = 2500.0;
                         sniper_decision.tactical_reasoning = "🎯 SNIPER RETREAT to (" + to_string(target_x) + 
                             "," + to_string(target_y) + ") - " + strategy_reason;
@@ -546,110 +313,6 @@ struct SmartGameAI {
         return sniper_decision;
     }
     
-    TacticalDecision evaluate_tactical_movement(const AgentState& agent, const vector<AgentState>& enemies, const vector<AgentState>& allies) {
-        TacticalDecision best_move;
-        best_move.action_type = "HUNKER_DOWN";
-        best_move.expected_value = 0;
-        
-        const AgentData& data = all_agents_data.at(agent.agent_id);
-        GameAgentClass agent_class = data.agent_class;
-        
-        
-        vector<pair<int, int>> occupied;
-        for (const auto& ally : allies) {
-            if (ally.agent_id != agent.agent_id && ally.is_alive()) {
-                occupied.push_back({ally.x, ally.y});
-            }
-        }
-        for (const auto& enemy : enemies) {
-            if (enemy.is_alive()) {
-                occupied.push_back({enemy.x, enemy.y});
-            }
-        }
-        
-        
-        int dx[] = {-1, 1, 0, 0, -1, -1, 1, 1};
-        int dy[] = {0, 0, -1, 1, -1, 1, -1, 1};
-        
-        for (int i = 0; i < 8; i++) {
-            int nx = agent.x + dx[i];
-            int ny = agent.y + dy[i];
-            
-            
-            if (nx < 0 || nx >= board_width || ny < 0 || ny >= board_height) continue;
-            
-            
-            bool collision = false;
-            for (const auto& pos : occupied) {
-                if (pos.first == nx && pos.second == ny) {
-                    collision = true;
-                    break;
-                }
-            }
-            if (collision) continue;
-            
-            double expected_value = 150.0; 
-            
-            
-            int movement_cost = GameMechanics::calculate_movement_cost(agent.wetness);
-            if (movement_cost > 1) {
-                expected_value -= (movement_cost - 1) * 50.0; 
-            }
-            
-            
-            for (const auto& enemy : enemies) {
-                if (!enemy.is_alive()) continue;
-                
-                int current_distance = abs(agent.x - enemy.x) + abs(agent.y - enemy.y);
-                int new_distance = abs(nx - enemy.x) + abs(ny - enemy.y);
-                
-                
-                if (new_distance <= data.optimal_range && current_distance > data.optimal_range) {
-                    expected_value += 1000.0; 
-                }
-                
-                
-                if (new_distance <= data.optimal_range) {
-                    expected_value += 500.0;
-                }
-                
-                
-                switch (agent_class) {
-                    case GameAgentClass::SNIPER:
-                        if (new_distance >= 4 && new_distance <= 6) expected_value += 700.0;
-                        break;
-                    case GameAgentClass::BOMBER:
-                        if (new_distance <= 4) expected_value += 600.0;
-                        break;
-                    case GameAgentClass::BERSERKER:
-                        if (new_distance <= 2) expected_value += 800.0;
-                        break;
-                    default:
-                        if (new_distance <= 4) expected_value += 400.0;
-                }
-                
-                
-                if (enemy.wetness > 50 && new_distance < current_distance) {
-                    expected_value += 300.0;
-                }
-            }
-            
-            
-            if (expected_value > 1500.0) expected_value = 1500.0;
-            
-            if (expected_value > best_move.expected_value) {
-                best_move.action_type = "MOVE";
-                best_move.target_x = nx;
-                best_move.target_y = ny;
-                best_move.expected_value = expected_value;
-                best_move.tactical_reasoning = "Move to (" + to_string(nx) + "," + to_string(ny) + 
-                    ") for tactical advantage (value: " + to_string((int)expected_value) + ")";
-            }
-        }
-        
-        return best_move;
-    }
-
     TacticalDecision make_optimal_decision(const AgentState& agent, const vector<AgentState>& enemies, const vector<AgentState>& allies) {
         cerr << "Agent " << agent.agent_id << " (" << get_class_name(all_agents_data.at(agent.agent_id).agent_class) << ") ";
         cerr << "at (" << agent.x << "," << agent.y << ") HP=" << agent.get_health() << " CD=" << agent.cooldown << " Bombs=" << agent.splash_bombs << endl;
@@ -662,7 +325,7 @@ struct SmartGameAI {
         TacticalDecision best_shoot = find_best_shooting_target(agent, enemies);
         TacticalDecision best_bomb = find_best_bombing_target_with_allies(agent, enemies, allies);
         
-        if (critical_urgency && best_bomb.action_type == "THROW") {
+        if (critical_urgency && best_bomb.action.is(ACTION_THROW)) {
             best_bomb.expected_value *= 5.0;
             best_bomb.tactical_reasoning = "🚨 CRITICAL BOMB: " + best_bomb.tactical_reasoning;
             cerr << "🚨 CRITICAL BOMB BOOST: " << (int)best_bomb.expected_value << endl;
@@ -673,52 +336,44 @@ struct SmartGameAI {
         TacticalDecision cover_strategy = evaluate_cover_strategy(agent, enemies, allies);
         TacticalDecision sniper_strategy = evaluate_sniper_strategy(agent, enemies, allies);
         
-        vector<TacticalDecision> movement_options = generate_random_moves(agent, enemies, allies, 50);
+        vector<TacticalDecision> movement_options = generate_random_moves(agent, enemies, allies, 50, pathfinder);
         
         vector<TacticalDecision> all_options = {best_shoot, best_bomb, best_compound, cover_strategy, sniper_strategy};
         all_options.insert(all_options.end(), movement_options.begin(), movement_options.end());
         
         TacticalDecision optimal = expectimax_evaluate(agent, all_options, enemies, allies);
         
-        if (agent.splash_bombs > 0 && agent.get_health() <= 50 && best_bomb.action_type == "THROW") {
+        if (agent.splash_bombs > 0 && agent.get_health() <= 50 && best_bomb.action.is(ACTION_THROW)) {
             if (best_bomb.expected_value > optimal.expected_value * 0.5) {
                 cerr << "🧨 BOMB URGENCY OVERRIDE: Using bombs before death!" << endl;
                 optimal = best_bomb;
             }
         }
         
-        cerr << "FINAL DECISION: " << optimal.action_type << " (value: " << (int)optimal.expected_value << ")" << endl;
+        cerr << "FINAL DECISION: " << action_type_name(optimal.action.type()) << " (value: " << (int)optimal.expected_value << ")" << endl;
         
         return optimal;
     }
     
     TacticalDecision find_best_compound_action(const AgentState& agent, const vector<AgentState>& enemies, const vector<AgentState>& allies) {
         TacticalDecision best_compound;
-        best_compound.action_type = "HUNKER_DOWN";
+        best_compound.action = PackedAction::hunker_down();
         best_compound.expected_value = 0;
         
         
         const AgentData& data = all_agents_data.at(agent.agent_id);
         
-        vector<pair<int, int>> occupied;
-        for (const auto& ally : allies) {
-            if (ally.agent_id != agent.agent_id && ally.is_alive()) {
-                occupied.push_back({ally.x, ally.y});
-            }
-        }
-        for (const auto& enemy : enemies) {
-            if (enemy.is_alive()) {
-                occupied.push_back({enemy.x, enemy.y});
-            }
-        }
+        Bitboard self = table.board.geo.bit(agent.x, agent.y);
+        Bitboard occupied = build_occupancy(allies, enemies).all() | self;
+        Bitboard open_tiles = table.board.walkable(occupied.minus(self));
         
-        vector<pair<int, int>> movement_priorities;
+        Bitboard movement_candidates;
         
         const AgentState* closest_enemy = nullptr;
         int min_distance = INT_MAX;
         for (const auto& enemy : enemies) {
             if (!enemy.is_alive()) continue;
-            int distance = abs(agent.x - enemy.x) + abs(agent.y - enemy.y);
+            int distance = walking_distance(agent.x, agent.y, enemy.x, enemy.y);
             if (distance < min_distance) {
                 min_distance = distance;
                 closest_enemy = &enemy;
@@ -731,76 +386,31 @@ struct SmartGameAI {
             int target_y = closest_enemy->y;
             
             
-            for (int dx = -2; dx <= 2; dx++) {
-                for (int dy = -2; dy <= 2; dy++) {
-                    if (dx == 0 && dy == 0) continue;
-                    
-                    int nx = agent.x + dx;
-                    int ny = agent.y + dy;
-                    
-                    if (nx < 0 || nx >= board_width || ny < 0 || ny >= board_height) continue;
-                    if (!GameMechanics::is_valid_movement_position(nx, ny, board_width, board_height, tile_map, occupied)) continue;
-                    
-                    int new_distance = abs(nx - target_x) + abs(ny - target_y);
-                    
-                    
-                    if (new_distance < min_distance) {
-                        
-                        bool prefer_this_tile = true;
-                        if (ny >= 0 && ny < tile_map.size() && nx >= 0 && nx < tile_map[0].size()) {
-                            int tile_type = tile_map[ny][nx];
-                            if (tile_type == 1) { 
-                                prefer_this_tile = false;
-                            }
-                        }
-                        
-                        if (prefer_this_tile) {
-                            movement_priorities.insert(movement_priorities.begin(), {nx, ny}); 
-                        } else {
-                            movement_priorities.push_back({nx, ny}); 
-                        }
-                    }
-                }
-            }
+            Bitboard window = table.board.geo.within_chebyshev(self, 2).minus(self) & open_tiles;
+            window.for_each([&](int tile) {
+                int new_distance = walking_distance(table.board.geo.x_of(tile), table.board.geo.y_of(tile), target_x, target_y);
+                if (new_distance < min_distance) movement_candidates.set(tile);
+            });
         }
         
         
-        if (movement_priorities.empty()) {
-            int dx[] = {1, 1, 0, -1, -1, -1, 0, 1}; 
-            int dy[] = {0, 1, 1, 1, 0, -1, -1, -1};
-            
-            for (int i = 0; i < 8; i++) {
-                int nx = agent.x + dx[i];
-                int ny = agent.y + dy[i];
-                
-                if (nx >= 0 && nx < board_width && ny >= 0 && ny < board_height) {
-                    if (GameMechanics::is_valid_movement_position(nx, ny, board_width, board_height, tile_map, occupied)) {
-                        
-                        if (ny >= 0 && ny < tile_map.size() && nx >= 0 && nx < tile_map[0].size()) {
-                            int tile_type = tile_map[ny][nx];
-                            if (tile_type == 0) { 
-                                movement_priorities.insert(movement_priorities.begin(), {nx, ny});
-                            } else {
-                                movement_priorities.push_back({nx, ny}); 
-                            }
-                        } else {
-                            movement_priorities.push_back({nx, ny});
-                        }
-                    }
-                }
-            }
+        if (!movement_candidates.any()) {
+            movement_candidates = table.board.geo.dilate8(self).minus(self) & open_tiles;
         }
         
         
-        for (const auto& pos : movement_priorities) {
-            int nx = pos.first;
-            int ny = pos.second;
+        movement_candidates.for_each([&](int tile) {
+            int nx = table.board.geo.x_of(tile);
+            int ny = table.board.geo.y_of(tile);
+            int landing = move_landing(pathfinder, agent, nx, ny, occupied);
+            int lx = table.board.geo.x_of(landing);
+            int ly = table.board.geo.y_of(landing);
             
             
             for (const auto& enemy : enemies) {
                 if (!enemy.is_alive()) continue;
                 
-                int distance = abs(nx - enemy.x) + abs(ny - enemy.y);
+                int distance = abs(lx - enemy.x) + abs(ly - enemy.y);
                 
                 if (distance <= data.optimal_range) {
                     int base_damage = data.soaking_power;
@@ -818,10 +428,7 @@ struct SmartGameAI {
                         }
                         
                         if (expected_value > best_compound.expected_value) {
-                            best_compound.action_type = "MOVE_SHOOT";
-                            best_compound.target_x = nx;
-                            best_compound.target_y = ny;
-                            best_compound.target_agent_id = enemy.agent_id;
+                            best_compound.action = PackedAction::move_shoot(nx, ny, enemy.agent_id);
                             best_compound.expected_value = expected_value;
                             best_compound.expected_damage = base_damage;
                             best_compound.tactical_reasoning = "🚀 ADVANCE to (" + to_string(nx) + "," + to_string(ny) + 
@@ -847,7 +454,7 @@ struct SmartGameAI {
                             if (bomb_x < 0 || bomb_x >= board_width || bomb_y < 0 || bomb_y >= board_height) continue;
                             
                             
-                            int throw_distance = abs(nx - bomb_x) + abs(ny - bomb_y);
+                            int throw_distance = abs(lx - bomb_x) + abs(ly - bomb_y);
                             if (throw_distance > THROW_DISTANCE_MAX) continue;
                             
                             
@@ -867,7 +474,7 @@ struct SmartGameAI {
                             if (total_damage > 0) {
                                 
                                 int self_damage = 0;
-                                int agent_splash_distance = abs(bomb_x - nx) + abs(bomb_y - ny);
+                                int agent_splash_distance = abs(bomb_x - lx) + abs(bomb_y - ly);
                                 if (agent_splash_distance <= 1) {
                                     self_damage = 30;
                                     if (agent.wetness > 70) self_damage = 15;
@@ -884,7 +491,7 @@ struct SmartGameAI {
                                     
                                     
                                     int old_distance = abs(agent.x - target_enemy.x) + abs(agent.y - target_enemy.y);
-                                    int new_distance = abs(nx - target_enemy.x) + abs(ny - target_enemy.y);
+                                    int new_distance = abs(lx - target_enemy.x) + abs(ly - target_enemy.y);
                                     if (new_distance < old_distance) {
                                         expected_value += 1500.0;
                                     }
@@ -892,11 +499,7 @@ struct SmartGameAI {
                                     if (self_damage == 0) expected_value += 800.0;
                                     
                                     if (expected_value > best_compound.expected_value) {
-                                        best_compound.action_type = "MOVE_THROW";
-                                        best_compound.target_x = nx;
-                                        best_compound.target_y = ny;
-                                        best_compound.bomb_x = bomb_x;
-                                        best_compound.bomb_y = bomb_y;
+                                        best_compound.action = PackedAction::move_throw(nx, ny, bomb_x, bomb_y);
                                         best_compound.expected_value = expected_value;
                                         best_compound.expected_damage = total_damage;
                                         best_compound.tactical_reasoning = "🚀 ADVANCE to (" + to_string(nx) + "," + to_string(ny) + 
@@ -909,14 +512,14 @@ struct SmartGameAI {
                     }
                 }
             }
-        }
+        });
         
         return best_compound;
     }
     
     TacticalDecision find_best_shooting_target(const AgentState& agent, const vector<AgentState>& enemies) {
         TacticalDecision best_shot;
-        best_shot.action_type = "HUNKER_DOWN";
+        best_shot.action = PackedAction::hunker_down();
         best_shot.expected_value = 0;
         
         if (agent.cooldown > 0 || enemies.empty()) {
@@ -942,14 +545,12 @@ struct SmartGameAI {
             }
             
             
-            int base_damage = data.soaking_power;
-            if (distance > data.optimal_range) {
-                base_damage = base_damage / 2; 
-            }
+            double range_modifier = distance > data.optimal_range ? 0.5 : 1.0;
+            int base_damage = (int)floor(data.soaking_power * range_modifier + 0.5);
             
             
             double cover_multiplier = calculate_cover_protection(agent, enemy);
-            int final_damage = (int)(base_damage * cover_multiplier);
+            int final_damage = (int)floor(data.soaking_power * range_modifier * cover_multiplier + 0.5);
             
             cerr << "    Base damage: " << base_damage << " cover_mult: " << cover_multiplier << " final: " << final_damage << endl;
             
@@ -971,8 +572,7 @@ struct SmartGameAI {
                 cerr << "    Expected value: " << (int)expected_value << endl;
                 
                 if (expected_value > best_shot.expected_value) {
-                    best_shot.action_type = "SHOOT";
-                    best_shot.target_agent_id = enemy.agent_id;
+                    best_shot.action = PackedAction::shoot(enemy.agent_id);
                     best_shot.expected_value = expected_value;
                     best_shot.expected_damage = final_damage;
                     best_shot.tactical_reasoning = "Focus fire on enemy " + to_string(enemy.agent_id) + 
@@ -981,7 +581,7 @@ struct SmartGameAI {
             }
         }
         
-        if (best_shot.action_type == "HUNKER_DOWN") {
+        if (best_shot.action.is(ACTION_HUNKER_DOWN)) {
             best_shot.tactical_reasoning = "No enemies in effective shooting range";
         }
         
@@ -990,46 +590,13 @@ struct SmartGameAI {
     
     
     double calculate_cover_protection(const AgentState& shooter, const AgentState& target) {
-        
-        for (int dx = -1; dx <= 1; dx++) {
-            for (int dy = -1; dy <= 1; dy++) {
-                if (dx == 0 && dy == 0) continue;
-                
-                int cover_x = target.x + dx;
-                int cover_y = target.y + dy;
-                
-                if (cover_x >= 0 && cover_x < board_width && cover_y >= 0 && cover_y < board_height) {
-                    int cover_type = 0; 
-                    if (cover_y < tile_map.size() && cover_x < tile_map[cover_y].size()) {
-                        cover_type = tile_map[cover_y][cover_x];
-                    }
-                    
-                    if (cover_type == 1 || cover_type == 2) { 
-                        
-                        bool blocks_shot = false;
-                        
-                        
-                        if ((cover_x == target.x + 1 && shooter.x < target.x) ||
-                            (cover_x == target.x - 1 && shooter.x > target.x) ||
-                            (cover_y == target.y + 1 && shooter.y < target.y) ||
-                            (cover_y == target.y - 1 && shooter.y > target.y)) {
-                            blocks_shot = true;
-                        }
-                        
-                        if (blocks_shot) {
-                            return (cover_type == 1) ? 0.5 : 0.25; 
-                        }
-                    }
-                }
-            }
-        }
-        return 1.0; 
+        return table.cover.modifier(table.board.geo.index(shooter.x, shooter.y), table.board.geo.index(target.x, target.y));
     }
     
     
     TacticalDecision find_best_bombing_target_with_allies(const AgentState& agent, const vector<AgentState>& enemies, const vector<AgentState>& allies) {
         TacticalDecision best_bomb;
-        best_bomb.action_type = "HUNKER_DOWN";
+        best_bomb.action = PackedAction::hunker_down();
         best_bomb.expected_value = 0;
         
         
@@ -1112,9 +679,7 @@ struct SmartGameAI {
                 cerr << "  🎯 MULTI-TARGET: " << enemies_hit << " enemies hit!" << endl;
             }
             
-            best_bomb.action_type = "THROW";
-            best_bomb.target_x = best_x;
-            best_bomb.target_y = best_y;
+            best_bomb.action = PackedAction::throw_at(best_x, best_y);
             best_bomb.expected_value = expected_value;
             best_bomb.expected_damage = best_damage;
             best_bomb.tactical_reasoning = "Clean bomb hits " + to_string(enemies_hit) + 
@@ -1129,11 +694,6 @@ struct SmartGameAI {
     }
     
     
-    TacticalDecision find_best_bombing_target(const AgentState& agent, const vector<AgentState>& enemies) {
-        vector<AgentState> empty_allies; 
-        return find_best_bombing_target_with_allies(agent, enemies, empty_allies);
-    }
-    
     
     int calculate_total_splash_damage_clean(const vector<AgentState>& enemies, int bomb_x, int bomb_y) {
         int total_damage = 0;
@@ -1166,28 +726,20 @@ struct SmartGameAI {
     }
     
     
-    vector<TacticalDecision> generate_random_moves(const AgentState& agent, const vector<AgentState>& enemies, const vector<AgentState>& allies, int num_simulations) {
+    vector<TacticalDecision> generate_random_moves(const AgentState& agent, const vector<AgentState>& enemies, const vector<AgentState>& allies, int num_simulations, RulesPathfinder& finder) {
         vector<TacticalDecision> moves;
         
         
-        vector<pair<int, int>> occupied;
-        for (const auto& ally : allies) {
-            if (ally.agent_id != agent.agent_id && ally.is_alive()) {
-                occupied.push_back({ally.x, ally.y});
-            }
-        }
-        for (const auto& enemy : enemies) {
-            if (enemy.is_alive()) {
-                occupied.push_back({enemy.x, enemy.y});
-            }
-        }
+        Bitboard self = table.board.geo.bit(agent.x, agent.y);
+        Bitboard occupied = build_occupancy(allies, enemies).all() | self;
+        Bitboard open_tiles = table.board.walkable(occupied.minus(self));
         
         
         const AgentState* priority_target = nullptr;
         int closest_distance = INT_MAX;
         for (const auto& enemy : enemies) {
             if (!enemy.is_alive()) continue;
-            int distance = abs(agent.x - enemy.x) + abs(agent.y - enemy.y);
+            int distance = walking_distance(agent.x, agent.y, enemy.x, enemy.y);
             if (distance < closest_distance) {
                 closest_distance = distance;
                 priority_target = &enemy;
@@ -1195,64 +747,37 @@ struct SmartGameAI {
         }
         
         
-        vector<pair<int, int>> movement_candidates;
-        
-        
         int dx[] = {1, 1, 0, -1, -1, -1, 0, 1};  
         int dy[] = {0, 1, 1, 1, 0, -1, -1, -1};
         
-        for (int i = 0; i < 8; i++) {
-            int nx = agent.x + dx[i];
-            int ny = agent.y + dy[i];
-            
-            if (nx >= 0 && nx < board_width && ny >= 0 && ny < board_height) {
-                movement_candidates.push_back({nx, ny});
-            }
-        }
+        Bitboard movement_candidates = table.board.geo.dilate8(self).minus(self);
         
         
         if (priority_target != nullptr) {
-            for (int step = 1; step <= 2; step++) {
-                for (int i = 0; i < 8; i++) {
-                    int nx = agent.x + dx[i] * step;
-                    int ny = agent.y + dy[i] * step;
-                    
-                    if (nx >= 0 && nx < board_width && ny >= 0 && ny < board_height) {
-                        movement_candidates.push_back({nx, ny});
-                    }
-                }
+            for (int i = 0; i < 8; i++) {
+                movement_candidates |= table.board.geo.bit(agent.x + dx[i] * 2, agent.y + dy[i] * 2);
             }
         }
+        movement_candidates &= open_tiles;
         
         
-        for (const auto& candidate : movement_candidates) {
-            int nx = candidate.first;
-            int ny = candidate.second;
-            
-            
-            bool occupied_by_other = false;
-            for (const auto& pos : occupied) {
-                if (pos.first == nx && pos.second == ny) {
-                    occupied_by_other = true;
-                    break;
-                }
-            }
-            
-            if (occupied_by_other) {
-                continue; 
-            }
+        movement_candidates.for_each([&](int tile) {
+            int nx = table.board.geo.x_of(tile);
+            int ny = table.board.geo.y_of(tile);
             
             TacticalDecision move_decision;
-            move_decision.action_type = "MOVE";
-            move_decision.target_x = nx;
-            move_decision.target_y = ny;
+            move_decision.action = PackedAction::move(nx, ny);
             
             double expected_value = 300.0; 
             
             
             if (priority_target != nullptr) {
-                int old_distance = abs(agent.x - priority_target->x) + abs(agent.y - priority_target->y);
-                int new_distance = abs(nx - priority_target->x) + abs(ny - priority_target->y);
+                int landing = move_landing(finder, agent, nx, ny, occupied);
+                int lx = table.board.geo.x_of(landing);
+                int ly = table.board.geo.y_of(landing);
+                int old_distance = walking_distance(agent.x, agent.y, priority_target->x, priority_target->y);
+                int new_distance = walking_distance(lx, ly, priority_target->x, priority_target->y);
+                int new_range = abs(lx - priority_target->x) + abs(ly - priority_target->y);
                 
                 
                 if (new_distance < old_distance) {
@@ -1266,10 +791,10 @@ struct SmartGameAI {
                 
                 
                 const AgentData& data = all_agents_data.at(agent.agent_id);
-                if (new_distance <= data.optimal_range) {
+                if (new_range <= data.optimal_range) {
                     expected_value += 3000.0; 
                 }
-                if (new_distance <= data.optimal_range + 2) {
+                if (new_range <= data.optimal_range + 2) {
                     expected_value += 1000.0; 
                 }
                 
@@ -1289,12 +814,12 @@ struct SmartGameAI {
                 ") value=" + to_string((int)expected_value);
             
             moves.push_back(move_decision);
-        }
+        });
         
         
         if (moves.empty()) {
             TacticalDecision hunker;
-            hunker.action_type = "HUNKER_DOWN";
+            hunker.action = PackedAction::hunker_down();
             hunker.expected_value = 200.0; 
             hunker.tactical_reasoning = "No valid moves - hunker down";
             moves.push_back(hunker);
@@ -1319,8 +844,8 @@ struct SmartGameAI {
                 for (const auto& enemy : enemies) {
                     if (!enemy.is_alive()) continue;
                     
-                    int future_x = (option.action_type == "MOVE") ? option.target_x : agent.x;
-                    int future_y = (option.action_type == "MOVE") ? option.target_y : agent.y;
+                    int future_x = option.action.is(ACTION_MOVE) ? option.action.target_x() : agent.x;
+                    int future_y = option.action.is(ACTION_MOVE) ? option.action.target_y() : agent.y;
                     
                     int distance_to_me = abs(future_x - enemy.x) + abs(future_y - enemy.y);
                     
@@ -1344,7 +869,7 @@ struct SmartGameAI {
         
         
         if (best_option.expected_value < 0) {
-            best_option.action_type = "HUNKER_DOWN";
+            best_option.action = PackedAction::hunker_down();
             best_option.expected_value = 50.0;
             best_option.tactical_reasoning = "Expectimax fallback - hunker down";
         }
@@ -1358,12 +883,13 @@ struct SmartGameAI {
     
     struct SmitsimaxNode {
         
-        vector<AgentState> my_agents;
-        vector<AgentState> enemy_agents;
+        // Slots [0, my_count) are my agents in turn-input order, then enemies
+        RulesState state;
         
         
-        vector<shared_ptr<SmitsimaxNode>> children;
-        SmitsimaxNode* parent;
+        int parent;
+        int first_child;
+        int child_count;
         
         
         vector<TacticalDecision> joint_action; 
@@ -1373,39 +899,50 @@ struct SmartGameAI {
         double total_reward;
         double ucb_value;
         
+        // A transposition's mean and its capped virtual visits, kept apart
+        // from visits so UCB's counts and the root merge see only this
+        // tree's own playouts
+        double prior_value;
+        int prior_visits;
+        
         
         double game_value;
         bool is_terminal;
         int depth;
         
-        SmitsimaxNode(const vector<AgentState>& my_agents, const vector<AgentState>& enemy_agents, 
-                     SmitsimaxNode* parent = nullptr, int depth = 0) 
-            : my_agents(my_agents), enemy_agents(enemy_agents), parent(parent), 
-              visits(0), total_reward(0.0), ucb_value(0.0), game_value(0.0), 
-              is_terminal(false), depth(depth) {}
-        
-        
-        double calculate_ucb(double exploration_constant = 1.414) const {
+        // Arena slots are reused across turns, so every field is reset here;
+        // clear() keeps joint_action's capacity from the previous search
+        void init(const RulesState& node_state, int parent_index = -1, int node_depth = 0) {
+            state = node_state;
+            parent = parent_index;
+            first_child = -1;
+            child_count = 0;
+            joint_action.clear();
+            visits = 0;
+            total_reward = 0.0;
+            ucb_value = 0.0;
+            prior_value = 0.0;
+            prior_visits = 0;
+            game_value = 0.0;
+            is_terminal = false;
+            depth = node_depth;
+        }
+        
+        
+        double calculate_ucb(int parent_visits, double exploration_constant = 1.414) const {
             if (visits == 0) return std::numeric_limits<double>::infinity();
-            if (parent == nullptr || parent->visits == 0) return total_reward / visits;
+            double exploitation = (total_reward + prior_value * prior_visits) / (visits + prior_visits);
+            if (parent_visits == 0) return exploitation;
             
-            double exploitation = total_reward / visits;
-            double exploration = exploration_constant * sqrt(log(parent->visits) / visits);
+            double exploration = exploration_constant * sqrt(log(parent_visits) / visits);
             return exploitation + exploration;
         }
         
         
         bool check_terminal() {
             
-            bool my_agents_alive = false;
-            bool enemy_agents_alive = false;
-            
-            for (const auto& agent : my_agents) {
-                if (agent.is_alive()) my_agents_alive = true;
-            }
-            for (const auto& agent : enemy_agents) {
-                if (agent.is_alive()) enemy_agents_alive = true;
-            }
+            bool my_agents_alive = state.live_count(0) > 0;
+            bool enemy_agents_alive = state.live_count(1) > 0;
             
             is_terminal = !my_agents_alive || !enemy_agents_alive || depth >= 2; 
             return is_terminal;
@@ -1418,16 +955,14 @@ struct SmartGameAI {
                 int my_alive = 0, enemy_alive = 0;
                 int my_health = 0, enemy_health = 0;
                 
-                for (const auto& agent : my_agents) {
-                    if (agent.is_alive()) {
+                for (int s = 0; s < state.count; s++) {
+                    if (!state.is_alive(s)) continue;
+                    if (state.is_mine(s)) {
                         my_alive++;
-                        my_health += agent.get_health();
-                    }
-                }
-                for (const auto& agent : enemy_agents) {
-                    if (agent.is_alive()) {
+                        my_health += 100 - state.wetness[s];
+                    } else {
                         enemy_alive++;
-                        enemy_health += agent.get_health();
+                        enemy_health += 100 - state.wetness[s];
                     }
                 }
                 
@@ -1450,31 +985,29 @@ struct SmartGameAI {
             int my_health = 0, enemy_health = 0;
             int my_bombs = 0, enemy_bombs = 0;
             
-            for (const auto& agent : my_agents) {
-                if (agent.is_alive()) {
+            for (int s = 0; s < state.count; s++) {
+                if (!state.is_alive(s)) continue;
+                if (state.is_mine(s)) {
                     my_alive++;
-                    my_health += agent.get_health();
-                    my_bombs += agent.splash_bombs;
-                }
-            }
-            for (const auto& agent : enemy_agents) {
-                if (agent.is_alive()) {
+                    my_health += 100 - state.wetness[s];
+                    my_bombs += state.splash_bombs[s];
+                } else {
                     enemy_alive++;
-                    enemy_health += agent.get_health();
-                    enemy_bombs += agent.splash_bombs;
+                    enemy_health += 100 - state.wetness[s];
+                    enemy_bombs += state.splash_bombs[s];
                 }
             }
             
             
             double positional_value = 0.0;
-            for (const auto& my_agent : my_agents) {
-                if (!my_agent.is_alive()) continue;
+            for (int s = 0; s < state.my_count; s++) {
+                if (!state.is_alive(s)) continue;
                 
                 
                 int min_distance = INT_MAX;
-                for (const auto& enemy : enemy_agents) {
-                    if (!enemy.is_alive()) continue;
-                    int distance = abs(my_agent.x - enemy.x) + abs(my_agent.y - enemy.y);
+                for (int e = state.my_count; e < state.count; e++) {
+                    if (!state.is_alive(e)) continue;
+                    int distance = abs(state.x[s] - state.x[e]) + abs(state.y[s] - state.y[e]);
                     min_distance = min(min_distance, distance);
                 }
                 
@@ -1495,58 +1028,136 @@ struct SmartGameAI {
     
     class SmitsimaxSearch {
     private:
+        // One root-parallel worker: its own tree, rules engine scratch and RNG.
+        // Worker 0 keeps the deterministic first-best choice among tied
+        // children; the others break ties at random so their trees differ.
+        struct SearchTree {
+            NodeArena<SmitsimaxNode> arena;
+            RulesEngine engine;
+            RulesPathfinder pathfinder;  // Move landings for this worker's heuristics
+            mt19937 rng;
+            bool shuffle_ties;
+            int root = -1;
+            
+            SearchTree(unsigned seed, bool shuffle) : arena(SMITSIMAX_ARENA_CAPACITY), rng(seed), shuffle_ties(shuffle) {}
+        };
+        
         SmartGameAI* ai_instance;
         random_device rd;
-        mt19937 rng;
+        vector<unique_ptr<SearchTree>> trees;
+        RulesTable& table; // SmartGameAI's
+        int thread_count = 1;
+        RootMergePolicy merge_policy = ROOT_MERGE_SUM;
+        // Node statistics and leaf evaluations by Zobrist key, shared by the
+        // workers and kept across turns
+        TranspositionTable transpositions;
         
     public:
-        SmitsimaxSearch(SmartGameAI* ai) : ai_instance(ai), rng(rd()) {}
-        
-        
-        vector<AgentState> simulate_enemy_response_enhanced(const vector<AgentState>& enemies, 
-                                                           const vector<AgentState>& my_agents,
-                                                           bool use_game_folder = false) {
-            if (use_game_folder) {
-                
-                cerr << "🎮 Game folder simulation not fully implemented - using internal simulation" << endl;
-            }
-            
-            
-            vector<AgentState> new_enemies = enemies;
-            
-            
-            for (auto& enemy : new_enemies) {
-                if (!enemy.is_alive()) continue;
-                
-                
-                const AgentState* closest_target = nullptr;
-                int min_distance = INT_MAX;
-                
-                for (const auto& my_agent : my_agents) {
-                    if (!my_agent.is_alive()) continue;
-                    int distance = abs(enemy.x - my_agent.x) + abs(enemy.y - my_agent.y);
+        SmitsimaxSearch(SmartGameAI* ai) : ai_instance(ai), table(ai->table), transpositions(SMITSIMAX_TT_LOG2_BUCKETS) {
+            trees.emplace_back(new SearchTree(rd(), false));
+        }
+        
+        void set_parallelism(int threads, RootMergePolicy policy) {
+            thread_count = max(1, threads);
+            merge_policy = policy;
+        }
+        
+        
+        // Slot tables for this turn: my agents first, then enemies, as the
+        // rules engine expects
+        RulesState load_rules_state(const vector<AgentState>& my_agents, const vector<AgentState>& enemies) {
+            RulesState state;
+            state.count = 0;
+            state.points[0] = state.points[1] = 0;
+            for (int side = 0; side < 2; side++) {
+                for (const auto& agent : side == 0 ? my_agents : enemies) {
+                    if (state.count >= RULES_MAX_AGENTS) break;
+                    int slot = state.count++;
+                    const AgentData& data = ai_instance->all_agents_data.at(agent.agent_id);
+                    table.agent_id[slot] = agent.agent_id;
+                    table.shoot_cooldown[slot] = data.shoot_cooldown;
+                    table.optimal_range[slot] = data.optimal_range;
+                    table.soaking_power[slot] = data.soaking_power;
+                    state.x[slot] = (int8_t)agent.x;
+                    state.y[slot] = (int8_t)agent.y;
+                    state.cooldown[slot] = (uint8_t)agent.cooldown;
+                    state.splash_bombs[slot] = (uint8_t)agent.splash_bombs;
+                    state.wetness[slot] = (int16_t)agent.wetness;
+                }
+                if (side == 0) state.my_count = state.count;
+            }
+            state.rehash();
+            return state;
+        }
+        
+        
+        // My orders as the referee will resolve them, enemies standing still:
+        // while some step would be cancelled, the latest such agent stays put
+        // and keeps only its combat action
+        void settle_moves(const vector<AgentState>& my_agents, const vector<AgentState>& enemies, vector<PackedAction>& orders) {
+            RulesState state = load_rules_state(my_agents, enemies);
+            RulesEngine& engine = trees[0]->engine;
+            PackedAction slot_orders[RULES_MAX_AGENTS];
+            bool present[RULES_MAX_AGENTS];
+            for (int s = 0; s < state.count; s++) {
+                slot_orders[s] = s < (int)orders.size() ? orders[s] : PackedAction::hunker_down();
+                present[s] = state.is_alive(s);
+            }
+            const BoardGeometry& geo = table.board.geo;
+            for (int dropped = 0; dropped < state.my_count; dropped++) {
+                int to[RULES_MAX_AGENTS];
+                engine.resolve_moves(table, state, slot_orders, present, to);
+                int stuck = -1;
+                for (int s = 0; s < state.my_count; s++) {
+                    if (present[s] && slot_orders[s].has_move() && to[s] == geo.index(state.x[s], state.y[s])) stuck = s;
+                }
+                if (stuck < 0) break;
+                cerr << "🚫 Agent " << table.agent_id[stuck] << " move to (" << slot_orders[stuck].target_x() << ","
+                     << slot_orders[stuck].target_y() << ") would be cancelled - staying put" << endl;
+                slot_orders[stuck] = PackedAction::combine(PackedAction::hunker_down(), slot_orders[stuck].combat());
+            }
+            for (int s = 0; s < state.my_count && s < (int)orders.size(); s++) orders[s] = slot_orders[s];
+        }
+        
+        
+        vector<AgentState> unpack_agents(const RulesState& state, bool mine) const {
+            vector<AgentState> agents;
+            for (int s = mine ? 0 : state.my_count; s < (mine ? state.my_count : state.count); s++) {
+                AgentState agent;
+                agent.agent_id = table.agent_id[s];
+                agent.x = state.x[s];
+                agent.y = state.y[s];
+                agent.cooldown = state.cooldown[s];
+                agent.splash_bombs = state.splash_bombs[s];
+                agent.wetness = state.wetness[s];
+                agents.push_back(agent);
+            }
+            return agents;
+        }
+        
+        
+        // Predicted enemy reply: every live enemy heads for my closest agent
+        void enemy_response_orders(const RulesState& state, PackedAction* orders) const {
+            for (int e = state.my_count; e < state.count; e++) {
+                if (!state.is_alive(e)) continue;
+                int closest = -1, min_distance = INT_MAX;
+                for (int s = 0; s < state.my_count; s++) {
+                    if (!state.is_alive(s)) continue;
+                    int distance = abs(state.x[e] - state.x[s]) + abs(state.y[e] - state.y[s]);
                     if (distance < min_distance) {
                         min_distance = distance;
-                        closest_target = &my_agent;
+                        closest = s;
                     }
                 }
-                
-                if (closest_target != nullptr) {
-                    
-                    if (enemy.x < closest_target->x) enemy.x++;
-                    else if (enemy.x > closest_target->x) enemy.x--;
-                    else if (enemy.y < closest_target->y) enemy.y++;
-                    else if (enemy.y > closest_target->y) enemy.y--;
-                }
+                if (closest >= 0) orders[e] = PackedAction::move(state.x[closest], state.y[closest]);
             }
-            
-            return new_enemies;
         }
         
         
         vector<vector<TacticalDecision>> generate_joint_actions(const vector<AgentState>& my_agents, 
                                                                const vector<AgentState>& enemies,
-                                                               const vector<AgentState>& all_allies) {
+                                                               const vector<AgentState>& all_allies,
+                                                               RulesPathfinder& finder) {
             vector<vector<TacticalDecision>> joint_actions;
             
             
@@ -1557,7 +1168,7 @@ struct SmartGameAI {
                 if (!agent.is_alive()) {
                     
                     TacticalDecision dead_action;
-                    dead_action.action_type = "HUNKER_DOWN";
+                    dead_action.action = PackedAction::hunker_down();
                     dead_action.expected_value = 0;
                     agent_actions[i].push_back(dead_action);
                     continue;
@@ -1568,25 +1179,25 @@ struct SmartGameAI {
                 
                 
                 TacticalDecision shoot = ai_instance->find_best_shooting_target(agent, enemies);
-                if (shoot.action_type == "SHOOT") {
+                if (shoot.action.is(ACTION_SHOOT)) {
                     actions.push_back(shoot);
                 }
                 
                 
                 TacticalDecision bomb = ai_instance->find_best_bombing_target_with_allies(agent, enemies, all_allies);
-                if (bomb.action_type == "THROW") {
+                if (bomb.action.is(ACTION_THROW)) {
                     actions.push_back(bomb);
                 }
                 
                 
-                vector<TacticalDecision> moves = ai_instance->generate_random_moves(agent, enemies, all_allies, 2);
+                vector<TacticalDecision> moves = ai_instance->generate_random_moves(agent, enemies, all_allies, 2, finder);
                 for (size_t j = 0; j < min(size_t(2), moves.size()); j++) { 
                     actions.push_back(moves[j]);
                 }
                 
                 
                 TacticalDecision hunker;
-                hunker.action_type = "HUNKER_DOWN";
+                hunker.action = PackedAction::hunker_down();
                 hunker.expected_value = 50.0;
                 actions.push_back(hunker);
                 
@@ -1624,179 +1235,190 @@ struct SmartGameAI {
         }
         
         
-        vector<AgentState> simulate_enemy_response(const vector<AgentState>& enemies, 
-                                                  const vector<AgentState>& my_agents) {
-            vector<AgentState> new_enemies = enemies;
-            
-            
-            for (auto& enemy : new_enemies) {
-                if (!enemy.is_alive()) continue;
-                
-                
-                const AgentState* closest_target = nullptr;
-                int min_distance = INT_MAX;
-                
-                for (const auto& my_agent : my_agents) {
-                    if (!my_agent.is_alive()) continue;
-                    int distance = abs(enemy.x - my_agent.x) + abs(enemy.y - my_agent.y);
-                    if (distance < min_distance) {
-                        min_distance = distance;
-                        closest_target = &my_agent;
-                    }
-                }
-                
-                if (closest_target != nullptr) {
-                    
-                    if (enemy.x < closest_target->x && enemy.x < ai_instance->board_width - 1) enemy.x++;
-                    else if (enemy.x > closest_target->x && enemy.x > 0) enemy.x--;
-                    else if (enemy.y < closest_target->y && enemy.y < ai_instance->board_height - 1) enemy.y++;
-                    else if (enemy.y > closest_target->y && enemy.y > 0) enemy.y--;
-                }
-            }
-            
-            return new_enemies;
+        // Table keys: the state's hash, salted with which agents the slots
+        // hold and with the node's depth (a node at the depth limit is scored
+        // as terminal); evaluations are keyed apart from node statistics
+        uint64_t node_key(const SmitsimaxNode& node, uint64_t salt) const {
+            return node.state.hash ^ salt ^ zobrist_keys().side[min(node.depth, ZOBRIST_MAX_SLOTS - 1)];
         }
-        
-        
-        vector<AgentState> apply_joint_action(const vector<AgentState>& agents, 
-                                            const vector<TacticalDecision>& actions,
-                                            const vector<AgentState>& enemies) {
-            vector<AgentState> new_agents = agents;
-            
-            for (size_t i = 0; i < new_agents.size() && i < actions.size(); i++) {
-                auto& agent = new_agents[i];
-                const auto& action = actions[i];
-                
-                if (!agent.is_alive()) continue;
-                
-                
-                if (action.action_type == "MOVE") {
-                    agent.x = action.target_x;
-                    agent.y = action.target_y;
-                } else if (action.action_type == "SHOOT" && agent.cooldown == 0) {
-                    agent.cooldown = 1; 
-                } else if (action.action_type == "THROW" && agent.splash_bombs > 0) {
-                    agent.splash_bombs--; 
-                    agent.cooldown = 2; 
-                }
-                
-                
-                if (agent.cooldown > 0) agent.cooldown--;
-            }
-            
-            return new_agents;
+        uint64_t evaluation_key(const SmitsimaxNode& node, uint64_t salt) const {
+            return ~(node.state.hash ^ salt) ^ (node.is_terminal ? zobrist_keys().side[0] : 0);
         }
         
-        
-        vector<TacticalDecision> smitsimax_search(const vector<AgentState>& my_agents,
-                                                 const vector<AgentState>& enemies, 
-                                                 int max_iterations = 30,
-                                                 double time_limit_ms = 40.0) {
-            
-            auto start_time = chrono::high_resolution_clock::now();
-            
-            
-            auto root = make_shared<SmitsimaxNode>(my_agents, enemies);
-            
-            cerr << "🔍 SMITSIMAX FAST: Starting search with " << my_agents.size() << " agents, " 
-                 << max_iterations << " iterations, " << time_limit_ms << "ms limit" << endl;
+        void grow_tree(SearchTree& tree, const RulesState& root_state, uint64_t salt, int max_iterations, SearchClock clock) {
+            NodeArena<SmitsimaxNode>& arena = tree.arena;
+            arena.reset();
+            tree.root = arena.allocate();
+            arena[tree.root].init(root_state);
             
             for (int iteration = 0; iteration < max_iterations; iteration++) {
                 
-                if (iteration % 5 == 0) {
-                    auto current_time = chrono::high_resolution_clock::now();
-                    auto elapsed = chrono::duration_cast<chrono::milliseconds>(current_time - start_time);
-                    if (elapsed.count() > time_limit_ms) {
-                        cerr << "🕐 SMITSIMAX: Time limit reached at iteration " << iteration << endl;
-                        break;
-                    }
+                if (clock.expired()) {
+                    cerr << "🕐 SMITSIMAX: Time limit reached at iteration " << iteration << endl;
+                    break;
                 }
                 
                 
-                shared_ptr<SmitsimaxNode> current = root;
-                while (!current->children.empty() && !current->check_terminal()) {
+                int current = tree.root;
+                while (arena[current].child_count > 0 && !arena[current].check_terminal()) {
                     
-                    auto best_child = max_element(current->children.begin(), current->children.end(),
-                        [](const shared_ptr<SmitsimaxNode>& a, const shared_ptr<SmitsimaxNode>& b) {
-                            return a->calculate_ucb() < b->calculate_ucb();
-                        });
-                    current = *best_child;
+                    const SmitsimaxNode& node = arena[current];
+                    int best_child = node.first_child, ties = 1;
+                    double best_ucb = arena[best_child].calculate_ucb(node.visits);
+                    for (int c = node.first_child + 1; c < node.first_child + node.child_count; c++) {
+                        double ucb = arena[c].calculate_ucb(node.visits);
+                        if (ucb > best_ucb) {
+                            best_ucb = ucb;
+                            best_child = c;
+                            ties = 1;
+                        } else if (ucb == best_ucb && tree.shuffle_ties && tree.rng() % ++ties == 0) {
+                            best_child = c;
+                        }
+                    }
+                    current = best_child;
                 }
                 
                 
-                if (!current->check_terminal() && current->visits > 0) {
-                    auto joint_actions = generate_joint_actions(current->my_agents, current->enemy_agents, current->my_agents);
+                SmitsimaxNode& leaf = arena[current];
+                if (!leaf.check_terminal() && leaf.visits > 0) {
+                    vector<AgentState> leaf_my_agents = unpack_agents(leaf.state, true);
+                    vector<AgentState> leaf_enemies = unpack_agents(leaf.state, false);
+                    auto joint_actions = generate_joint_actions(leaf_my_agents, leaf_enemies, leaf_my_agents, tree.pathfinder);
                     
                     for (const auto& joint_action : joint_actions) {
                         
-                        auto new_my_agents = apply_joint_action(current->my_agents, joint_action, current->enemy_agents);
-                        auto new_enemies = this->simulate_enemy_response_enhanced(current->enemy_agents, new_my_agents, false);
+                        // Play the whole turn, my joint action against the predicted reply
+                        PackedAction orders[RULES_MAX_AGENTS];
+                        for (size_t i = 0; i < joint_action.size() && (int)i < leaf.state.my_count; i++) {
+                            orders[i] = joint_action[i].action;
+                        }
+                        enemy_response_orders(leaf.state, orders);
+                        RulesState next = leaf.state;
+                        tree.engine.step(table, next, orders);
+                        
+                        int child = arena.allocate();
+                        if (child == NodeArena<SmitsimaxNode>::NONE) break;
+                        arena[child].init(next, current, leaf.depth + 1);
+                        arena[child].joint_action = joint_action;
                         
-                        auto child = make_shared<SmitsimaxNode>(new_my_agents, new_enemies, current.get(), current->depth + 1);
-                        child->joint_action = joint_action;
-                        current->children.push_back(child);
+                        // A transposition this search has already scored starts
+                        // from that mean as a prior; its visits stay at 0
+                        TranspositionData seen;
+                        if (transpositions.probe(node_key(arena[child], salt), seen, true)) {
+                            arena[child].prior_value = seen.value;
+                            arena[child].prior_visits = min((int)seen.visits, SMITSIMAX_TT_PRIOR_VISITS);
+                        }
+                        if (leaf.child_count == 0) leaf.first_child = child;
+                        leaf.child_count++;
                         
                         
-                        if (current->children.size() >= 8) break; 
+                        if (leaf.child_count >= 8) break; 
                     }
                     
-                    if (!current->children.empty()) {
-                        current = current->children[0]; 
+                    if (leaf.child_count > 0) {
+                        current = leaf.first_child; 
                     }
                 }
                 
                 
-                double value = current->evaluate_state();
+                SmitsimaxNode& scored = arena[current];
+                scored.check_terminal();
+                TranspositionData cached;
+                double value;
+                if (transpositions.probe(evaluation_key(scored, salt), cached)) {
+                    value = cached.value;
+                } else {
+                    value = scored.evaluate_state();
+                    transpositions.store(evaluation_key(scored, salt), {(float)value, 1});
+                }
                 
                 
-                shared_ptr<SmitsimaxNode> backprop = current;
-                while (backprop != nullptr) {
-                    backprop->visits++;
-                    backprop->total_reward += value;
-                    
-                    
-                    if (backprop->parent == nullptr) break;
-                    
-                    
-                    shared_ptr<SmitsimaxNode> parent_shared = nullptr;
-                    if (backprop->parent == root.get()) {
-                        parent_shared = root;
-                    } else {
-                        
-                        break; 
-                    }
-                    backprop = parent_shared;
+                for (int node = current; node != -1; node = arena[node].parent) {
+                    arena[node].visits++;
+                    arena[node].total_reward += value;
+                    transpositions.store(node_key(arena[node], salt),
+                                         {(float)(arena[node].total_reward / arena[node].visits), (uint32_t)arena[node].visits});
+                }
+            }
+        }
+        
+        
+        // Every tree expands the root from the same state in the same order,
+        // so root children line up by index
+        void merge_root_children() {
+            NodeArena<SmitsimaxNode>& arena = trees[0]->arena;
+            SmitsimaxNode& root = arena[trees[0]->root];
+            for (int c = 0; c < root.child_count; c++) {
+                SmitsimaxNode& child = arena[root.first_child + c];
+                RootChildMerge merged(merge_policy);
+                merged.add(child.visits, child.total_reward);
+                for (int t = 1; t < thread_count; t++) {
+                    const SmitsimaxNode& other_root = trees[t]->arena[trees[t]->root];
+                    if (other_root.child_count != root.child_count) continue;
+                    const SmitsimaxNode& other = trees[t]->arena[other_root.first_child + c];
+                    merged.add(other.visits, other.total_reward);
                 }
+                child.visits = merged.merged_visits();
+                child.total_reward = merged.merged_score_sum();
             }
+        }
+        
+        
+        // Anytime search: runs until the timer's deadline for this turn, or
+        // max_iterations
+        vector<TacticalDecision> smitsimax_search(const vector<AgentState>& my_agents,
+                                                 const vector<AgentState>& enemies, 
+                                                 const TimeManager& timer,
+                                                 int max_iterations = SMITSIMAX_ARENA_CAPACITY) {
+            
+            double complexity = (double)(my_agents.size() + enemies.size()) / RULES_MAX_AGENTS;
+            auto deadline = timer.search_deadline(complexity);
             
+            RulesState root_state = load_rules_state(my_agents, enemies);
             
-            if (root->children.empty()) {
+            cerr << "🔍 SMITSIMAX FAST: Starting search with " << my_agents.size() << " agents, " 
+                 << max_iterations << " iterations, "
+                 << (int)chrono::duration<double, milli>(deadline - TimeManager::Clock::now()).count() << "ms left, "
+                 << thread_count << " thread(s)" << endl;
+            
+            while ((int)trees.size() < thread_count) trees.emplace_back(new SearchTree(rd(), true));
+            transpositions.new_generation();
+            uint64_t salt = table.line_up_salt(root_state.count);
+            run_root_workers(thread_count, [&](int t) {
+                grow_tree(*trees[t], root_state, salt, max_iterations, SearchClock(deadline, timer.check_interval()));
+            });
+            if (thread_count > 1) merge_root_children();
+            
+            
+            NodeArena<SmitsimaxNode>& arena = trees[0]->arena;
+            const SmitsimaxNode& root_node = arena[trees[0]->root];
+            if (root_node.child_count == 0) {
                 
                 vector<TacticalDecision> fallback(my_agents.size());
                 for (size_t i = 0; i < my_agents.size(); i++) {
-                    fallback[i].action_type = "HUNKER_DOWN";
+                    fallback[i].action = PackedAction::hunker_down();
                     fallback[i].expected_value = 50.0;
                 }
                 cerr << "🚨 SMITSIMAX: No children generated - using fallback" << endl;
                 return fallback;
             }
             
-            auto best_child = max_element(root->children.begin(), root->children.end(),
-                [](const shared_ptr<SmitsimaxNode>& a, const shared_ptr<SmitsimaxNode>& b) {
-                    return a->visits < b->visits;
-                });
+            int best_child = root_node.first_child;
+            for (int c = root_node.first_child + 1; c < root_node.first_child + root_node.child_count; c++) {
+                if (arena[c].visits > arena[best_child].visits) best_child = c;
+            }
             
-            cerr << "✅ SMITSIMAX: Selected action with " << (*best_child)->visits 
-                 << " visits, value " << (int)((*best_child)->total_reward / std::max(1, (*best_child)->visits)) << endl;
+            cerr << "✅ SMITSIMAX: Selected action with " << arena[best_child].visits 
+                 << " visits, value " << (int)(arena[best_child].total_reward / std::max(1, arena[best_child].visits)) << endl;
             
-            return (*best_child)->joint_action;
+            return arena[best_child].joint_action;
         }
     };
     
     
     TacticalDecision evaluate_focus_fire(const AgentState& agent, const AgentState& priority_target) {
         TacticalDecision focus_decision;
-        focus_decision.action_type = "HUNKER_DOWN";
+        focus_decision.action = PackedAction::hunker_down();
         focus_decision.expected_value = 0;
         
         const AgentData& data = all_agents_data.at(agent.agent_id);
@@ -1818,8 +1440,7 @@ struct SmartGameAI {
                     expected_value += (priority_target.wetness + base_damage) * 100.0;
                 }
                 
-                focus_decision.action_type = "SHOOT";
-                focus_decision.target_agent_id = priority_target.agent_id;
+                focus_decision.action = PackedAction::shoot(priority_target.agent_id);
                 focus_decision.expected_value = expected_value;
                 focus_decision.expected_damage = base_damage;
                 focus_decision.tactical_reasoning = "🔥 FOCUS FIRE on priority target " + 
@@ -1842,9 +1463,7 @@ struct SmartGameAI {
                 cerr << "Focus bomb evaluation: Agent " << agent.agent_id << " vs target at (" << priority_target.x << "," << priority_target.y << ") distance=" << bomb_throw_distance << " max=" << THROW_DISTANCE_MAX << endl;
                 
                 if (expected_value > focus_decision.expected_value) {
-                    focus_decision.action_type = "THROW";
-                    focus_decision.target_x = priority_target.x;
-                    focus_decision.target_y = priority_target.y;
+                    focus_decision.action = PackedAction::throw_at(priority_target.x, priority_target.y);
                     focus_decision.expected_value = expected_value;
                     focus_decision.expected_damage = bomb_damage;
                     focus_decision.tactical_reasoning = "🔥 FOCUS BOMB on priority target at (" + 
@@ -1859,21 +1478,9 @@ struct SmartGameAI {
     }
 
     string format_compound_action(int agent_id, const TacticalDecision& decision) {
-        if (decision.action_type == "SHOOT") {
-            return to_string(agent_id) + ";SHOOT " + to_string(decision.target_agent_id) + "; HUNKER_DOWN";
-        } else if (decision.action_type == "MOVE") {
-            return to_string(agent_id) + ";MOVE " + to_string(decision.target_x) + " " + to_string(decision.target_y) + "; HUNKER_DOWN";
-        } else if (decision.action_type == "THROW") {
-            return to_string(agent_id) + ";THROW " + to_string(decision.target_x) + " " + to_string(decision.target_y) + "; HUNKER_DOWN";
-        } else if (decision.action_type == "MOVE_SHOOT") {
-            return to_string(agent_id) + ";MOVE " + to_string(decision.target_x) + " " + to_string(decision.target_y) + 
-                   "; SHOOT " + to_string(decision.target_agent_id);
-        } else if (decision.action_type == "MOVE_THROW") {
-            return to_string(agent_id) + ";MOVE " + to_string(decision.target_x) + " " + to_string(decision.target_y) + 
-                   "; THROW " + to_string(decision.bomb_x) + " " + to_string(decision.bomb_y);
-        } else {
-            return to_string(agent_id) + ";HUNKER_DOWN";
-        }
+        PackedAction a = decision.action;
+        if (a.is(ACTION_MOVE)) a = PackedAction::combine(a, PackedAction::hunker_down());
+        return command_line(agent_id, a);
     }
 };
 
@@ -1886,8 +1493,11 @@ int main() {
     cerr << "Knows exact damage, collision, and tactical calculations" << endl;
     
     
+    // The first turn's clock starts with the first input
+    TimeManager timer;
     int my_id;
     cin >> my_id;
+    timer.begin_game();
     cin.ignore();
     
     int agent_data_count;
@@ -1916,7 +1526,7 @@ int main() {
     cin.ignore();
     
     
-    vector<vector<int>> tile_map(ai.board_height, vector<int>(ai.board_width, 0));
+    ai.table.init_map(ai.board_width, ai.board_height);
     for (int i = 0; i < ai.board_height; i++) {
         for (int j = 0; j < ai.board_width; j++) {
             int x, y, tile_type;
@@ -1924,13 +1534,12 @@ int main() {
             cin.ignore();
             
             if (x >= 0 && x < ai.board_width && y >= 0 && y < ai.board_height) {
-                tile_map[y][x] = tile_type;
+                ai.table.board.set_tile(x, y, tile_type);
             }
         }
     }
     
-    
-    ai.tile_map = tile_map;
+    ai.table.build_map_tables();
     
     cerr << "=== INITIALIZATION COMPLETE ===" << endl;
     cerr << "My ID: " << my_id << endl;
@@ -1942,10 +1551,14 @@ int main() {
     cerr << endl;
     
     
+    SmartGameAI::SmitsimaxSearch search(&ai);
+    // Offline analysis runs can give the search more cores
+    if (const char* threads = getenv("SMITSIMAX_THREADS")) {
+        search.set_parallelism(atoi(threads), ROOT_MERGE_SUM);
+    }
     int turn_number = 0;
     while (true) {
         turn_number++;
-        auto turn_start = chrono::high_resolution_clock::now();
         
         cerr << "=== TURN " << turn_number << " START ===" << endl;
         
@@ -1954,6 +1567,7 @@ int main() {
             int agent_count;
             cin >> agent_count;
             if (cin.fail() || cin.eof()) break;
+            timer.start_turn();
             cin.ignore();
             
             vector<SmartGameAI::AgentState> current_my_agents;
@@ -1978,6 +1592,8 @@ int main() {
             
             cerr << "Total enemies found: " << current_enemy_agents.size() << endl;
             
+            ai.update_threats(current_my_agents, current_enemy_agents);
+            
             int my_agent_count;
             cin >> my_agent_count;
             cin.ignore();
@@ -1998,9 +1614,6 @@ int main() {
             map<int, SmartGameAI::TacticalDecision> agent_decisions;
             
             
-            set<pair<int, int>> movement_blacklist;
-            
-            
             const SmartGameAI::AgentState* priority_target = nullptr;
             double best_target_score = -1000.0;
             
@@ -2062,24 +1675,15 @@ int main() {
             
             if (use_smitsimax) {
                 cerr << "🔍 USING SMITSIMAX: Multi-agent coordination for " << current_my_agents.size() << " agents" << endl;
-                
-                
-                SmartGameAI::GameSimulator game_sim;
-                
-                
-                vector<vector<int>> dummy_tile_map; 
-                game_sim.save_game_state(current_my_agents, current_enemy_agents, 
-                                       16, 16, dummy_tile_map); 
-                
-                SmartGameAI::SmitsimaxSearch search(&ai);
+
                 vector<SmartGameAI::TacticalDecision> joint_actions = search.smitsimax_search(
-                    current_my_agents, current_enemy_agents, 20, 30.0); 
+                    current_my_agents, current_enemy_agents, timer); 
                 
                 
                 for (size_t i = 0; i < current_my_agents.size() && i < joint_actions.size(); i++) {
                     agent_decisions[current_my_agents[i].agent_id] = joint_actions[i];
                     cerr << "🎯 SMITSIMAX Agent " << current_my_agents[i].agent_id << ": " 
-                         << joint_actions[i].action_type << " (value: " << (int)joint_actions[i].expected_value << ")" << endl;
+                         << action_type_name(joint_actions[i].action.type()) << " (value: " << (int)joint_actions[i].expected_value << ")" << endl;
                 }
             } else {
                 cerr << "🎮 USING INDIVIDUAL: Standard agent decisions" << endl;
@@ -2092,66 +1696,13 @@ int main() {
                     
                     if (use_smitsimax && agent_decisions.count(agent.agent_id)) {
                         decision = agent_decisions[agent.agent_id];
-                        cerr << "🔍 Agent " << agent.agent_id << " using SMITSIMAX decision: " << decision.action_type << endl;
+                        cerr << "🔍 Agent " << agent.agent_id << " using SMITSIMAX decision: " << action_type_name(decision.action.type()) << endl;
                     } else {
                         decision = ai.make_optimal_decision(agent, current_enemy_agents, current_my_agents);
-                        cerr << "🎮 Agent " << agent.agent_id << " using INDIVIDUAL decision: " << decision.action_type << endl;
+                        cerr << "🎮 Agent " << agent.agent_id << " using INDIVIDUAL decision: " << action_type_name(decision.action.type()) << endl;
                     }
                     
                     
-                    if (decision.action_type == "MOVE" || decision.action_type == "MOVE_SHOOT" || decision.action_type == "MOVE_THROW") {
-                        pair<int, int> target_pos = {decision.target_x, decision.target_y};
-                        
-                        if (movement_blacklist.count(target_pos)) {
-                            cerr << "🚫 Agent " << agent.agent_id << " collision detected at (" << decision.target_x << "," << decision.target_y << ") - finding alternative" << endl;
-                            
-                            
-                            bool found_alternative = false;
-                            int dx[] = {1, -1, 0, 0, 1, -1, 1, -1};
-                            int dy[] = {0, 0, 1, -1, 1, 1, -1, -1};
-                            
-                            for (int i = 0; i < 8 && !found_alternative; i++) {
-                                int alt_x = decision.target_x + dx[i];
-                                int alt_y = decision.target_y + dy[i];
-                                pair<int, int> alt_pos = {alt_x, alt_y};
-                                
-                                if (alt_x >= 0 && alt_x < ai.board_width && alt_y >= 0 && alt_y < ai.board_height) {
-                                    if (!movement_blacklist.count(alt_pos)) 
-                                    {
-                                        bool occupied = false;
-                                        for (const auto& other : current_my_agents) {
-                                            if (other.agent_id != agent.agent_id && other.x == alt_x && other.y == alt_y) {
-                                                occupied = true;
-                                                break;
-                                            }
-                                        }
-                                        for (const auto& enemy : current_enemy_agents) {
-                                            if (enemy.x == alt_x && enemy.y == alt_y) {
-                                                occupied = true;
-                                                break;
-                                            }
-                                        }
-                                        
-                                        if (!occupied) {
-                                            cerr << "✅ Alternative found: (" << alt_x << "," << alt_y << ")" << endl;
-                                            decision.target_x = alt_x;
-                                            decision.target_y = alt_y;
-                                            movement_blacklist.insert(alt_pos);
-                                            found_alternative = true;
-                                        }
-                                    }
-                                }
-                            }
-                            
-                            if (!found_alternative) {
-                                cerr << "⚠️ No alternative found - agent will hunker down" << endl;
-                                decision.action_type = "HUNKER_DOWN";
-                                decision.tactical_reasoning = "Collision avoidance - no safe move";
-                            }
-                        } else {
-                            movement_blacklist.insert(target_pos);
-                        }
-                    }
                     if (priority_target != nullptr && agent.cooldown == 0)
                     {
                         SmartGameAI::TacticalDecision focus_fire = ai.evaluate_focus_fire(agent, *priority_target);
@@ -2163,11 +1714,17 @@ int main() {
                     agent_decisions[agent.agent_id] = decision;
                 } else {
                     SmartGameAI::TacticalDecision dead_decision;
-                    dead_decision.action_type = "HUNKER_DOWN";
+                    dead_decision.action = PackedAction::hunker_down();
                     dead_decision.tactical_reasoning = "Agent is dead";
                     agent_decisions[agent.agent_id] = dead_decision;
                 }
             }
+            vector<PackedAction> planned_orders;
+            for (const auto& agent : current_my_agents) planned_orders.push_back(agent_decisions[agent.agent_id].action);
+            search.settle_moves(current_my_agents, current_enemy_agents, planned_orders);
+            for (size_t i = 0; i < current_my_agents.size(); i++) {
+                agent_decisions[current_my_agents[i].agent_id].action = planned_orders[i];
+            }
             vector<SmartGameAI::AgentState> alive_agents;
             for (const auto& agent : current_my_agents)
             {
@@ -2186,7 +1743,7 @@ int main() {
                     if (agent_decisions.count(agent_id)) {
                         decision = agent_decisions[agent_id];
                     } else {
-                        decision.action_type = "HUNKER_DOWN";
+                        decision.action = PackedAction::hunker_down();
                         decision.tactical_reasoning = "Default defensive action";
                     }
                     
@@ -2211,9 +1768,7 @@ int main() {
         cout.flush();
         cerr.flush();
         
-        auto turn_end = chrono::high_resolution_clock::now();
-        auto duration = chrono::duration_cast<chrono::milliseconds>(turn_end - turn_start);
-        cerr << "Turn " << turn_number << " completed in " << duration.count() << "ms" << endl;
+        cerr << "Turn " << turn_number << " completed " << (int)timer.elapsed_ms() << "ms after its input" << endl;
         cerr << "========================================" << endl << endl;
     }
     return 0;
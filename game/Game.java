@@ -78,6 +78,9 @@ public class Game {
         }
 
         initControlZones();
+        if (!inTutorial) {
+            GameTrace.recordMap(this);
+        }
     }
 
     private void initControlZones() {
@@ -139,6 +142,7 @@ public class Game {
         }
 
         if (!isCinematicFrame()) {
+            GameTrace.recordTurn(this, turn);
             doMoves();
             animation.catchUp();
             doHunkers();
@@ -149,6 +153,7 @@ public class Game {
             doDeaths();
             updateControlZones();
             scorePoints();
+            GameTrace.recordResult(this);
         }
 
         computeEvents();
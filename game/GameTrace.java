@@ -0,0 +1,112 @@
+package com.codingame.game;
+
+import java.io.FileWriter;
+import java.io.IOException;
+import java.io.PrintWriter;
+import java.util.List;
+
+import com.codingame.game.action.Action;
+import com.codingame.game.grid.Coord;
+
+/**
+ * Records every performGameUpdate as plain text so tools/rules_replay.cpp can
+ * check the C++ rules engine against this referee turn by turn. Disabled
+ * unless the JVM runs with -Dgame.trace=path; games then append to that file.
+ *
+ * MAP width height tiles           tiles as in the global info, row by row
+ * AGENT id player maxCooldown optimalRange soakingPower
+ * TURN turn points0 points1 agentCount
+ * A id x y cooldown balloons wetness moveX moveY combat arg1 arg2
+ * AFTER points0 points1 zones0 zones1 agentCount
+ * S id x y cooldown balloons wetness
+ *
+ * A lines hold the state the bots read and the commands they sent: moveX/moveY
+ * are -1 without a MOVE, combat is NONE, SHOOT id -1, THROW x y or HUNKER -1 -1.
+ * S lines hold the state after the update, with cooldowns as the next turn's
+ * input shows them; dying agents are still listed.
+ */
+public class GameTrace {
+    private static final String PATH = System.getProperty("game.trace");
+    private static PrintWriter out;
+
+    private static PrintWriter out() {
+        if (PATH == null) {
+            return null;
+        }
+        if (out == null) {
+            try {
+                out = new PrintWriter(new FileWriter(PATH, true), true);
+            } catch (IOException e) {
+                throw new RuntimeException("cannot open game trace " + PATH, e);
+            }
+        }
+        return out;
+    }
+
+    static void recordMap(Game game) {
+        PrintWriter w = out();
+        if (w == null) {
+            return;
+        }
+        StringBuilder tiles = new StringBuilder();
+        for (int y = 0; y < game.grid.height; ++y) {
+            for (int x = 0; x < game.grid.width; ++x) {
+                tiles.append(game.grid.get(new Coord(x, y)).getType());
+            }
+        }
+        w.println(Serializer.join("MAP", game.grid.width, game.grid.height, tiles));
+        for (Agent a : game.getAllAgents()) {
+            w.println(Serializer.join("AGENT", a.id, a.owner.getIndex(), a.maxCooldown, a.optimalRange, a.soakingPower));
+        }
+    }
+
+    static void recordTurn(Game game, int turn) {
+        PrintWriter w = out();
+        if (w == null) {
+            return;
+        }
+        List<Agent> agents = game.getAllAgents();
+        w.println(Serializer.join("TURN", turn, game.players.get(0).points, game.players.get(1).points, agents.size()));
+        for (Agent a : agents) {
+            Action move = a.getMoveAction();
+            Action combat = a.getCombatAction();
+            String command;
+            if (combat == null) {
+                command = "NONE -1 -1";
+            } else if (combat.isShootAction()) {
+                command = "SHOOT " + combat.getAgentId() + " -1";
+            } else if (combat.isThrowAction()) {
+                command = "THROW " + combat.getCoord().toIntString();
+            } else {
+                command = "HUNKER -1 -1";
+            }
+            w.println(
+                Serializer.join(
+                    "A", a.id, a.getPosition().toIntString(), a.cooldown, a.getBalloons(), a.getWetness(),
+                    move == null ? "-1 -1" : move.getCoord().toIntString(), command
+                )
+            );
+        }
+    }
+
+    static void recordResult(Game game) {
+        PrintWriter w = out();
+        if (w == null) {
+            return;
+        }
+        List<Agent> agents = game.getAllAgents();
+        w.println(
+            Serializer.join(
+                "AFTER", game.players.get(0).points, game.players.get(1).points,
+                game.controlZone.get(0).size(), game.controlZone.get(1).size(), agents.size()
+            )
+        );
+        for (Agent a : agents) {
+            w.println(
+                Serializer.join(
+                    "S", a.id, a.getPosition().toIntString(), Math.max(0, a.cooldown - 1), a.getBalloons(), a.getWetness()
+                )
+            );
+        }
+    }
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+// NODE ARENA
+// Fixed-capacity pool for search-tree nodes. All slots are allocated once when
+// the search object is built; allocate() hands them out contiguously and reset()
+// rewinds the cursor, so starting a new turn is O(1) and no node is ever freed
+// individually. Because siblings are allocated back to back, a node can refer
+// to its children as an index range [first_child, first_child + child_count)
+// instead of a vector of pointers.
+//
+// Slots are NOT re-constructed on allocate(); callers must initialize every
+// field they read. Members that own heap storage (e.g. vectors) keep their
+// capacity across resets, which is what makes reuse allocation-free.
+template <typename Node>
+class NodeArena {
+public:
+    static const int NONE = -1;
+
+    explicit NodeArena(size_t capacity) : nodes(capacity), used(0) {}
+
+    // Index of a fresh slot, or NONE once the arena is exhausted
+    int allocate() {
+        if (used >= nodes.size()) return NONE;
+        return (int)used++;
+    }
+
+    void reset() { used = 0; }
+
+    Node& operator[](int index) { return nodes[index]; }
+    const Node& operator[](int index) const { return nodes[index]; }
+
+    size_t size() const { return used; }
+    size_t capacity() const { return nodes.size(); }
+    bool full() const { return used >= nodes.size(); }
+
+private:
+    std::vector<Node> nodes;
+    size_t used;
+};
@@ -0,0 +1,493 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "packed_action.h"
+#include "rules_engine.h"
+#include "scenario_index.h"
+
+// OPENING BOOK
+// Deep searches of early-game positions, made offline by tools/book_maker.cpp
+// and read by the bot from a memory-mapped file, so a hit costs one binary
+// search and no parsing. A position is one side's view of a turn start: the
+// map, then my agents and the enemies by slot, each with its class stats,
+// position, wetness, cooldown and balloons. Agent ids are not part of it.
+//
+// Maps are symmetric under Grid.opposite and so is the game: player 1's view
+// of a position is player 0's view of its mirror image. Each position is
+// stored once, in the orientation with my agents furthest left (then
+// furthest up, then hashing lower), so that positions alike are stored
+// alike; a lookup mirrors the query the same way and mirrors the stored
+// actions back. SHOOT targets are stored as slots, since the ids depend on
+// which player one is.
+//
+// Positions the book lacks can still borrow from its nearest ones: every
+// entry keeps each slot's position and wetness, and nearest() searches them
+// with a ScenarioIndex among entries of the same map size and line-up.
+//
+// File: OpeningBookHeader, then entry_count OpeningBookEntry sorted by key,
+// in native byte order. Books compiled into the bot use a packed text form
+// instead (pack_opening_book below) and are expanded on first lookup.
+
+const uint32_t OPENING_BOOK_MAGIC = 0x4B4F4F42;  // "BOOK"
+const uint32_t OPENING_BOOK_VERSION = 2;
+const int OPENING_BOOK_MAX_SIDE = 5;             // GridMaker.MAX_SPAWN_COUNT
+
+struct OpeningBookHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t entry_count;
+};
+
+struct OpeningBookEntry {
+    uint64_t key;
+    uint32_t actions[OPENING_BOOK_MAX_SIDE];  // PackedAction bits of my agents, stored orientation
+    uint16_t slots[RULES_MAX_AGENTS];         // x | y << 5 | wetness << 9 per slot, stored orientation
+    uint16_t visits;                          // Search visits behind the weakest choice, saturating
+    uint8_t agent_count;                      // My agents
+    uint8_t ply;                              // Turn of the line it was searched on, from 0
+    uint8_t slot_count;                       // All agents
+    uint8_t width, height;
+    uint8_t reserved;
+};
+
+static_assert(sizeof(OpeningBookEntry) == 56, "OpeningBookEntry is a fixed 56-byte record");
+
+// Scenario features of an entry: per slot x, y and wetness / 10, so ten
+// points of wetness weigh as much as a tile of distance
+const int OPENING_BOOK_FEATURES = 3 * RULES_MAX_AGENTS;
+typedef ScenarioIndex<OPENING_BOOK_FEATURES> BookIndex;
+
+inline uint16_t opening_book_slot(int x, int y, int wetness) {
+    return (uint16_t)((x & 31) | (y & 15) << 5 | std::min(std::max(wetness, 0), 100) << 9);
+}
+
+inline void opening_book_features(const OpeningBookEntry& entry, int16_t* features) {
+    for (int s = 0; s < RULES_MAX_AGENTS; s++) {
+        bool used = s < entry.slot_count;
+        features[3 * s] = used ? (int16_t)(entry.slots[s] & 31) : 0;
+        features[3 * s + 1] = used ? (int16_t)((entry.slots[s] >> 5) & 15) : 0;
+        features[3 * s + 2] = used ? (int16_t)((entry.slots[s] >> 9) / 10) : 0;
+    }
+}
+
+// Entries whose features are comparable
+inline uint64_t opening_book_group(const OpeningBookEntry& entry) {
+    return (uint64_t)entry.width | (uint64_t)entry.height << 8 | (uint64_t)entry.slot_count << 16
+         | (uint64_t)entry.agent_count << 24;
+}
+
+inline uint64_t opening_book_mix(uint64_t z) {
+    z += 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// The map's Grid.opposite. The bot never sees GridMaker's ySymmetry flag, but
+// the tiles show it: a map symmetric through its centre mirrors both axes.
+// If both mirrors fit the tiles, either one maps games onto games.
+struct BookSymmetry {
+    int width = 0, height = 0;
+    bool flip_y = false;
+
+    explicit BookSymmetry(const BoardLayers& board) : width(board.geo.width), height(board.geo.height) {
+        flip_y = true;
+        for (int y = 0; y < height && flip_y; y++) {
+            for (int x = 0; x < width; x++) {
+                if (tile(board, x, y) != tile(board, width - x - 1, height - y - 1)) {
+                    flip_y = false;
+                    break;
+                }
+            }
+        }
+    }
+
+    int mirror_x(int x) const { return x < 0 ? x : width - x - 1; }
+    int mirror_y(int y) const { return y < 0 || !flip_y ? y : height - y - 1; }
+
+    static int tile(const BoardLayers& board, int x, int y) {
+        int i = board.geo.index(x, y);
+        return board.high_cover.test(i) ? 2 : (board.low_cover.test(i) ? 1 : 0);
+    }
+};
+
+// Where a position sits in the book
+struct BookPosition {
+    uint64_t key = 0;
+    bool mirrored = false;
+};
+
+inline BookPosition opening_book_position(const RulesTable& table, const RulesState& state) {
+    const BoardLayers& board = table.board;
+    BookSymmetry symmetry(board);
+
+    // The map and the line-up read the same in both orientations
+    uint64_t fixed = opening_book_mix(((uint64_t)board.geo.width << 40) | ((uint64_t)board.geo.height << 32)
+                                      | ((uint64_t)state.count << 8) | (uint64_t)state.my_count);
+    for (int y = 0; y < board.geo.height; y++) {
+        for (int x = 0; x < board.geo.width; x++) {
+            int type = BookSymmetry::tile(board, x, y);
+            if (type != 0) fixed ^= opening_book_mix(((uint64_t)board.geo.index(x, y) << 2) | (uint64_t)type);
+        }
+    }
+    for (int s = 0; s < state.count; s++) {
+        fixed ^= opening_book_mix(((uint64_t)(s + 1) << 48) | ((uint64_t)table.shoot_cooldown[s] << 32)
+                                  | ((uint64_t)table.optimal_range[s] << 16) | (uint64_t)table.soaking_power[s]);
+    }
+
+    RulesState mirror = state;
+    int shift_x = 0, shift_y = 0;  // Mirrored minus as is, over my agents
+    for (int s = 0; s < state.count; s++) {
+        mirror.x[s] = (int8_t)symmetry.mirror_x(state.x[s]);
+        mirror.y[s] = (int8_t)symmetry.mirror_y(state.y[s]);
+        if (s < state.my_count) {
+            shift_x += mirror.x[s] - state.x[s];
+            shift_y += mirror.y[s] - state.y[s];
+        }
+    }
+    mirror.rehash();
+
+    BookPosition position;
+    position.mirrored = shift_x != 0 ? shift_x < 0 : (shift_y != 0 ? shift_y < 0 : mirror.hash < state.hash);
+    position.key = fixed ^ (position.mirrored ? mirror.hash : state.hash);
+    return position;
+}
+
+// One action between this game's view and the book's: coordinates mirrored
+// when the position is, SHOOT targets as ids here and as slots there
+inline PackedAction opening_book_action(PackedAction action, const RulesTable& table, int count,
+                                        const BookSymmetry& symmetry, bool mirrored, bool to_book) {
+    int target = action.target_agent_id();
+    if (target >= 0) {
+        int mapped = -1;
+        if (to_book) {
+            for (int s = 0; s < count; s++) {
+                if (table.agent_id[s] == target) mapped = s;
+            }
+        } else if (target < count) {
+            mapped = table.agent_id[target];
+        }
+        target = mapped;
+    }
+    int tx = action.target_x(), ty = action.target_y(), bx = action.bomb_x(), by = action.bomb_y();
+    if (mirrored) {
+        tx = symmetry.mirror_x(tx);
+        ty = symmetry.mirror_y(ty);
+        bx = symmetry.mirror_x(bx);
+        by = symmetry.mirror_y(by);
+    }
+    return PackedAction::make(action.type(), tx, ty, target, bx, by);
+}
+
+// Map size and each slot's position and wetness, in the stored orientation
+inline void set_opening_book_slots(OpeningBookEntry& entry, const RulesState& state, const BookSymmetry& symmetry,
+                                   bool mirrored) {
+    entry.slot_count = state.count;
+    entry.width = (uint8_t)symmetry.width;
+    entry.height = (uint8_t)symmetry.height;
+    for (int s = 0; s < state.count; s++) {
+        int x = mirrored ? symmetry.mirror_x(state.x[s]) : state.x[s];
+        int y = mirrored ? symmetry.mirror_y(state.y[s]) : state.y[s];
+        entry.slots[s] = opening_book_slot(x, y, state.wetness[s]);
+    }
+}
+
+// The entry for my agents' actions (slots 0..my_count) in this position
+inline OpeningBookEntry make_opening_book_entry(const RulesTable& table, const RulesState& state,
+                                                const PackedAction* actions, int visits, int ply) {
+    BookPosition position = opening_book_position(table, state);
+    BookSymmetry symmetry(table.board);
+    OpeningBookEntry entry = {};
+    entry.key = position.key;
+    set_opening_book_slots(entry, state, symmetry, position.mirrored);
+    entry.agent_count = (uint8_t)std::min((int)state.my_count, OPENING_BOOK_MAX_SIDE);
+    entry.visits = (uint16_t)std::min(std::max(visits, 0), 0xFFFF);
+    entry.ply = (uint8_t)std::min(ply, 255);
+    for (int i = 0; i < entry.agent_count; i++) {
+        entry.actions[i] = opening_book_action(actions[i], table, state.count, symmetry, position.mirrored, true).bits;
+    }
+    return entry;
+}
+
+// Sorted by key, keeping the deepest search of any duplicate key
+inline void sort_opening_book(std::vector<OpeningBookEntry>& book) {
+    std::sort(book.begin(), book.end(), [](const OpeningBookEntry& a, const OpeningBookEntry& b) {
+        return a.key != b.key ? a.key < b.key : a.visits > b.visits;
+    });
+    book.erase(std::unique(book.begin(), book.end(),
+                           [](const OpeningBookEntry& a, const OpeningBookEntry& b) { return a.key == b.key; }),
+               book.end());
+}
+
+// Packed text form of a sorted book, small enough for a string literal:
+// LEB128 varints of the entry count, then per entry the key's delta from the
+// previous key, agent_count, ply, visits, each action's bits, width, height,
+// slot_count and each slot, all in base64. Sorted keys are spread evenly, so a delta saves log2(count) bits.
+const char OPENING_BOOK_BASE64[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+inline std::string pack_opening_book(const std::vector<OpeningBookEntry>& book) {
+    std::vector<uint8_t> bytes;
+    auto varint = [&](uint64_t value) {
+        for (; value >= 0x80; value >>= 7) bytes.push_back((uint8_t)(value | 0x80));
+        bytes.push_back((uint8_t)value);
+    };
+    varint(book.size());
+    uint64_t previous = 0;
+    for (const OpeningBookEntry& entry : book) {
+        varint(entry.key - previous);
+        previous = entry.key;
+        varint(entry.agent_count);
+        varint(entry.ply);
+        varint(entry.visits);
+        for (int i = 0; i < entry.agent_count; i++) varint(entry.actions[i]);
+        varint(entry.width);
+        varint(entry.height);
+        varint(entry.slot_count);
+        for (int s = 0; s < entry.slot_count; s++) varint(entry.slots[s]);
+    }
+
+    std::string text;
+    for (size_t i = 0; i < bytes.size(); i += 3) {
+        uint32_t group = (uint32_t)bytes[i] << 16;
+        if (i + 1 < bytes.size()) group |= (uint32_t)bytes[i + 1] << 8;
+        if (i + 2 < bytes.size()) group |= bytes[i + 2];
+        size_t chars = std::min<size_t>(4, bytes.size() - i + 1);
+        for (size_t c = 0; c < chars; c++) text += OPENING_BOOK_BASE64[(group >> (18 - 6 * c)) & 63];
+    }
+    return text;
+}
+
+// False on text pack_opening_book did not write
+inline bool unpack_opening_book(const char* text, size_t length, std::vector<OpeningBookEntry>& book) {
+    std::vector<uint8_t> bytes;
+    uint32_t bits = 0;
+    int pending = 0;
+    for (size_t i = 0; i < length; i++) {
+        const char* digit = std::find(OPENING_BOOK_BASE64, OPENING_BOOK_BASE64 + 64, text[i]);
+        if (digit == OPENING_BOOK_BASE64 + 64) return false;
+        bits = (bits << 6) | (uint32_t)(digit - OPENING_BOOK_BASE64);
+        pending += 6;
+        if (pending >= 8) {
+            pending -= 8;
+            bytes.push_back((uint8_t)(bits >> pending));
+        }
+    }
+
+    size_t at = 0;
+    bool ok = true;
+    auto varint = [&]() {
+        uint64_t value = 0;
+        for (int shift = 0; ok; shift += 7) {
+            if (at >= bytes.size() || shift > 63) {
+                ok = false;
+                break;
+            }
+            uint8_t byte = bytes[at++];
+            value |= (uint64_t)(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) break;
+        }
+        return value;
+    };
+    uint64_t count = varint();
+    book.clear();
+    uint64_t key = 0;
+    for (uint64_t e = 0; e < count && ok; e++) {
+        OpeningBookEntry entry = {};
+        entry.key = key += varint();
+        entry.agent_count = (uint8_t)std::min<uint64_t>(varint(), OPENING_BOOK_MAX_SIDE);
+        entry.ply = (uint8_t)varint();
+        entry.visits = (uint16_t)varint();
+        for (int i = 0; i < entry.agent_count; i++) entry.actions[i] = (uint32_t)varint();
+        entry.width = (uint8_t)varint();
+        entry.height = (uint8_t)varint();
+        entry.slot_count = (uint8_t)std::min<uint64_t>(varint(), RULES_MAX_AGENTS);
+        for (int s = 0; s < entry.slot_count; s++) entry.slots[s] = (uint16_t)varint();
+        book.push_back(entry);
+    }
+    return ok;
+}
+
+// A book position near a queried one, with its choice in the query's
+// orientation and agent ids
+const int OPENING_BOOK_MAX_NEIGHBOURS = 16;
+
+struct BookNeighbour {
+    int distance;  // Squared feature distance; 0 for an exact match of positions and wetness
+    int visits;
+    int ply;
+    PackedAction actions[OPENING_BOOK_MAX_SIDE];
+};
+
+// Read-only view of a book file, or of a packed book compiled in
+class OpeningBook {
+public:
+    OpeningBook() = default;
+    OpeningBook(const OpeningBook&) = delete;
+    OpeningBook& operator=(const OpeningBook&) = delete;
+    ~OpeningBook() { close(); }
+
+    // False, with the book left empty, if the file is missing or not a book
+    bool open(const char* path) {
+        close();
+        int fd = ::open(path, O_RDONLY);
+        if (fd < 0) return false;
+        struct stat info;
+        bool ok = fstat(fd, &info) == 0 && info.st_size >= (off_t)sizeof(OpeningBookHeader);
+        void* data = ok ? mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+        ::close(fd);
+        if (data == MAP_FAILED) return false;
+
+        const OpeningBookHeader* header = (const OpeningBookHeader*)data;
+        if (header->magic != OPENING_BOOK_MAGIC || header->version != OPENING_BOOK_VERSION ||
+            (uint64_t)info.st_size != sizeof(OpeningBookHeader) + header->entry_count * sizeof(OpeningBookEntry)) {
+            munmap(data, info.st_size);
+            return false;
+        }
+        mapping = data;
+        mapping_size = info.st_size;
+        entries = (const OpeningBookEntry*)(header + 1);
+        entry_count = header->entry_count;
+        return true;
+    }
+
+    // A packed book (pack_opening_book) that stays packed until first used
+    void attach_packed(const char* text, size_t length) {
+        close();
+        packed = text;
+        packed_length = length;
+    }
+
+    void close() {
+        if (mapping) munmap(mapping, mapping_size);
+        mapping = nullptr;
+        mapping_size = 0;
+        entries = nullptr;
+        entry_count = 0;
+        packed = nullptr;
+        unpacked.clear();
+        index.clear();
+        indexed = false;
+    }
+
+    bool loaded() const { return entries != nullptr || packed != nullptr; }
+    size_t size() const {
+        expand();
+        return entry_count;
+    }
+
+    const OpeningBookEntry* find(uint64_t key) const {
+        expand();
+        const OpeningBookEntry* end = entries + entry_count;
+        const OpeningBookEntry* it = std::lower_bound(entries, end, key,
+            [](const OpeningBookEntry& entry, uint64_t k) { return entry.key < k; });
+        return it != end && it->key == key ? it : nullptr;
+    }
+
+    // My agents' book actions for this position, in this game's orientation
+    // and agent ids; visits is how deep the search behind them went
+    bool probe(const RulesTable& table, const RulesState& state, PackedAction* actions, int* visits = nullptr) const {
+        if (!loaded() || state.my_count > OPENING_BOOK_MAX_SIDE) return false;
+        BookPosition position = opening_book_position(table, state);
+        const OpeningBookEntry* entry = find(position.key);
+        if (!entry || entry->agent_count != state.my_count) return false;
+        BookSymmetry symmetry(table.board);
+        for (int i = 0; i < entry->agent_count; i++) {
+            PackedAction stored;
+            stored.bits = entry->actions[i];
+            actions[i] = opening_book_action(stored, table, state.count, symmetry, position.mirrored, false);
+        }
+        if (visits) *visits = entry->visits;
+        return true;
+    }
+
+    // The up to k book positions nearest this one, among those of the same
+    // map size and line-up, nearest first; returns how many. The index is
+    // built on first use.
+    int nearest(const RulesTable& table, const RulesState& state, int k, BookNeighbour* out) const {
+        k = std::min(k, OPENING_BOOK_MAX_NEIGHBOURS);
+        if (!loaded() || state.my_count > OPENING_BOOK_MAX_SIDE || k <= 0) return 0;
+        build_index();
+        BookSymmetry symmetry(table.board);
+        BookPosition position = opening_book_position(table, state);
+        OpeningBookEntry query = {};
+        query.agent_count = state.my_count;
+        set_opening_book_slots(query, state, symmetry, position.mirrored);
+        int16_t features[OPENING_BOOK_FEATURES];
+        opening_book_features(query, features);
+
+        BookIndex::Match matches[OPENING_BOOK_MAX_NEIGHBOURS];
+        int found = index.nearest(opening_book_group(query), features, k, matches);
+        for (int i = 0; i < found; i++) {
+            const OpeningBookEntry& entry = entries[matches[i].id];
+            out[i].distance = matches[i].distance;
+            out[i].visits = entry.visits;
+            out[i].ply = entry.ply;
+            for (int a = 0; a < entry.agent_count; a++) {
+                PackedAction stored;
+                stored.bits = entry.actions[a];
+                out[i].actions[a] = opening_book_action(stored, table, state.count, symmetry, position.mirrored, false);
+            }
+        }
+        return found;
+    }
+
+    // Sorts the entries, keeps the deepest of any duplicate keys and writes
+    // the file
+    static bool write(const char* path, std::vector<OpeningBookEntry> book) {
+        sort_opening_book(book);
+
+        FILE* file = std::fopen(path, "wb");
+        if (!file) return false;
+        OpeningBookHeader header = {OPENING_BOOK_MAGIC, OPENING_BOOK_VERSION, (uint64_t)book.size()};
+        bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1 &&
+                  std::fwrite(book.data(), sizeof(OpeningBookEntry), book.size(), file) == book.size();
+        return std::fclose(file) == 0 && ok;
+    }
+
+    // Every entry, sorted by key
+    const OpeningBookEntry* begin() const {
+        expand();
+        return entries;
+    }
+    const OpeningBookEntry* end() const { return begin() + entry_count; }
+
+private:
+    void* mapping = nullptr;
+    size_t mapping_size = 0;
+    // Expanding a packed book fills these in, so they change under const
+    mutable const OpeningBookEntry* entries = nullptr;
+    mutable size_t entry_count = 0;
+    mutable const char* packed = nullptr;
+    mutable size_t packed_length = 0;
+    mutable std::vector<OpeningBookEntry> unpacked;
+    mutable BookIndex index;
+    mutable bool indexed = false;
+
+    void expand() const {
+        if (!packed) return;
+        if (!unpack_opening_book(packed, packed_length, unpacked)) unpacked.clear();
+        packed = nullptr;
+        entries = unpacked.data();
+        entry_count = unpacked.size();
+    }
+
+    void build_index() const {
+        if (indexed) return;
+        expand();
+        int16_t features[OPENING_BOOK_FEATURES];
+        for (size_t i = 0; i < entry_count; i++) {
+            opening_book_features(entries[i], features);
+            index.add(opening_book_group(entries[i]), features, (int)i);
+        }
+        index.build();
+        indexed = true;
+    }
+};
@@ -0,0 +1,210 @@
+#pragma once
+
+#include <cstddef>
+
+// OPENING BOOK DATA
+// Generated by tools/book_embed.cpp; do not edit. 458 of 820 positions,
+// packed as opening_book.h's pack_opening_book.
+
+constexpr char OPENING_BOOK_DATA[] =
+    "ygORhtSwzfqfCQMAmiemFKYkpigUCgagAYACoAKzAZMCswKJ/aK2u/OKHQMB+iq2DKYUphAOBwZBgAFgrQEsTJyg8arqp5wYAwCk"
+    "MqYMphSmBAwGBkBgIGtLiwHTu+jwwq/vQAMB1iSmEJYYpiQSCQaBAaEB4AGQAbAB0AHVgq2ug9HTSwMB1iq2ILYElgQQCAbhAQEh"
+    "zwEOT626jq+liLjqAQQB7CC2EKYYtgimFA4HCGGgAQFgTQzMAa0B8eC99Zvq9wwEAYwhpgy2CKYYtgQSCQhAIaABAdEB8AFx8QHK"
+    "tZaj2PzsGwMBiCimEKYcpgwOBwZgwAFATM0BTbuIp7GQ0tItBQCcIqYIphimBKYQphwSCQogoAEAgAHgAfEBcZECkQEx0JDFovaY"
+    "uQgDAMQjpgSmHKYkEgkGIMABgALxAVERxLP5n7ax4B4EAOhFphSmBKYUpgwOBwigAQCAASCtAQ2NAS3l4/e43ImJSAMAsCmmGJYM"
+    "piAUCgagAWDgAbMBc/MBiJf5s+i+0UMDAcwkphSmDLYYDAYGgAEgoQFLSqoBrt2FpLfvuYUBAwGOK7YItiSmFBIJBkGBAmHQARCw"
+    "AbO3/enrycdTAwHiJLYgthymDBAIBuEBwQFADi6vAdqTrPel/6cNBAGeKJYMtiC2EJYYEAgIYOEBYYABzwEOjgFOq5nuya/QtUoD"
+    "AJwwpiSmEKYYEgkGgAKAAaABEZEBcaf5ztW9j6MzAwC6Q6YIlhSmHA4HBkBgwAGNAW0Norrbp56DpDgDAZwopgS2ILYgEgkGAMEB"
+    "gQLwAVAQwvvfmqvHsykDAJYupgimFKYYDgcGIIABoAGtAU0tzsuQzc7s8MwBAwHUKbYElhimGA4HBgGAAcEBzAFNDNby1M367sWY"
+    "AgQB6iaWILYQtiCmCBAICOEBgQHBASAObi7PAZ6Zr+3BxexBBAGsH7YUlgy2GKYoFAoIoQFhgQGAApIB8wGyAVKFnb6Z7O9nAwDI"
+    "MqYQpgimCAwGBmAAQEurAWuqxsu91tnmiQEFAPYnpgimHKYgphSmEBIJCkDAAeABgAFg0QFRMZEBsQGQiObE2ou+EgMBiCamGLYE"
+    "lhAQCAbAAQFA7gEOLrb1tdqIh9sDAwHcLrYUpgSmKBQKBoEBAKACsgGzAjLNiuXbkcubFwMAxjamFKYkpggSCQZggAJAsQER0QGk"
+    "j477sKS1cwQAtCSmBKYYphCmCAwGCACAAUAgqwEra4sBwMPnosGn/twBAwHiHrYcthimBA4HBsEBoQEALSyNAfjXk7q6nJs3AwD4"
+    "H6YklhCmIBIJBoACgAHAARGRAVHPjqzJq8KeAwQAnFGmDKYEpgymGAwGCEAAYKABa6sBSwvr2cPC79vePwMA7CSmFKYYphwSCQaA"
+    "AaABwAGRAbEB0QGQzJWd9Pq+KwUAkB+mGKYUphimCKYIDgcKoAGAAcABIEAtTQ2tAY0B5L7P5JTyuhQEAN4rphimDKYEliAQCAig"
+    "AUAAwAFPrwHvAS+Yi6zpo5zpJQMAoCSmDKYEpigUCgZAIKAC8wGTAhPhtMe/t4ebRQMB/humFLYEtgQQCAaAASEBb+8B7gGzhZfk"
+    "quOHHwUBiCi2GJYQthC2DLYEDAYKoQGAAYEBIQGqAYsBigEqK8uDxcb8p9QSAwGYOqYItgS2GAwGBkEBgQFqqgEqrrTM64zH+QID"
+    "AeYlpgS2IKYYEAgGAOEBoAHOAQ5Pr9vVqtj5vm0DAfAophSWCLYEEAgGgAEAAW/OAe4BuoTK2Pfq0gsFAIZEpgSWCKYYpiSmGBIJ"
+    "CgBAoAGAAoABkQLRAXERkQHtlcPX0tPaIQMA5CumIKYclgwQCAbgAcABYA8vjwHR15nSlMKCKQMAgC6WFJYIlhwQCAagAUDgAU+v"
+    "AQ/RhafV+oajNAQBnDK2GKYEpgi2GAwGCKEBIECBAQqqAUpLj+iz9eDblmwEAawnlhiWBLYQpgwOBwiAAQGBAUDNAQyMASyW8p/e"
+    "+p36igEDAaglpgSmHKYQDgcGIcABYKwBDW2Y0bqZ49n6SgMA6CmmFKYcpggQCAagAcABAE8v7wG86eip3cvxAQMA5jOmCKYUpgwM"
+    "BgZAYCBLayuPt5WcjoKgjAEDAewjphimDLYgEAgGwQFA4QFPrwEO34ep2v6HpiEDAJAwpgSWDKYYEAgGAGCgAe8BjwFPisfJkZP5"
+    "9zMFAZAxphymCKYQtiSmCBIJCsABIIABgQIBUdEBkQEQkQLeo8/EjOmSFQMBtDW2BKYctgQOBwYBwAEhzAENrAHN8t2c0OLzDQQA"
+    "0kSmEKYgphCWFBAICEDgAWCgAa8BD48BT9/zvf7/mq4oBAH4JqYElhi2ELYQEgkIAIABgQFBkQLRAZAB0AHogaKPwry/hwEFAIAn"
+    "lhCWHKYIpgSmJBIJCkCgASAAgAJRsQExEZEC5bat4PH0hzwDAKY5phimBJYMDAYGoAEAIAurAYsByPi2n9SIm0AEAfwetgSmGKYQ"
+    "tgwMBggBoAFgIaoBC2qKAd7C64Pdx6woAwCcTaYQpgSmCBIJBkAAINEBkQLxAc/YwOmt8+YbBAHeKrYgpgy2KJYcFAoIwQFggQKh"
+    "AdIBc5ICsgG4xYqY/qXbPAUAyh2mJJYUpgSmHKYMEgkK4AFgAMABIDGxAZECUfEBgIDOn9u4kREEAZYnlgy2CLYctgwOBwhBAcEB"
+    "YW0MzAFs0LSizJi8mS4DAP4lpgimDKYkFAoGIGCAApMC0wEz+520+eSW8lkDAJowpgymJKYQEgkGQIACYNEBEbEB4Zi+ssm0uXMD"
+    "AcQuthCmGKYEDAYGQYABAGorqwHHjsagks+NYQUBiCymEKYEphC2GLYQDAYKgAEAYKEBgQFKqwFLCirw8p6qr/bTKgQBvCqmGLYE"
+    "tiC2DBAICKABAcEBIU/uAS7OAZHThpCVg5ylAQMA+kCmDKYIlhgQCAZAIMABrwHPAS/A25j4qq94AwCUMaYIphymDBQKBiDAAUCT"
+    "AnPzAZ/H8aO29soKBAH0KaYUphiWKLYgFAoIgAGgAYAC4QGyAdIBkwLyAZbr4ODTnsxUAwHoJLYMthSmHBAIBkFhwAGuAY4BL4Hq"
+    "pcLU0sYIAwHuIrYkthSmEBQKBqECgQGAAbICkgHTAfvelpfy+JvSAQMAxDimDKYEphgMBgZAAIABa6sBK6WEndrK4ONfAwHqIrYU"
+    "tiS2GBIJBoEBgQKhAZABEJEBlJXyzuKqrBADAaYstgymJKYQFAoGQYACQPIBc5ICq4/D1tnO2YECBACIIqYQpiSWDKYcEgkIYOAB"
+    "IMABsQEx8QFRusbAyunk7LEBAwD6L6YIpgSmGAwGBiAAoAGLAasBC4+XxJGV35ooAwH2M7YMtgS2HA4HBiEBwQHNAcwBLYT3+s32"
+    "rZiuAQQAsC2mGKYMpgSmEAwGCKABQCCAAQtriwErxdjTqr6AoDwEAPAuphiWEKYophgUCgjAAYABgAKgAdMBkwGTArMBoIOXra+h"
+    "44gBBAHiJbYYlgi2HLYgEAgIgQFAwQHhAW6vAS4OqYmJ5+v1lhADAKw1pgymBKYUDgcGIACAAa0BzQFNnL7V+vi/tE4DAbYqthim"
+    "BLYcDgcGgQEgwQFMrQEMhq6854LTuwEDANospgymEKYcEAgGQGCgAa8BjwFPyP7vkpvutAwDAYosphS2GLYIDAYGYKEBAUsKiwG/"
+    "lJK9uLTXNAMB7iG2GKYktigUCgbBAYACoQKTAVMT//bbo9/Co0wDAbgltgymGJYkEgkGIcEBgQKRAlAQi978rpv3yDoEAMY6phym"
+    "BKYEphgQCAjgASAAoAEPzwHvAU+MtprR88P8pwEDAbYhpgy2GKYcDgcGQIEBwAGsAUws7KaP7/eIiBEDANovphyWDKYgEAgGwAFg"
+    "4AEvjwEPlo+Y/bT794wBBADQMpYMpgimGKYIEgkIYCCAAQCxAfEBkQGRAseJrJvCpbQpAwDKRqYYphCmBAwGBqABQCALa4sByqG0"
+    "tLeL6xcDAZ4mtgyWGLYYDgcGIYEBoQGNAUwNrYfE96mnn+gBAwG4KbYYlhymDBQKBsEBoAFAcpMB8wG5w9j2pMzRhwIFAfoetiC2"
+    "CKYYtgyWFBAICuEBAaABYWAO7wFPjgGvAeLcjobVlI8YBQDgJaYclgiWFKYklggSCQrgAUCgAYACADHRAXERkQL9jMGc9qXiDwMB"
+    "oCK2DKYctgQUCgZBwAEh8gEz8wHG47v/2ZzKTgMBsB2mDKYcthQQCAZAwAGBAY8BDm+s4OP9oPLPEAUBuB22FLYEtgS2CLYYDAYK"
+    "oQEhAUGBAaoBCwpKigG/yayI4vTqYgMAsh6mCKYgphgQCAYg4AHAAc8BDy+VkaLIoYOJOAMBsh+mIJYIthgUCgaBAkCBARPzAdMB"
+    "+pH316qstHYEAeoothSWHKYIthAOBwihAaABIGEsDMwBbLfRhbW5tMRTBAGELbYQtgS2BLYYDAYIgQEhAaEBKqsBqgEK7pu+m+zM"
+    "zRgEAdghtiCmCKYEthgQCAjhASAAoQEv7wHuAU6q8Kr2kq+9qAIDAc4stgS2CLYUDAYGIQGhAYoBqgEKoPHe2eL47xQDANQkphyW"
+    "BKYkEgkGoAEggAJx8QER88yf3cCX4CAEAIYmphCmKKYcpgwUCghggALAAUDTATNz8wG7lO7U49S1GgUB6iKWGLYIthSmBJYQDAYK"
+    "oQFBgQEAQApqKqsBa/n4gdjygeGiAQMB8CGWKLYUphwUCgahAoEBwAGyApIBkwHb5vyQz9aOCAMB4iymGJYEtgQOBwaAASABjQEt"
+    "DKasyMWVrokCAwH0IpYItgiWHBAIBkEhoAGuAe8BLtWvvdOozrEFBAHmHrYEtiCWGKYUEgkIAcEBgAFh8QExcLABiorxkc72oBEF"
+    "AJIyphimBKYMpgSmFAwGCqABIEAAYAuLAWurAUvK7dvB0M+ErAEDAa4xpiCmHKYUEgkGgQLAAaABEDBxoI+XqorumYIBAwCqNqYE"
+    "piCWEBAIBgDgAUAP7wFPrdLcr/73kTwFAModphSmBKYYphymDBIJCoABAKABwAFgkQGRAnFRsQHDgvbB9vnzOQMBmi22CLYctgwO"
+    "BwYBwQFBzAEMjAHS1rvL3N+GPwQB5h62CJYYpiiWFBQKCAHAAYECYLICkgET0wGwmLD0ypPfbgMAyjOWEKYEphwSCQZAIMAB0QHx"
+    "AVHg8vHdqKPbIwMB5jC2GJYIthgMBgaBAQChASqKAQr5jq+b0sCaFAMBziG2CLYYthAMBgYhoQGBAasBCkveqdKIgoDjPwMBhie2"
+    "BLYElhwUCgYBIeABsgLzAVOVtZO8jfrYCQQAtiimFKYYlgimEA4HCKABwAEAYC0NzQFt2Lum3su5uU0DAKImphCWGKYEEAgGYIAB"
+    "AG+PAQ/Zl6el+56uEAMAuDKWGKYEpgwOBwbAASBgDa0BbZe8joLN3uJmBQDsLKYklgyWEKYYpgQSCQqAAiCAAaABABHxAZEBcZEC"
+    "nOCP3Pu/wCcDAYwfpiCWBLYQEAgG4AEgYa8BTm6Iqfy0n7CbBgQBsCO2BKYQtiSmGBIJCAFggQLAAZACsQEQUbWq9urxyeIwBAG+"
+    "ILYEtgy2CJYcEAgIASFBoAEOD06OAeGd+t7f+vURBADSL6YYphSmBKYMDgcIwAGAASBADU2tAY0BvZHk5czIx6ABBAGGKLYUtgim"
+    "BKYQDAYIoQFBAGAKaqsBS4SXuarGxfQFAwGGJ6YglgymIBQKBsABYMEB8gFzswGc1+Sr+dqsMAMAwCemEJYYpggOBwZggAEgbU2t"
+    "Adrsh/iSztYKAwHmL6Ygphi2KBQKBuABwAGhAlNSEtbBqLT7wNwDBADaJaYgphCmHKYIEAgI4AGAAcABQA9vL68BjNPAwe7VsTAD"
+    "AegvthS2BLYYDAYGgQEhoQEqqwEK0tiSoYGd+50CBAHQMrYglhSmDKYEEgkI4QGBAUAAMJABsQHxAavsp8qnu6sXAwH0G6YEtgy2"
+    "GBAIBiBBgQHuAa4BbqDx5e3wwt+UAQMBrjamELYEtgwSCQZgASGxAZAC8AGUl+X8kZbiEAMBxh+WFLYcpgQUCgZgwQEhUtIBMuvP"
+    "us7T+uscAwCoMKYUpiCmKBQKBqABwAGgApMBcxO6jbOp4JrOCgMAzDGWFKYIphgOBwZgIKABba0BLcvDo8b68KIgAwDYLqYElgym"
+    "JBQKBgBg4AGzAtMBU46QuY+rnJUIAwHGL7YctgSWBA4HBqEBASAszAGtAd6nrau6hIBlAwH8KrYIphymEA4HBkHAAUBtzQFNhKSK"
+    "ub/Zrj8EAKIopgSWHKYophAUCggAoAGAAkCzApMBM/MBvMjomNiN+REDAIAvliCmDKYMEAgGwAFAYM8BT2+f+uSz+P7MUgMBmB2m"
+    "ELYMlgQOBwZgQQEtjAHMAYjj5oLm7pUtBQG4I7YIthS2BKYMtiQSCQohoQEBYOEB8AFwkAKxATCVrOmty+3TZgMB5D22FKYEtggQ"
+    "CAZhAEFv7wGuAfi84Lz98ImaAQMB0iCmFKYEphQMBgZhIGBKqwFri5C4s/+X7poBBQGWH7YYtgS2FKYIthQMBgqhAQGBASBhCqoB"
+    "KmpK5urm3NC81RMEAP4vpgimFKYQphAMBghAoAFggAFLqwFriwHyt8CSte/o0wEDAconphiWCKYcEAgGoAFA4QEurwEO997UmNrO"
+    "yz8DAMwvpgymBJYQDgcGIABALQ1NrIeUkKjKxbMCAwGSJLYQphy2CBAIBmHAAQFuzwEOsc34+8Oey0wDAZYdthCmBKYcEAgGYSDg"
+    "AY4BzwEuyvrQ142w4ykEANYvpiCmIKYcphASCQjgAYACoAGAATERcZEBrLDk5bOF8CYFAIgbphCmBKYMphymEA4HCoABIEDAAWCN"
+    "AS1NzQFt58fJxoCQwzgDAbIlphCWCKYcEgkGgAFAwAGQAfEBUYiZt5SQqdYNBACYKaYclhCmGKYIDgcIwAGAAaABAA1NLc0B48e3"
+    "wKeO8CIDAb4wphCmGKYIEAgGgAGgASBurwEOzujG0o600wcEAMgwpgimFKYgpggQCAhAYOABIK8BjwEPzwHX+7aT1Z+tKQQBmB62"
+    "FJYIthS2HBQKCKEBQIEB4QGSAdIBsgEz8/zD4OG2omwEANYyphCmBKYcphAOBwhAAMABYE0NzQFt2IL3h9i39wcDALI1pgimHKYQ"
+    "DgcGIKABQK0BLY0B7qOazLPe0T4DAPw2piSWHKYQEgkGgAKgAYABkQKxAZEB5//iqqCJVAMBwDKmDLYIphQOBwZAAWBNDG27wdiE"
+    "tZLuAgMA4i+mDJYkpgwUCgZgoAIg0wETkwKA9pfA0uzTDgMA7lCmEKYYlggMBgZAoAEAawurAc68nuiFqd1fAwDyL6YQpgymBA4H"
+    "BoABQABNjQHNAeCJkKWlwOg1AwGmL7YItiCWFBAIBgHhAWAO7gFvoJr524zqrHwDAaghphC2GJYEDAYGgQGhASAqCosB5Yi+9L+Y"
+    "iOACAwHcIpYItgSWHA4HBgABoAGsAcwBDNOM2pST+4U1BAHAIrYYthy2BLYMDgcIoQHBAQFhLC2tAWy6qsrj/YKUEQMB7CC2DKYE"
+    "piAQCAZBAMEBrgHOAU/axoGA+5TBIQUAyiimCKYYpgimEKYIDAYKAKABQIABIAurAUuLASubyJKQ5JS7FQUB0iS2BLYYtgiWFLYI"
+    "DAYKAaEBQWAhCqoBSqsBKr78uq+gg8xTBQGiHKYUtgSWFLYEthgMBgphAaABIaEBaiuKASqqAars46/Spf97BQGGMLYUpgS2HKYI"
+    "thQOBwphAMEBIKEBbKwBDG0sxo3ohYK7rwUDALIuphSWDKYUDgcGgAFgoAFNbS3gsr2/jNCRYgQBvCu2BKYUtgy2EAwGCAGAASFB"
+    "qgErigFqm6DQqfPT+gkDAKoophiWGJYMFAoGwAGAAWBzswHTAbmn9v/xyLF+AwGmHLYEliiWEBQKBgGAAkCyAhKSAuvIsazr2u8f"
+    "AwCYMaYUlgimHA4HBoABQMABTY0BDan4ra7NoZkFAwDkLqYQpgSmIBAIBkAA4AGvAe8BD5fSm6zAsOoHBAHiKLYYlhiWELYoFAoI"
+    "oQHAAYABoQKSAVLzARLg2vqRsdzFHAMBiji2GLYEtggMBgahAQEhCqoBa4CNmI7O1sR7BAGcKrYIlhS2DLYMDAYIAWFBIQpqSiqF"
+    "iOuc6vaERAMBpCa2DJYQtggMBgZhQAFKa6oB/4Sy/ZejsUwDAcY7lhC2KLYkFAoGgAGBAqECkwGSArIC27GShaa5g0sEAMwupiiW"
+    "IKYIphAUCgigAoACIIABEzOTArMBj7GE7NHP9GYDAJQ0phiWDKYEEgkGgAEgAJEBMRGohf7ytLzwzAIEAdoqtgymJKYMthwSCQhh"
+    "gAJAwQGwATCRAlCdq4Dq0PjZLwMBrCKmBKYgphgUCgYAgAKAATKTAnK++s7NkbezCAQAjjGmGKYEphymCBAICIABAMABIG/vAS/P"
+    "AZyr4/DLl8YyAwGYN7YUtgSmDBAIBmEBQI4B7gGvAZ27rJ7szpQpBAGAH5YUpgi2ILYgEAgIYUHBAeEBbi+vAe4BhI6LpsqkkDME"
+    "AeQkthymEKYQpggQCAjBAWCAAUAPjwFOrwH+9KmK3bLYWQMBhh22FKYctgQQCAZhoAEBjwGvAS/q77PuvIquNAQBpCimGJYktiC2"
+    "BBQKCIAB4AHhAQHzAVMzsgKh3py28MfyFgMBih22CLYotggUCgYBoQIhsgIz8wGKseyl/NPGEQMAtiemDKYcpggUCgZA4AEg8wFT"
+    "kwL82YOkuJ/0MwQB8iG2HKYclgi2KBQKCKEB4QFAoQKSAXOzARL31cDW4svxEAMAtEimEKYEpgwQCAZgACCPAe8BzwHj1/vXi4bR"
+    "BQMA9C+mKJYMphAUCgaAAmCAATPTAbMBjf30t+rBugYFAeIephCWBJYUthimDBIJCmABoQHBAUCQAZACcFDRAfyK1tKZv6N0AwHE"
+    "KaYktgSmHBQKBoACAaABM7ICkwHsmdG4s8GgLQUBlie2BJYcthS2IKYMEAgKAeABoQHhASHuAS5vDs4B2oilhObknUkEAa4mphS2"
+    "HLYEpggOBwiAAcEBASBsLcwBbcPhtqXN1v8bBQG+LKYUlgy2BLYMthgOBwqgAWAhQcEBTWysAYwBDMu5gfr+8fkoBQGsJLYYlhi2"
+    "FKYEpgQMBgqhAYABgQEhIKoBiwGKASoKmtPp/suJumwEAdAnpgymIKYgpggUCghA4AGAAgGzAVNSsgKPpOfrvP2YCQMB8i62HLYE"
+    "thQOBwbBAQGhAcwBDKwB7fmf0tuxxAMDAJwrphSmBKYYDAYGgAEgoAEriwELtJ71pa3l2wEDAfwithSmBJYgEgkGgQEgwAGRAdEB"
+    "Ubmtmpj4hahcAwHUK7YMpgSmJBQKBkEAoQLyAbMCM9Lcp7TmsO23AwMBsie2JKYUtiQUCgaBAqABoQIychKyi6rlh42cCwQArjGm"
+    "BKYMphSmDBIJCCBggAFA8QGxAZEB0QHHn8Ds1bGqUAMB+B2mGLYopgQUCgaAAaECANIBM/MB/cHb5I36ookEBQCwNKYUpgSmGKYM"
+    "pgwMBgqAAQCgASBAiwELqwErS4uZ8qq0zPQLBAH0IrYYtgy2CLYYEAgIoQFBAcEBTq4B7gEPnpaBqtiVg0IDAdYglhy2DLYMDgcG"
+    "oAFBIS1trAHb2+qx9dX0pwEDAPgsphSmCKYEEAgGYCAAjwHPAe8Btbm9j9m9hwsDAcYzphSmKKYMFAoGYYACQLMBErMCoNX4v/KP"
+    "pFUDAYAcliS2FJYQEgkG4AGBAYABELEBcJ7s2rmk+vkGAwDsJaYEpgimHA4HBgBAoAHNAY0BLafIuJGCvq0EAwGoHbYEthCmHBQK"
+    "BgFhwAGyAvMBM6iBn47g2pAHAwCSMKYklhimKBQKBoACwAGgAjNzE/WT0+3g5SwDAOwrphCmGJYIDAYGgAGgAUArC2ui2JfhqJaw"
+    "ZwUBxh22DKYctgi2BKYkEgkKQcABIQHgAXHRATAQkAK13O+XkaCUYAMBzDKmGLYgpggSCQaAAYECILABEPEB9+LFnJm4nhQDAJ4y"
+    "lhSmBKYMEAgGYCBAjwHPAa8Bw8rHmr2QvE4EANQ2pgyWFKYEphQMBghAYACgAWtLqwELluWg9+LY/KcCBQGEKbYEthimEJYUtggM"
+    "BgoBoQFBoAEhCqoBSmsqzYP4tNOFjEMDAMBGphSmIKYQEAgGYOABgAGPAQ9v38vFl8KjnwoDAfgdphC2HLYEFAoGQcEBIXPSATKf"
+    "mIqN+7TveAQArC6mDKYgpiSmBBQKCGDAAeABANMBc1OzAuibjY20xN4EAwGqHrYIlhCWHBQKBgFA4AGyApICU5O4w/TEoL1iAwHW"
+    "IbYUtgymCBIJBoEBYSBxsAHxAf7K+YOZ6cpsAwHcJKYEthimFAwGBgChAWCKAQoqgMSI4Z+D1hADAIY/pgSmGKYQDAYGIKABgAGL"
+    "AQsrqqGYoburrr0BBQGaNaYIpgi2GLYIlhAMBgogAKEBAYABKyqrAQpr9v+Tt8WeuDsDAaQppgy2BLYYDgcGQAGBAY0BzAFMibDl"
+    "pNOolzgDAdosphSWCLYcEgkGYADBAbEBkQIxxIDtgK/A8QwDAcwtlhC2IKYQEAgGgAHhAYEBrwHvAW+U4smD59iQIQQBviSmIKYI"
+    "tgSmHBAICMABAAGhAQ7PAe8BTuSuwsj3m7QiBQH4LbYgpgSmGLYQlggQCArhAQCgAWFADu4BT44BjwGOgYGZqZXRmgEDAawdphiW"
+    "CKYQEAgGwQEAYC7OAY8Bv4zftYKCtzgEALAwphCWCKYYpiAQCAhgQMAB4AFvT88B7wGv3O6Ak5GjewMAriemCKYkpgwUCgYg4AFg"
+    "M/MBc8TRmI2S6/qVAQUAzkamFKYUphSmCKYIDAYKoAFggAEgAKsBa4sBKwuAvKjYgov6DgMA/CemCKYQphAQCAYAQIAB7wGvAW/m"
+    "vNm6naDaOAMApjOmHKYEphQOBwbAAQCgAc0BDa0BmLKJm9WP8oYBAwHuJaYUpiCmIBQKBoAB4AGAArMBchKDgILihp/8KAMAlC6m"
+    "EKYUphAOBwZAoAGAAY0BLU3TrIPxm7v9AgMAqC6mGKYUpggSCQagAWBAcbEB0QGn1Zr4tJi3GgMBhCG2GKYElhQQCAbBASFgLu8B"
+    "jwHThrL7z+bMXgUBgh+mCLYYtiC2GLYMEgkKIMEB4QGBAWHQATEwkAGwAbjk47CA84OjAQQBzCO2CJYkphy2HBIJCAGBAqEB4QGQ"
+    "AhBwMPTw5p+QtsZEAwHgJ6YUpiCmEBAIBqAB4AFgjwHuAY4BntngstKY1p0BAwHEMZYUtiSmHBIJBqEBgQLAAXAQUf3KuYq5n7Ci"
+    "AQMB7B62FKYMliQUCgaBAWHgAbIB0gFTkIu9wfmU4SIFAfgkphS2ELYMthC2GA4HCoABYSFBwQEtbawBjAEMn97so47lxiwDAJAu"
+    "phimBKYIDgcGgAEAIE3NAa0B4b6Wk7/Q7TQDAdIntgy2GLYEEAgGQaEBAW/PAQ7/y/n65tHuSwUA6CmmFKYEphSmCKYUDAYKoAEA"
+    "gAFAYAurAStrS7qK383A1c8PBQDcHaYMpgSmGKYIphQMBgpgAIABIKABawuLASurAerVvs7IpfkFAwCKLpYYliSmJBQKBsAB4AGg"
+    "AnNTE5KWhIvhpr8mBAGCH6YEthS2ILYMEAgIIGHhASGPAY4BDs4B+YDy8PGNtBgFALRKpgSmEKYcphymEA4HCgCAAcABoAFgDY0B"
+    "zQGtAW3L/OCH2v71hQEDAdYipgy2IKYUEAgGYOEBgAGvAS9ul8CU6+aDhzIEAeAktgyWHLYcpggSCQhhoAHBASCwAXFQ8QGS3sHb"
+    "jbyfMAMA1DWmEKYEphQMBgZgAIABawuLAcX3if/qq9RxAwGqKKYEphi2KBQKBgDAAYEC8wFzMsHgroLarbE3AwCSQqYgpgSmCBAI"
+    "BuABACDvAQ8vyLXIldae91sDAOBFpgSWDKYYDAYGACCgAasBiwEL+ZiU7J7Ut0QDAZ4ithSmBLYoFAoGgQEAgQKyAbMCE/fb7KG/"
+    "iasDBAHsI7Yclhy2CLYIDgcIwQGgASFBLUzNAYwBuu2ssNzrzAcEAZIltgSWCLYQthgQCAgBAEGBAQ4uTq8BlKec7I369SwFAYYl"
+    "lgS2CKYYtgiWFAwGCiAhoAEBYCsLqgEKiwGSpdGLkdbXlQEFAdwftgSWBLYUtiCWHBIJCgEgoQGBAqABkALRAXAQkQHU7PGs6tfS"
+    "DAMBmCK2GJYIthgOBwaBAUChAUyNASy3/oaQwIKbOQQA3CmWIKYQphimDBAICMABgAGgASAvb0/PAdvC+Nfp/7TAAQMA1DOmFKYc"
+    "pgQQCAZgoAEAb68BD7qRw8KcoYYhAwG+MaYIlhi2HA4HBiCAAcEBrQFNDOup7YWjpJanAQMBzCamFLYUtgwMBgZgYSEriwEqp+mv"
+    "p6LS2UgEAJYopgSmCKYMlhgQCAgAIECAAQ8vT48B0dLU/ernpN0BAwH2LLYElgi2GBAIBgFAoQHuAW9OqvTdhZum4B0DAYYiphS2"
+    "CLYUEAgGoAFBYe8BL26n/fCnkZybXAQBviO2EKYItgS2FAwGCIEBAAGhASqKAaoBCrWAh+iIzMJUAwCOLaYophSWHBQKBqACgAGg"
+    "AbMCkwGzAY244Z/qgeA7AwDsQaYEpiimCBQKBgCgAiCzAhOTAs7N6KnQxLw4BACWLqYYphCmFJYkFAoIoAFggAHgAZMB0wGzAVPt"
+    "2dT44Nq4QAQAwkKmBJYUpgymDAwGCABgIECrAUuLAWu19N746I6wTwMA4DKmFJYIpgQOBwZgQABtTQ2ayYmMn5zMCwMAqj2mBKYU"
+    "phwOBwYAoAHAAc0BLQ2czrOB2ODvCwMB4BymCKYYtiAQCAZAoAHhAY8BrwHPAZ7/282iktIoAwCoMpYYphCmCBIJBoABYECRAbEB"
+    "0QGViJLiqJbMewMA0jOmFKYkphQSCQaAAYACoAGRARFxsZuun8KPzgsDALRIphimJKYcEgkGoAGAAuABcREx3Lj5s6W+lwwEAMg0"
+    "phSmCKYEphgMBgiAASAAoAEriwGrAQuQxr3a0/e35QEDAdgvlhSWHKYoFAoGoAHgAaACcjMS6Y7Ahvykqh8DAYQvphSmGKYYEAgG"
+    "gAGgAcABT68B7gGCmsGopdqnEgMBtCy2ILYglhQSCQaBAuEBoAEQUXHY5ZiDyrbhogEEAeQmphS2FLYgtggQCAhgYeEBIc8BjgEO"
+    "zgHWhI/dqq7kRgQAjDOmEJYYpgSmEA4HCGDAAQBAbQ3NAY0BuIzyq/atw4QBAwGIJrYIlhimKBQKBiGAAaACkgLzATLa8KzOh8bk"
+    "CwMAwkmmBKYEphgOBwYgAMABrQHNAQ3pt9qyts32DgMByBy2CLYgphAUCgYh4QFgswJS0wG0quqK5e60SwUAxEamCKYIlhSmCJYU"
+    "DAYKQCCgAQBgSyurAQtr+NHbrsDGqFQDAbomphCmBKYkFAoGQQCAAvIBswIS7aK2jof6gi8DAeIfthy2GLYEEAgGoQHBAQFvLs8B"
+    "p5mbpJ/gwX8FAbYflgi2IKYUtiC2DBAICgHBAYAB4QEh7gEPTg7OAbHC2MHFsZ9rBQCyRqYQpgSmEKYUphAMBgpgIECgAYABS4sB"
+    "awsrn6zrkYrcmm8DAJgypgSmHKYIDgcGAKABIM0BLa0BxaDi4KPx1lYDAa4dtgimDKYoFAoGIUCBApICswETt5bn0JKRlzYEAJou"
+    "phCWGKYgpggSCQhggAHAAUCxAZEBUdEBh/6z9daBWwMA7CuWEKYcpggUCgZAwAEgU9MBM/f4kp3asKUKAwGSHrYUthi2EA4HBmGh"
+    "AYEBjQEsTLXmj8mJ28QUBADQLqYYpgymHKYgEgkIoAFAwAHgAXHRAVExzIerqN/Y7B0DAOgnpgSWDJYgFAoGACCAArMCkwIzvrjI"
+    "qPaQtisDAYQmthC2JJYEEgkGYYECIJEBEPEBg4PL2NOO9wMDAbQlphymGKYIEgkGwAGAAUFwkQHQAa2evKP194gxAwDAJ6YQpgim"
+    "IBAIBmBAwAGPAa8BL/qThpu57NV0AwGyHZYItgy2GAwGBkBBoQGLASuqAaSa+q7Yx8YLAwCsL6YMlhymJBQKBiDgAYACkwJTM9+g"
+    "qdfOgKYqAwDGNKYMphimBBAIBkCgAQBPrwEPhNPrh5aWmVsEAdAktgSmFLYMtgwMBggBoAFBIaoBC0uKAbTskt2b54EVBQCUL6YU"
+    "pgimHKYQphgOBwpgIMABQKABba0BDY0BLfTShd+BzY4VAwG2MqYcpgi2JBIJBsABAIECcJECEIya2NOl44bJAQMBljamFKYEpiAS"
+    "CQZgAOABsQGRAlCN3LXsztO3MwUBiiSWIJYQphS2JKYEEgkKwAFAgAGBAgBR8QGRARCQAvro+sOIqKxFAwHsKKYYtgimEA4HBqAB"
+    "AUAtzAGsAa7awpPf6+1BAwGoHbYEphCmJBQKBgFAgAKyAtIBc6S8+f+XpbJ6AwHONbYUlgimDAwGBmEAQEqLAUuP37D+9NnNMQMB"
+    "3iy2FKYEtiQSCQahAQCBAlGRAhCYmPn38PXhEAQB2Ci2EJYUtgSmGAwGCEFgAaABakqqASuT54rbn7SfHQQB3CemHKYYpgS2CA4H"
+    "CKABgQEAQQwtrAGMAfiH1fyBhsYUAwCgKqYYpgSWCA4HBqABAEAtzQGNAZfMwZKRxt1TBAHWJLYclgi2HLYgEgkIoQFBwQHhAXDx"
+    "AVAw88jR0YKZ4oICAwCMMqYMpgimFA4HBkAggAFNLY0B9YqWueXrtzgEAaIfthSmKKYgtgwUCghhoALBAUHSARNy8gGci4ajzpLY"
+    "ZgMBiie2FLYEphAMBgahAQFACqoBigGEzuH4nueBJwMBwCm2HKYUtggSCQahAYABQVGRAdABtLfBkqD7wnUDAaghtii2HLYoFAoG"
+    "gQLBAaECMpMBErusr4+zxZwRAwD+KaYglhCmGBQKBuABgAHAAfMBkwHTAdKM59zmg9E7AwDGMZYkpgSWGBQKBuABAMABU7MCc7SR"
+    "0v/qs9gXAwGWIqYUphSmDA4HBqABoQFADCzNAcy+/9+g06QGAwHqIbYQtgS2FA4HBkEhgQFMLIwBzKb8jLyA5BIDAag/tgSmDLYY"
+    "DAYGAUChAaoBawr22eDY3tCPxAEEAdQrtgi2CLYQlhQMBghBAWGhAWqqAWsKuqXr4bCt70wEAcAfphSmBKYYtiAQCAhhIKAB4QFu"
+    "Ts4B7gHI77Sd3fabDwUAlCemBKYgphimIKYIEAgKAMABoAHgASDvAS9PD88BueicpurfxQ4FAJAxpiCWCJYYphCmCBAICuABAIAB"
+    "YEAP7wFvjwGvAaWKlNT9qtvhAQMAlDCmJKYclhgSCQaAAuABwAERMVGY+OT+2vb0dAQByCC2HKYkthSmDBIJCOEB4AGhAWAwEHCx"
+    "AfXq4dOwwvhBAwG4JLYgpgyWHBQKBuEBYKAB0wFz0gGM1ISN4+qhAwMBuiS2HLYEthAOBwbBASFhLc0BbNrcld/hn9UDAwGUHLYI"
+    "piCmDBQKBiGAAmETkwKTAa2x0YDe0ukYBQG0HbYIphi2DLYUtggMBgpBgAEhgQEBSqoBC4oBCuyxrfSqwLkqBACaKaYUpiCWDKYo"
+    "FAoIoAHgAWCgApMBU9MBE+SMvsTL8vwlBAGsHLYkpiCmDKYQFAoIoQLgASFgEjLzAdMBudDE/sPorAcEANwwphimFKYEpggMBgig"
+    "AYABACALK6sBiwGZm6P9w7SwLQQBiCO2HJYMthymBA4HCMEBYKEBIAxMLMwBq72pmeiZjXkDAJgxphimDKYQEAgGwAFAYM8BT2/v"
+    "r9Wx9sjGLQMAximmEKYcpgwOBwZAoAEgTa0BLc2AzueH9ZMTAwC8MKYYlgSWEBAIBsABIEAvzwGvAdSK+vKIg7YBAwG2LaYYphC2"
+    "BBIJBqABQAGxAVEQrq20i5XYuMsCAwHwH7YEphC2FBAIBgGAAaEB7gGvAU7soN2Fyp7YJQQB7hymBKYkthSmDBIJCCDgAaEBYZAC"
+    "UJEBsAHpn+KgmvnQIAUBtC6mFJYItgi2BJYQDAYKoQEAQQFACqsBaqoBK5Hyh5CToeZOAwHQMpYYlgi2FA4HBoABIaEBTawBLJyb"
+    "k5GiitZfAwCuJ6YUpgSmGA4HBmAAoAFtzQEt7qmp2Irgi18EAZAypgSWELYYtggSCQgAQIEBQZECkQGQAdAB86L7u8/h7UoEAYwo"
+    "thi2FLYEtgQMBgihAYEBASEKKqoBigGw24X3qd7cDgQBzB+2HKYEthi2IBIJCKEBIMEB4QFw0AFQML781sCIsIgFAwGsLrYUphy2"
+    "DA4HBmGgASFsLawBp9Oqg8iG5LgBAwDuMKYYphimDA4HBsABoAEgDS2tAa/PsuaHxNAxAwHwL6YUpgimIBAIBoABIMABb88BL5fE"
+    "46a47/szBQG2LLYElgi2GLYklhgSCQoBQKEBgQKAAZAC8QFwEHG7hqn1j7z3HwUB6CW2GJYItgy2BKYUDAYKoQEAQQGAAQqrAWqq"
+    "AWvCzsSG5t2mNQQAxkKmCKYMpgymCAwGCABgQCALa0srhOv537+Q3zsEAJAlpiCmFJYMpgwSCQjgAYABYCAxkQGxAfEBwb+4kf6T"
+    "jmkDAZQqthimEKYEDAYGoQFgAApLqwHwtaytrK73AwMA2CqmEKYUpiQUCgZggAGAAtMBswEz6e+Nl6GUhmsEAcYstgi2FLYEphQM"
+    "BghBYQGAAWpLqgELvaOSnZjZ6UMDAPIvpgimIJYQFAoGIOABQJMCU/MB6p2so5qA/kYDAegxpiC2DKYIEAgG4AFBQO8BTo8BvJKm"
+    "rNPC9BEDAZQrtiSWDLYcEgkGgQJgwQEQsQFQ9Z+NxPbQ4Q4EANQwphimHKYkpiQUCgigAcABoALgAbMB0wGzAvMBvdzNgKnq3igD"
+    "AOAkphSmBKYkFAoGgAEggAKzAZMCM8bY4qyW96YlBADWJaYEpiSmHKYgEgkIAIACoAHgAZECEXExsITll4juqYQCAwDKLKYMphim"
+    "FA4HBmCgAYABbS1Np6fMj/qJ3WAFAJQxphimBKYIpgymEAwGCqABIABAgAGrASsLS4sB/M2JuO7nqx8EANwuphSmBKYQphAMBgig"
+    "AQBggAELqwFLK6XeqoDeyM10AwGQH6YMthi2FA4HBiChAYEBjAFNbZvAhsXapPMIAwGOLJYMthiWBAwGBmChASBLCqoB/ai2jt7O"
+    "2C8DAJ49pgSmHKYMDgcGAMABQM0BDY0BgpHlpL/YxQ4FAcAhthSmCLYUtgi2DAwGCqEBAYEBQWEKqgEqiwFKhoGb1fS4zwUEAe4r"
+    "pgi2GLYMthAMBgggoQFhgQErqgFqigGZj9Oi54GPywEFAN4lphSmEKYIpgymHA4HCqABYCBAwAEtba0BjQENlf+ai5OJhCcEAPQx"
+    "pgSWEKYkphwSCQgAgAGAAuABkQKRAREx7f7I28LR/nwEAcQetiS2JKYUpgwSCQjhAYECoQFgMDFwsQGbzOScr9qBPQQB2CS2HLYM"
+    "tgimIBAICKEBQQHgAU6uAe4BLrmx9d2D26MFAwD0MKYMlgymBAwGBmAgAEuLAasBv6XZ4ZHxjzMDAcQrthi2JJYQEgkGgQGBAoAB"
+    "kAEQcLu7gsrN981CAwHgIrYYlgymKBQKBqEBYYACsgFT8gGr7cjf///hLwMBjCGWCLYkphAUCgYA4QFgkgJS0wG8z5DOoqaECgQB"
+    "kCqmDLYMphimDBIJCEAhoAEg0QHwAXGQApqNktSzuOY7BAG6H7YYthimJKYkFAoIoQHBAYAC4QGTAbMBkwLyAe65xPLW7PUkAwH8"
+    "J6YMlhi2BAwGBiCAASFraiqj95Ty3ZeANwMB5COmHKYEthAOBwagAQBhDKwBbJO/14yfybM7AwHGH6YMphymIBQKBkDAAYECswJz"
+    "MumDwryWqIlxBAGUKbYkthSmDJYEEgkI4QGBAWAgMJAB0QGRAsuShd+i0bN6BAHsLLYMtgSmELYYDAYIQQFAoQFqqgFKCtq4kN7q"
+    "tJVJAwGaJJYYphC2IBQKBqEBQOEBsgFykwKOna7G2NjCBAMA+DCmFJYIphgMBgZgQKABa0urAcr29vLvmLuyAwUAviGmEKYUpgim"
+    "FKYIDAYKQKABIIABAEurASuLAQvNl5Scgp7EAwMAxiymGKYMpggOBwaAAUAgTY0BrQGzg82eyIKaDAMB4h2mELYUthwSCQaBAaEB"
+    "wQGQAbAB8QHZgeKBqZTaOgMB3iWWHJYktigUCgbgAeEBoQJTcxKSs/HChOOpwgEDAZY5lhC2BLYUDgcGgAEBoQFNzAEshpy3wsGi"
+    "l6MBBQHONrYMpgSWDLYYthAMBgphAGChAYEBK6sBSwoq1o32m/Sw2gEDAeIephiWFLYIDgcGoAFgIS2MAawB4Nnds7zJzwUFAbQf"
+    "phCWILYItgi2JBIJCmDAASEBgQJQ0QEwEPEBzubqv4L9mDkFAYgftiSmDKYMthi2BBIJCoECQGChAQEQ8AGxAXCQAsyLncnPjLpZ"
+    "AwDONqYUpiCmFBAIBqAB4AGAAa8B7wGPAeiKy96Zh7koBQG0M6YIlgy2GJYYtgwOBwoBYMEBwAFhDG3MAc0BbMrx+4z8tKQTBQHA"
+    "H7YUthS2HLYIpgQOBwqhAYEBwQEhICxMDM0BjAHh4Kz5gsKelwEFAcAothS2CLYclhS2FA4HCmEhwQFgoQFszQEMrQEsvf+Lm9ys"
+    "8yoDAcQ6thS2BLYYDAYGYQGBAWoKigGvsKKA/NqmZgMAmC2mFKYQliAUCgaAAWDAAbMB0wFz1cPb0bf67BMDAfInpgi2CJYYDgcG"
+    "AUHAAa0BjAENvOb626bdgksFALA9phimDKYUlgSmDAwGCqABQIABIGALayuLAUv63YPTheDZ1QEDAcwqphC2BLYgEAgGYAHhAY8B"
+    "7gEO9oDd2+yH7jADAbgephC2HKYEEAgGgAHBASBOLu4Bzvq01++qmjEDANhIpiCWHKYoFAoGgALgAaACM1MTz4bVscqpkj0DALgu"
+    "lgyWGKYgEAgGYMAB4AFvzwHvAYKI+fTLvc8kBAGoIaYctgS2ELYIDgcIwAEBgQEhjQEMjAFNmPHA05SH3E8EAKQyphSWDKYYpiAQ"
+    "CAiAAWDAAeABb48BLw+i8Z2miKuTRAQBpie2KLYkpgymDBQKCKECgQJAYBJTkgLTAbGbjvrf/7nPAgMBrCW2BLYcphgQCAYh4QGg"
+    "Ae8BDk/vp/us8d/3EgQAmjCmCKYgphimEBIJCADAAaABYJECUXGxAbPk1sjQ9tszAwGyQqYopgimFBQKBqACQGAy8wGyAZmtz+qb"
+    "lqO9AQMAwjCWEKYQphwSCQaAAUCgAZEB0QFxj+isvoXY0zoDAdonlhimBLYIEAgGgAEAQY4B7wGuAczS+O2g2I8tAwHQMKYgpgym"
+    "FBIJBoECYKEBMZABkQGVi5eK1OfeHwUA3BqmGKYQphymFKYIEgkKoAFAwAGAAQBx0QFRkQGRApH12pje29bVAQMBgiKmGLYEtgQO"
+    "BwagAQEhLcwBjQGR1eqgvKXUIAMB0iKmFKYgtigUCgaAAcEBoQKzAVMz4JGxlp/M9SUDAeQolgymILYEEAgGYMABAU6uAQ75nOj7"
+    "7KrIfgMBmCGmDLYYtiAUCgZhgQGBAtIBsgEyhYmU18nE9jIDAZYhpgimCKYcDgcGIEHAAcwBjAEN9Y/F0ebH2VIDAcImtiSWGKYQ"
+    "EgkGgQLAAWCQAtEBcbng/NSxwO2/AQUB+iOWGLYYthymCLYIDgcKoQGBAcEBAEEsTAysAa0B0N/iiJqA/wEDAcQltgyWILYMFAoG"
+    "IcEBQZICctMB6/ux3PDGnygEAYQrthi2CLYQpgwMBgihAQFhYAqLAWsq";
+constexpr size_t OPENING_BOOK_DATA_LENGTH = sizeof(OPENING_BOOK_DATA) - 1;
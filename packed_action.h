@@ -0,0 +1,148 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+// PACKED ACTION ENCODING
+// One agent command packed into a single 32-bit word, shared by c.cpp and
+// semi_ai_smitmax.cpp. Search nodes and rollouts only ever compare integers;
+// command strings are built once, by command_line, when the chosen action is
+// written to cout.
+//
+// Bit layout (LSB first):
+//   [0..3]   ActionType
+//   [4..8]   target_x + 1        MOVE destination, or THROW target
+//   [9..13]  target_y + 1
+//   [14..18] bomb_x + 1          THROW target of a MOVE_THROW
+//   [19..23] bomb_y + 1
+//   [24..31] target_agent_id + 1 SHOOT target
+// Every field is stored with a +1 bias so that 0 decodes to the -1 "unset"
+// sentinel the rest of the code already uses. 5 bits cover x/y in [-1, 30],
+// enough for the largest 20x10 league map and the 17x12 tutorial map.
+
+enum ActionType : uint8_t {
+    ACTION_HUNKER_DOWN = 0,
+    ACTION_MOVE = 1,
+    ACTION_SHOOT = 2,
+    ACTION_THROW = 3,
+    ACTION_MOVE_SHOOT = 4,
+    ACTION_MOVE_THROW = 5,
+    ACTION_MOVE_HUNKER = 6
+};
+
+inline const char* action_type_name(ActionType type) {
+    switch (type) {
+        case ACTION_MOVE: return "MOVE";
+        case ACTION_SHOOT: return "SHOOT";
+        case ACTION_THROW: return "THROW";
+        case ACTION_MOVE_SHOOT: return "MOVE_SHOOT";
+        case ACTION_MOVE_THROW: return "MOVE_THROW";
+        case ACTION_MOVE_HUNKER: return "MOVE_HUNKER";
+        default: return "HUNKER_DOWN";
+    }
+}
+
+struct PackedAction {
+    uint32_t bits = 0; // Zero is HUNKER_DOWN with every target unset
+
+    static constexpr uint32_t TYPE_SHIFT = 0, TYPE_MASK = 0xF;
+    static constexpr uint32_t TX_SHIFT = 4, TY_SHIFT = 9;
+    static constexpr uint32_t BX_SHIFT = 14, BY_SHIFT = 19;
+    static constexpr uint32_t COORD_MASK = 0x1F;
+    static constexpr uint32_t ID_SHIFT = 24, ID_MASK = 0xFF;
+
+    static constexpr uint32_t field(int value, uint32_t shift, uint32_t mask) {
+        return (uint32_t(value + 1) & mask) << shift;
+    }
+    static constexpr int unfield(uint32_t bits, uint32_t shift, uint32_t mask) {
+        return int((bits >> shift) & mask) - 1;
+    }
+
+    static constexpr PackedAction make(ActionType type, int target_x = -1, int target_y = -1,
+                                       int target_agent_id = -1, int bomb_x = -1, int bomb_y = -1) {
+        PackedAction a;
+        a.bits = (uint32_t(type) & TYPE_MASK)
+               | field(target_x, TX_SHIFT, COORD_MASK) | field(target_y, TY_SHIFT, COORD_MASK)
+               | field(bomb_x, BX_SHIFT, COORD_MASK) | field(bomb_y, BY_SHIFT, COORD_MASK)
+               | field(target_agent_id, ID_SHIFT, ID_MASK);
+        return a;
+    }
+
+    static constexpr PackedAction hunker_down() { return PackedAction(); }
+    static constexpr PackedAction move(int x, int y) { return make(ACTION_MOVE, x, y); }
+    static constexpr PackedAction shoot(int agent_id) { return make(ACTION_SHOOT, -1, -1, agent_id); }
+    static constexpr PackedAction throw_at(int x, int y) { return make(ACTION_THROW, x, y); }
+    static constexpr PackedAction move_shoot(int x, int y, int agent_id) {
+        return make(ACTION_MOVE_SHOOT, x, y, agent_id);
+    }
+    static constexpr PackedAction move_throw(int x, int y, int bomb_x, int bomb_y) {
+        return make(ACTION_MOVE_THROW, x, y, -1, bomb_x, bomb_y);
+    }
+    static constexpr PackedAction move_hunker(int x, int y) { return make(ACTION_MOVE_HUNKER, x, y); }
+
+    constexpr ActionType type() const { return ActionType((bits >> TYPE_SHIFT) & TYPE_MASK); }
+    constexpr int target_x() const { return unfield(bits, TX_SHIFT, COORD_MASK); }
+    constexpr int target_y() const { return unfield(bits, TY_SHIFT, COORD_MASK); }
+    constexpr int bomb_x() const { return unfield(bits, BX_SHIFT, COORD_MASK); }
+    constexpr int bomb_y() const { return unfield(bits, BY_SHIFT, COORD_MASK); }
+    constexpr int target_agent_id() const { return unfield(bits, ID_SHIFT, ID_MASK); }
+
+    // Same command with a different MOVE destination / THROW target
+    constexpr PackedAction with_target(int x, int y) const {
+        PackedAction a;
+        a.bits = (bits & ~((COORD_MASK << TX_SHIFT) | (COORD_MASK << TY_SHIFT)))
+               | field(x, TX_SHIFT, COORD_MASK) | field(y, TY_SHIFT, COORD_MASK);
+        return a;
+    }
+
+    constexpr bool is(ActionType t) const { return type() == t; }
+    constexpr bool has_move() const {
+        return type() == ACTION_MOVE || type() == ACTION_MOVE_SHOOT || type() == ACTION_MOVE_THROW
+            || type() == ACTION_MOVE_HUNKER;
+    }
+    constexpr bool has_hunker() const { return type() == ACTION_HUNKER_DOWN || type() == ACTION_MOVE_HUNKER; }
+
+    // The two halves of a turn's command. movement() is a MOVE, or
+    // HUNKER_DOWN for staying put; combat() is a SHOOT, a THROW, or
+    // HUNKER_DOWN, which a command without a combat action may as well send.
+    constexpr PackedAction movement() const { return has_move() ? move(target_x(), target_y()) : hunker_down(); }
+    constexpr PackedAction combat() const {
+        switch (type()) {
+            case ACTION_SHOOT:
+            case ACTION_MOVE_SHOOT: return shoot(target_agent_id());
+            case ACTION_THROW: return throw_at(target_x(), target_y());
+            case ACTION_MOVE_THROW: return throw_at(bomb_x(), bomb_y());
+            default: return hunker_down();
+        }
+    }
+    static constexpr PackedAction combine(PackedAction movement, PackedAction combat) {
+        if (!movement.has_move()) return combat;
+        int x = movement.target_x(), y = movement.target_y();
+        switch (combat.type()) {
+            case ACTION_SHOOT: return move_shoot(x, y, combat.target_agent_id());
+            case ACTION_THROW: return move_throw(x, y, combat.target_x(), combat.target_y());
+            default: return move_hunker(x, y);
+        }
+    }
+
+    constexpr bool operator==(const PackedAction& other) const { return bits == other.bits; }
+    constexpr bool operator!=(const PackedAction& other) const { return bits != other.bits; }
+};
+
+static_assert(sizeof(PackedAction) == 4, "PackedAction must fit in a 32-bit word");
+
+// One output line, "<id>;MOVE x y;SHOOT t" and the like. The referee keeps
+// a single combat action per agent, so nothing is appended to one that has it.
+inline std::string command_line(int agent_id, PackedAction a) {
+    std::string line = std::to_string(agent_id);
+    if (a.has_move()) line += ";MOVE " + std::to_string(a.target_x()) + " " + std::to_string(a.target_y());
+    PackedAction combat = a.combat();
+    if (combat.is(ACTION_SHOOT)) {
+        line += ";SHOOT " + std::to_string(combat.target_agent_id());
+    } else if (combat.is(ACTION_THROW)) {
+        line += ";THROW " + std::to_string(combat.target_x()) + " " + std::to_string(combat.target_y());
+    } else if (a.has_hunker()) {
+        line += ";HUNKER_DOWN";
+    }
+    return line;
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <thread>
+#include <vector>
+
+// ROOT PARALLEL SEARCH
+// Root parallelisation for the Smitsimax searches of c.cpp and
+// semi_ai_smitmax.cpp: every worker grows its own trees from the same root
+// state with its own RNG, sharing nothing but read-only turn data, and the
+// root children's statistics are merged once all workers hit the deadline.
+// Workers expand the root identically, so child i of a root is the same
+// action in every worker and children are merged by index.
+
+enum RootMergePolicy {
+    ROOT_MERGE_SUM,  // Pool visits and score sums: one big tree's statistics
+    ROOT_MERGE_MEAN  // Average each worker's mean score, so no single worker dominates
+};
+
+// Merged statistics of one root child across workers
+class RootChildMerge {
+public:
+    explicit RootChildMerge(RootMergePolicy policy) : policy(policy) {}
+
+    void add(int worker_visits, double worker_score_sum) {
+        visits += worker_visits;
+        score_sum += worker_score_sum;
+        if (worker_visits > 0) {
+            mean_sum += worker_score_sum / worker_visits;
+            voters++;
+        }
+    }
+
+    int merged_visits() const { return visits; }
+    double merged_score_sum() const {
+        if (policy == ROOT_MERGE_MEAN && voters > 0) return mean_sum / voters * visits;
+        return score_sum;
+    }
+
+private:
+    RootMergePolicy policy;
+    int visits = 0;
+    double score_sum = 0;
+    double mean_sum = 0;
+    int voters = 0;
+};
+
+// Runs job(worker) for every worker: worker 0 on the calling thread, the
+// others on their own threads, returning once all of them are done
+template <typename Job>
+void run_root_workers(int workers, Job job) {
+    std::vector<std::thread> threads;
+    for (int w = 1; w < workers; w++) threads.emplace_back(job, w);
+    job(0);
+    for (std::thread& t : threads) t.join();
+}
@@ -0,0 +1,601 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <type_traits>
+#include "packed_action.h"
+#include "bitboard.h"
+#include "zone_kernel.h"
+#include "zobrist.h"
+
+// RULES ENGINE
+// One turn of the referee as game/Game.java plays it: resetGameTurnData, then
+// performGameUpdate (doMoves, doHunkers, doShoots, doThrows, doDeaths,
+// updateControlZones, scorePoints). Shared by c.cpp and semi_ai_smitmax.cpp so
+// both searches roll out the real rules instead of their own approximations.
+//
+// Agents live in dense slots: team 0 occupies [0, my_count), team 1
+// [my_count, count). The referee's per-agent phases are independent of agent
+// order, so any slot order gives the referee's result. An agent with wetness
+// >= 100 has been removed by the referee and is ignored everywhere.
+//
+// RulesState is what the bots read each turn: cooldowns already ticked by
+// Agent.reset(), no hunker flags, no dying agents. step() plays one turn from
+// there and ends at the next turn's input, so states chain directly.
+//
+// hash is the state's Zobrist key (zobrist.h). step() keeps it current with
+// an XOR pair per changed field; whoever fills a state by hand calls rehash().
+
+const int RULES_MAX_AGENTS = 10;        // GridMaker.MAX_SPAWN_COUNT per player x 2
+const int RULES_THROW_DAMAGE = 30;      // Game.THROW_DAMAGE
+const int RULES_THROW_DISTANCE_MAX = 4; // Game.THROW_DISTANCE_MAX
+const int RULES_MAX_POINT_DIFF = 600;   // Game.MAX_POINT_DIFF
+const int RULES_MAX_TURNS = 100;        // Referee: setMaxTurns(100)
+
+// Mutable per-agent data as parallel arrays. Small and trivially copyable, so
+// restoring a position is a single memcpy.
+struct RulesState {
+    uint8_t count;
+    uint8_t my_count;
+    int8_t x[RULES_MAX_AGENTS];
+    int8_t y[RULES_MAX_AGENTS];
+    uint8_t cooldown[RULES_MAX_AGENTS];
+    uint8_t splash_bombs[RULES_MAX_AGENTS];
+    int16_t wetness[RULES_MAX_AGENTS];
+    int points[2];                      // Player points, team 0 first
+    uint64_t hash;                      // Zobrist key of the per-slot fields above
+
+    void rehash() {
+        const ZobristKeys& keys = zobrist_keys();
+        hash = 0;
+        for (int s = 0; s < count; s++) {
+            hash ^= keys.at(s, x[s], y[s]) ^ keys.wet(s, wetness[s]) ^ keys.cool(s, cooldown[s])
+                  ^ keys.bombs(s, splash_bombs[s]);
+        }
+    }
+
+    bool is_mine(int slot) const { return slot < my_count; }
+    bool is_alive(int slot) const { return wetness[slot] < 100; }
+
+    // Slot ranges of the acting agent's own side and of the opposing side
+    int allies_begin(int slot) const { return is_mine(slot) ? 0 : my_count; }
+    int allies_end(int slot) const { return is_mine(slot) ? my_count : count; }
+    int enemies_begin(int slot) const { return is_mine(slot) ? my_count : 0; }
+    int enemies_end(int slot) const { return is_mine(slot) ? count : my_count; }
+
+    int live_count(int team) const {
+        int live = 0;
+        for (int s = team == 0 ? 0 : my_count; s < (team == 0 ? my_count : count); s++) live += is_alive(s);
+        return live;
+    }
+};
+
+static_assert(std::is_trivially_copyable<RulesState>::value, "RulesState is copied with memcpy");
+static_assert(RULES_MAX_AGENTS <= ZOBRIST_MAX_SLOTS, "every slot needs Zobrist keys");
+
+// Game.getCoverModifier for every (shooter tile, target tile) pair of one
+// map, in quarters: 4 in the open, 2 behind low cover, 1 behind high cover.
+// The map never changes after init, so the table is built once and a shot's
+// cover is a single load. Rows are MAX_TILES long: 64 KB.
+struct CoverTable {
+    static const int MAX_TILES = BoardGeometry::MAX_TILES;
+
+    uint8_t quarters[MAX_TILES * MAX_TILES];
+
+    double modifier(int shooter_tile, int target_tile) const {
+        return quarters[shooter_tile * MAX_TILES + target_tile] * 0.25;
+    }
+
+    // Best cover next to the target on each axis the shot comes from,
+    // ignoring cover the shooter stands next to
+    void build(const BoardLayers& board) {
+        const BoardGeometry& geo = board.geo;
+        int tiles = std::min(geo.width * geo.height, (int)MAX_TILES);
+        for (int shooter = 0; shooter < tiles; shooter++) {
+            int sx = geo.x_of(shooter), sy = geo.y_of(shooter);
+            for (int target = 0; target < tiles; target++) {
+                int tx = geo.x_of(target), ty = geo.y_of(target);
+                int dx = tx - sx, dy = ty - sy;
+                int best = 4;
+                if (std::abs(dx) > 1) best = std::min(best, cover_from(board, sx, sy, tx - (dx > 0 ? 1 : -1), ty));
+                if (std::abs(dy) > 1) best = std::min(best, cover_from(board, sx, sy, tx, ty - (dy > 0 ? 1 : -1)));
+                quarters[shooter * MAX_TILES + target] = (uint8_t)best;
+            }
+        }
+    }
+
+private:
+    // Tile.getCoverModifier of (x, y) unless the shooter is next to it;
+    // off-map tiles are Tile.NO_TILE and give no cover
+    static int cover_from(const BoardLayers& board, int sx, int sy, int x, int y) {
+        if (std::max(std::abs(x - sx), std::abs(y - sy)) <= 1 || !board.geo.contains(x, y)) return 4;
+        int i = board.geo.index(x, y);
+        if (board.low_cover.test(i)) return 2;
+        if (board.high_cover.test(i)) return 1;
+        return 4;
+    }
+};
+
+// Steps of the shortest walk between two tiles over floor only, the way
+// AStar routes around cover; UNREACHABLE when either end is cover or no walk
+// exists. Agents in the way are ignored, so this is the map's distance, not a
+// path for this turn. One BFS per floor tile at init, a level per dilate4 of
+// the frontier. Rows are MAX_TILES long, like CoverTable: 64 KB.
+struct DistanceTable {
+    static const int MAX_TILES = BoardGeometry::MAX_TILES;
+    static const int UNREACHABLE = 255;
+
+    uint8_t walk[MAX_TILES * MAX_TILES];
+
+    int steps(int from_tile, int to_tile) const { return walk[from_tile * MAX_TILES + to_tile]; }
+
+    void build(const BoardLayers& board) {
+        const BoardGeometry& geo = board.geo;
+        std::fill(walk, walk + MAX_TILES * MAX_TILES, (uint8_t)UNREACHABLE);
+        board.floor.for_each([&](int from) {
+            uint8_t* row = walk + from * MAX_TILES;
+            Bitboard reached = geo.bit(geo.x_of(from), geo.y_of(from));
+            Bitboard frontier = reached;
+            for (int level = 0; frontier.any(); level++) {
+                frontier.for_each([&](int tile) { row[tile] = (uint8_t)level; });
+                frontier = geo.dilate4(frontier).minus(reached) & board.floor;
+                reached |= frontier;
+            }
+        });
+    }
+};
+
+// Per-slot data and map that never change during a game. Whoever sets the
+// tiles of board by hand calls build_map_tables() afterwards.
+struct RulesTable {
+    int agent_id[RULES_MAX_AGENTS];
+    int shoot_cooldown[RULES_MAX_AGENTS];
+    int optimal_range[RULES_MAX_AGENTS];
+    int soaking_power[RULES_MAX_AGENTS];
+    BoardLayers board;
+    ZoneGrid zone_grid;
+    CoverTable cover;
+    DistanceTable distance;
+
+    void init_map(int width, int height) {
+        board.init(width, height);
+        zone_grid.init(width, height);
+    }
+
+    // Lookups derived from the tiles
+    void build_map_tables() {
+        cover.build(board);
+        distance.build(board);
+    }
+
+    // A whole map at once; the lookups are only rebuilt for a new map
+    void set_board(const BoardLayers& layers) {
+        bool same = board.geo.width == layers.geo.width && board.geo.height == layers.geo.height
+                 && board.floor == layers.floor && board.low_cover == layers.low_cover
+                 && board.high_cover == layers.high_cover;
+        board = layers;
+        zone_grid.init(layers.geo.width, layers.geo.height);
+        if (!same) build_map_tables();
+    }
+
+    int slot_of(const RulesState& state, int id) const {
+        for (int s = 0; s < state.count; s++) {
+            if (agent_id[s] == id) return s;
+        }
+        return -1;
+    }
+
+    // Folds the slot-to-agent assignment into a state hash, so keys from
+    // different agent line-ups (one agent fewer, slots shifted) never meet
+    uint64_t line_up_salt(int count) const {
+        const ZobristKeys& keys = zobrist_keys();
+        uint64_t salt = 0;
+        for (int s = 0; s < count; s++) salt ^= keys.agent_id[s][agent_id[s] & 255];
+        return salt;
+    }
+};
+
+// PathFinder.findPath / AStar.find with the exact tie-breaking of the Java
+// code: java.util.PriorityQueue's sift order, neighbours in N/E/S/W order
+// stably sorted by (restricted, farthest from centre first), and getNearest()
+// when the target cannot be reached. Only the first step of the path is
+// returned since that is all Game.doMoves uses.
+//
+// Every A* run from the same start explores identically until it stops, and
+// the path to a coord is always through the item that first closed it. So the
+// fallback run towards the nearest coord is read from the first run's closed
+// items instead of being searched again.
+//
+// The step depends only on the map, the start, the target and the restricted
+// tiles, and rollouts ask the same question over and over (every rollout
+// replays the root turn's occupancy), so answers are kept in a direct-mapped
+// cache keyed by all four; a different map empties it. A target next to the
+// start needs no search: the start's own neighbours are the first items of
+// cost 1 and the target is one of them.
+class RulesPathfinder {
+public:
+    static const int MAX_TILES = BoardGeometry::MAX_TILES;
+    static const int MAX_ITEMS = 4 * MAX_TILES + 1;
+    static const int CACHE_ENTRIES = 1024;
+
+    // Tile index of the first step from `from` towards `target`, or -1 when the
+    // agent does not move. `restricted` holds the tiles occupied at turn start.
+    int next_step(const BoardLayers& board, int from, int target_x, int target_y, const Bitboard& restricted) {
+        const BoardGeometry& geo = board.geo;
+        int distance = std::abs(geo.x_of(from) - target_x) + std::abs(geo.y_of(from) - target_y);
+        if (distance == 0) return -1;
+        if (distance == 1 && geo.contains(target_x, target_y) && board.floor.test(geo.index(target_x, target_y))) {
+            return geo.index(target_x, target_y);
+        }
+
+        if (!(board.floor == cached_floor) || geo.width != cached_width || geo.height != cached_height) {
+            for (CachedStep& entry : cache) entry.from = -1;
+            cached_floor = board.floor;
+            cached_width = geo.width;
+            cached_height = geo.height;
+        }
+        CachedStep& entry = cache[cache_index(from, target_x, target_y, restricted)];
+        if (entry.from == from && entry.target_x == target_x && entry.target_y == target_y
+            && entry.restricted == restricted) {
+            return entry.step;
+        }
+        int step = search(board, from, target_x, target_y, restricted);
+        entry.restricted = restricted;
+        entry.from = (int16_t)from;
+        entry.target_x = (int16_t)target_x;
+        entry.target_y = (int16_t)target_y;
+        entry.step = (int16_t)step;
+        return step;
+    }
+
+private:
+    struct CachedStep {
+        Bitboard restricted;
+        int16_t from = -1;     // -1 for an empty entry
+        int16_t target_x, target_y;
+        int16_t step;
+    };
+
+    CachedStep cache[CACHE_ENTRIES];
+    Bitboard cached_floor;
+    int cached_width = 0, cached_height = 0;
+
+    static int cache_index(int from, int target_x, int target_y, const Bitboard& restricted) {
+        uint64_t h = restricted.w[0] * 0x9E3779B97F4A7C15ULL ^ restricted.w[1] * 0xC2B2AE3D27D4EB4FULL
+                   ^ restricted.w[2] * 0x165667B19E3779F9ULL ^ restricted.w[3] * 0xD6E8FEB86659FD93ULL
+                   ^ (uint64_t)((from << 16) | ((target_y & 0xFF) << 8) | (target_x & 0xFF)) * 0xFF51AFD7ED558CCDULL;
+        return (int)(h >> 54) & (CACHE_ENTRIES - 1);
+    }
+
+    // The A* run itself
+    int search(const BoardLayers& board, int from, int target_x, int target_y, const Bitboard& restricted) {
+        const BoardGeometry& geo = board.geo;
+        for (int t = 0; t < geo.width * geo.height && t < MAX_TILES; t++) closed[t] = -1;
+        item_count = 0;
+        heap_size = 0;
+
+        push(from, -1, 0);
+        int nearest = from;
+        int found = -1;
+        while (heap_size > 0) {
+            int visiting = pop();
+            int tile = items[visiting].tile;
+            int vx = geo.x_of(tile), vy = geo.y_of(tile);
+            if (vx == target_x && vy == target_y) {
+                found = visiting;
+                break;
+            }
+            if (closed[tile] >= 0) continue;
+            closed[tile] = visiting;
+
+            int neighbours[4], n = 0;
+            static const int DX[4] = {0, 1, 0, -1}, DY[4] = {-1, 0, 1, 0};
+            for (int d = 0; d < 4; d++) {
+                int nx = vx + DX[d], ny = vy + DY[d];
+                if (geo.contains(nx, ny)) neighbours[n++] = geo.index(nx, ny);
+            }
+            // Insertion sort is stable, like Collections.sort
+            for (int i = 1; i < n; i++) {
+                int moving = neighbours[i], j = i;
+                while (j > 0 && neighbour_before(geo, restricted, moving, neighbours[j - 1])) {
+                    neighbours[j] = neighbours[j - 1];
+                    j--;
+                }
+                neighbours[j] = moving;
+            }
+            for (int i = 0; i < n; i++) {
+                int next = neighbours[i];
+                if (board.floor.test(next) && closed[next] < 0) push(next, visiting, items[visiting].cumulative + 1);
+            }
+
+            int visiting_dist = std::abs(vx - target_x) + std::abs(vy - target_y);
+            int nearest_dist = std::abs(geo.x_of(nearest) - target_x) + std::abs(geo.y_of(nearest) - target_y);
+            if (visiting_dist < nearest_dist
+                || (visiting_dist == nearest_dist && centre_distance(geo, tile) > centre_distance(geo, nearest))) {
+                nearest = tile;
+            }
+        }
+
+        int end = found >= 0 ? found : closed[nearest];
+        if (end < 0 || items[end].precedent < 0) return -1;
+        while (items[items[end].precedent].precedent >= 0) end = items[end].precedent;
+        return items[end].tile;
+    }
+
+    struct Item {
+        int16_t tile;
+        int16_t precedent;     // Item index, -1 for the start
+        int cumulative;        // PathItem.cumulativeLength; the A* key adds 1 per step
+    };
+
+    Item items[MAX_ITEMS];
+    int item_count = 0;
+    int heap[MAX_ITEMS];
+    int heap_size = 0;
+    int closed[MAX_TILES];     // Item that closed each tile, -1 while open
+
+    // PathItem.totalPrevisionalLength: cumulative length plus the one-step
+    // manhattan of the edge that created the item
+    int key(int item) const { return items[item].precedent < 0 ? 0 : items[item].cumulative + 1; }
+
+    // 4 * squared euclidean distance to (width / 2, height / 2), exact in integers
+    static int centre_distance(const BoardGeometry& geo, int tile) {
+        int dx = 2 * geo.x_of(tile) - geo.width, dy = 2 * geo.y_of(tile) - geo.height;
+        return dx * dx + dy * dy;
+    }
+
+    static bool neighbour_before(const BoardGeometry& geo, const Bitboard& restricted, int a, int b) {
+        int ra = restricted.test(a), rb = restricted.test(b);
+        if (ra != rb) return ra < rb;
+        return centre_distance(geo, a) > centre_distance(geo, b);
+    }
+
+    // PriorityQueue.offer / siftUpUsingComparator
+    void push(int tile, int precedent, int cumulative) {
+        int item = item_count++;
+        items[item].tile = (int16_t)tile;
+        items[item].precedent = (int16_t)precedent;
+        items[item].cumulative = cumulative;
+        int k = heap_size++;
+        while (k > 0) {
+            int parent = (k - 1) >> 1;
+            if (key(item) >= key(heap[parent])) break;
+            heap[k] = heap[parent];
+            k = parent;
+        }
+        heap[k] = item;
+    }
+
+    // PriorityQueue.poll / siftDownUsingComparator
+    int pop() {
+        int result = heap[0];
+        int n = --heap_size;
+        int x = heap[n];
+        if (n > 0) {
+            int k = 0, half = n >> 1;
+            while (k < half) {
+                int child = (k << 1) + 1, right = child + 1;
+                if (right < n && key(heap[child]) > key(heap[right])) child = right;
+                if (key(x) <= key(heap[child])) break;
+                heap[k] = heap[child];
+                k = child;
+            }
+            heap[k] = x;
+        }
+        return result;
+    }
+};
+
+class RulesEngine {
+public:
+    // Plays one turn: orders[slot] is the command of each slot (MOVE and/or one
+    // combat action; HUNKER_DOWN when the agent has nothing else to do, or a
+    // MOVE onto its own tile for an agent that sent no command at all)
+    void step(const RulesTable& table, RulesState& state, const PackedAction* orders) {
+        // Game.isCinematicFrame: once a team is wiped out nothing happens
+        if (state.live_count(0) > 0 && state.live_count(1) > 0) {
+            // Agents soaked this turn keep acting and being hit until doDeaths
+            bool present[RULES_MAX_AGENTS], hunkered[RULES_MAX_AGENTS];
+            for (int s = 0; s < state.count; s++) {
+                present[s] = state.is_alive(s);
+                hunkered[s] = present[s] && orders[s].has_hunker();
+            }
+            do_moves(table, state, orders, present);
+            do_shoots(table, state, orders, present, hunkered);
+            do_throws(table, state, orders, present);
+            score_points(table, state);
+        }
+        // Next turn's resetGameTurnData: dying agents leave, cooldowns tick
+        for (int s = 0; s < state.count; s++) {
+            if (state.cooldown[s] > 0) set_cooldown(state, s, state.cooldown[s] - 1);
+        }
+    }
+
+    // Game.isGameOver for the league game, plus the referee's turn limit
+    static bool game_over(const RulesState& state, int turn) {
+        return turn >= RULES_MAX_TURNS
+            || state.points[0] > state.points[1] + RULES_MAX_POINT_DIFF
+            || state.points[1] > state.points[0] + RULES_MAX_POINT_DIFF
+            || state.live_count(0) == 0 || state.live_count(1) == 0;
+    }
+
+    // Game.updateControlZones tile counts, team 0 first
+    static void control_zones(const RulesTable& table, const RulesState& state, int owned[2]) {
+        count_control_zones(table.zone_grid, state.count, state.my_count, state.x, state.y, state.wetness, owned);
+    }
+
+    // Game.getCoverModifier, from the table's CoverTable
+    static double cover_modifier(const RulesTable& table, int shooter_x, int shooter_y, int target_x, int target_y) {
+        const BoardGeometry& geo = table.board.geo;
+        return table.cover.modifier(geo.index(shooter_x, shooter_y), geo.index(target_x, target_y));
+    }
+
+    // Game.doShoots damage: round(soakingPower * rangeModifier * (cover - hunker bonus))
+    static int shooting_damage(const RulesTable& table, const RulesState& state, int shooter, int target, bool hunkered) {
+        int distance = std::abs(state.x[target] - state.x[shooter]) + std::abs(state.y[target] - state.y[shooter]);
+        double range_modifier = distance <= table.optimal_range[shooter] ? 1
+                              : (distance <= table.optimal_range[shooter] * 2 ? 0.5 : 0);
+        if (range_modifier == 0) return 0;
+        double cover = cover_modifier(table, state.x[shooter], state.y[shooter], state.x[target], state.y[target]);
+        double hunker_bonus = hunkered ? 0.25 : 0;
+        return (int)std::floor(table.soaking_power[shooter] * range_modifier * (cover - hunker_bonus) + 0.5);
+    }
+
+    // Where a MOVE to (target_x, target_y) takes slot s this turn unless a
+    // collision cancels it: the first step of AStar's path, or its own tile
+    int move_step(const RulesTable& table, const RulesState& state, int s, int target_x, int target_y) {
+        const BoardGeometry& geo = table.board.geo;
+        Bitboard occupied;
+        for (int o = 0; o < state.count; o++) {
+            if (state.is_alive(o)) occupied.set(geo.index(state.x[o], state.y[o]));
+        }
+        int from = geo.index(state.x[s], state.y[s]);
+        int to = pathfinder.next_step(table.board, from, target_x, target_y, occupied);
+        return to >= 0 ? to : from;
+    }
+
+    // Game.doMoves without moving anyone: to[s] is the tile present agent s
+    // ends the move phase on, its own when it stays or its move is cancelled.
+    // Steps into a static agent, onto the same tile or swapping places are
+    // cancelled, then every step into a cancelled mover's tile, until nothing
+    // changes; fixed arrays only, no allocation.
+    void resolve_moves(const RulesTable& table, const RulesState& state, const PackedAction* orders, const bool* present,
+                       int* to) {
+        const BoardGeometry& geo = table.board.geo;
+        Bitboard occupied;
+        for (int s = 0; s < state.count; s++) {
+            if (present[s]) occupied.set(geo.index(state.x[s], state.y[s]));
+        }
+
+        int from[RULES_MAX_AGENTS];
+        bool moving[RULES_MAX_AGENTS];
+        Bitboard static_tiles;
+        for (int s = 0; s < state.count; s++) {
+            moving[s] = false;
+            if (!present[s]) continue;
+            from[s] = geo.index(state.x[s], state.y[s]);
+            if (orders[s].has_move()) {
+                to[s] = pathfinder.next_step(table.board, from[s], orders[s].target_x(), orders[s].target_y(), occupied);
+                moving[s] = to[s] >= 0;
+            }
+            if (!moving[s]) static_tiles.set(from[s]);
+        }
+
+        bool cancelled[RULES_MAX_AGENTS] = {}, blocked[RULES_MAX_AGENTS] = {};
+        for (int s = 0; s < state.count; s++) {
+            if (moving[s] && static_tiles.test(to[s])) blocked[s] = cancelled[s] = true;
+        }
+        for (int m = 0; m < state.count; m++) {
+            if (!moving[m] || blocked[m]) continue;
+            for (int o = 0; o < state.count; o++) {
+                if (o == m || !moving[o] || blocked[o]) continue;
+                if (to[o] == to[m] || (to[o] == from[m] && to[m] == from[o])) cancelled[o] = true;
+            }
+        }
+        for (bool changed = true; changed;) {
+            changed = false;
+            for (int c = 0; c < state.count; c++) {
+                if (!moving[c] || !cancelled[c]) continue;
+                for (int o = 0; o < state.count; o++) {
+                    if (moving[o] && !cancelled[o] && to[o] == from[c]) {
+                        cancelled[o] = true;
+                        changed = true;
+                    }
+                }
+            }
+        }
+
+        for (int s = 0; s < state.count; s++) {
+            if (present[s] && (!moving[s] || cancelled[s])) to[s] = from[s];
+        }
+    }
+
+private:
+    RulesPathfinder pathfinder;
+    const ZobristKeys& keys = zobrist_keys();
+
+    // Field writes that keep state.hash current
+    void set_position(RulesState& state, int s, int x, int y) {
+        state.hash ^= keys.at(s, state.x[s], state.y[s]) ^ keys.at(s, x, y);
+        state.x[s] = (int8_t)x;
+        state.y[s] = (int8_t)y;
+    }
+    void add_wetness(RulesState& state, int s, int amount) {
+        int wetness = state.wetness[s] + amount;
+        state.hash ^= keys.wet(s, state.wetness[s]) ^ keys.wet(s, wetness);
+        state.wetness[s] = (int16_t)wetness;
+    }
+    void set_cooldown(RulesState& state, int s, int cooldown) {
+        state.hash ^= keys.cool(s, state.cooldown[s]) ^ keys.cool(s, cooldown);
+        state.cooldown[s] = (uint8_t)cooldown;
+    }
+    void set_balloons(RulesState& state, int s, int balloons) {
+        state.hash ^= keys.bombs(s, state.splash_bombs[s]) ^ keys.bombs(s, balloons);
+        state.splash_bombs[s] = (uint8_t)balloons;
+    }
+
+    void do_moves(const RulesTable& table, RulesState& state, const PackedAction* orders, const bool* present) {
+        const BoardGeometry& geo = table.board.geo;
+        int to[RULES_MAX_AGENTS];
+        resolve_moves(table, state, orders, present, to);
+        for (int s = 0; s < state.count; s++) {
+            if (present[s] && to[s] != geo.index(state.x[s], state.y[s])) set_position(state, s, geo.x_of(to[s]), geo.y_of(to[s]));
+        }
+    }
+
+    void do_shoots(const RulesTable& table, RulesState& state, const PackedAction* orders, const bool* present,
+                   const bool* hunkered) {
+        for (int s = 0; s < state.count; s++) {
+            if (!present[s]) continue;
+            if (!orders[s].is(ACTION_SHOOT) && !orders[s].is(ACTION_MOVE_SHOOT)) continue;
+            if (state.cooldown[s] > 0) continue;
+            int target = table.slot_of(state, orders[s].target_agent_id());
+            if (target < 0 || target == s || !present[target]) continue;
+            int distance = std::abs(state.x[target] - state.x[s]) + std::abs(state.y[target] - state.y[s]);
+            if (distance > table.optimal_range[s] * 2) continue;
+
+            add_wetness(state, target, shooting_damage(table, state, s, target, hunkered[target]));
+            set_cooldown(state, s, table.shoot_cooldown[s] + 1);
+        }
+    }
+
+    void do_throws(const RulesTable& table, RulesState& state, const PackedAction* orders, const bool* present) {
+        const BoardGeometry& geo = table.board.geo;
+        for (int s = 0; s < state.count; s++) {
+            if (!present[s]) continue;
+            int tx, ty;
+            if (orders[s].is(ACTION_THROW)) {
+                tx = orders[s].target_x();
+                ty = orders[s].target_y();
+            } else if (orders[s].is(ACTION_MOVE_THROW)) {
+                tx = orders[s].bomb_x();
+                ty = orders[s].bomb_y();
+            } else {
+                continue;
+            }
+            if (!geo.contains(tx, ty)) continue;
+            if (std::abs(tx - state.x[s]) + std::abs(ty - state.y[s]) > RULES_THROW_DISTANCE_MAX) continue;
+            if (state.splash_bombs[s] == 0) continue;
+
+            // The target tile and its 8 neighbours, friend or foe
+            for (int o = 0; o < state.count; o++) {
+                if (present[o] && std::abs(state.x[o] - tx) <= 1 && std::abs(state.y[o] - ty) <= 1) {
+                    add_wetness(state, o, RULES_THROW_DAMAGE);
+                }
+            }
+            set_balloons(state, s, state.splash_bombs[s] - 1);
+        }
+    }
+
+    // doDeaths is implicit (wetness >= 100 is dead), so only the zones remain
+    void score_points(const RulesTable& table, RulesState& state) {
+        int owned[2];
+        control_zones(table, state, owned);
+        for (int team = 0; team < 2; team++) {
+            int diff = owned[team] - owned[1 - team];
+            if (diff > 0) state.points[team] += diff;
+        }
+    }
+};
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// SCENARIO INDEX
+// The k nearest of a fixed set of points to a query, by squared Euclidean
+// distance over small integer feature vectors. Only points of the query's
+// group compete (for scenarios: the same map size and line-up, so every
+// dimension means the same thing). Each group is a k-d tree, built once by
+// median splits on the dimension of widest spread and stored implicitly in
+// a permuted array: the node of range [lo, hi) is its median element. A query
+// descends into the query's side first and crosses a split only while the
+// plane is nearer than the k-th best so far.
+
+template <int DIMENSIONS>
+class ScenarioIndex {
+public:
+    struct Match {
+        int id;
+        int distance;  // Squared
+    };
+
+    // Before build()
+    void add(uint64_t group, const int16_t* features, int id) {
+        Group& g = groups[group];
+        Point point;
+        std::copy(features, features + DIMENSIONS, point.features);
+        point.id = id;
+        g.points.push_back(point);
+    }
+
+    void build() {
+        for (auto& entry : groups) {
+            Group& g = entry.second;
+            g.split.assign(g.points.size(), 0);
+            build(g, 0, (int)g.points.size());
+        }
+    }
+
+    void clear() { groups.clear(); }
+    size_t size() const {
+        size_t n = 0;
+        for (const auto& entry : groups) n += entry.second.points.size();
+        return n;
+    }
+
+    // Up to k matches into out, nearest first; returns how many
+    int nearest(uint64_t group, const int16_t* query, int k, Match* out) const {
+        auto it = groups.find(group);
+        if (it == groups.end() || k <= 0) return 0;
+        int found = 0;
+        search(it->second, 0, (int)it->second.points.size(), query, k, out, found);
+        return found;
+    }
+
+private:
+    struct Point {
+        int16_t features[DIMENSIONS];
+        int id;
+    };
+
+    struct Group {
+        std::vector<Point> points;
+        std::vector<uint8_t> split;  // Split dimension of the node at each median
+    };
+
+    std::unordered_map<uint64_t, Group> groups;
+
+    static void build(Group& g, int lo, int hi) {
+        if (hi - lo <= 1) return;
+        int dimension = 0, widest = -1;
+        for (int d = 0; d < DIMENSIONS; d++) {
+            int low = g.points[lo].features[d], high = low;
+            for (int i = lo + 1; i < hi; i++) {
+                low = std::min<int>(low, g.points[i].features[d]);
+                high = std::max<int>(high, g.points[i].features[d]);
+            }
+            if (high - low > widest) {
+                widest = high - low;
+                dimension = d;
+            }
+        }
+        int mid = (lo + hi) / 2;
+        std::nth_element(g.points.begin() + lo, g.points.begin() + mid, g.points.begin() + hi,
+                         [dimension](const Point& a, const Point& b) { return a.features[dimension] < b.features[dimension]; });
+        g.split[mid] = (uint8_t)dimension;
+        build(g, lo, mid);
+        build(g, mid + 1, hi);
+    }
+
+    static int distance(const Point& point, const int16_t* query) {
+        int sum = 0;
+        for (int d = 0; d < DIMENSIONS; d++) {
+            int delta = point.features[d] - query[d];
+            sum += delta * delta;
+        }
+        return sum;
+    }
+
+    // Keeps out[0..found) sorted, at most k long
+    static void offer(Match* out, int& found, int k, int id, int dist) {
+        if (found == k && dist >= out[k - 1].distance) return;
+        int i = found < k ? found++ : k - 1;
+        for (; i > 0 && out[i - 1].distance > dist; i--) out[i] = out[i - 1];
+        out[i] = {id, dist};
+    }
+
+    static void search(const Group& g, int lo, int hi, const int16_t* query, int k, Match* out, int& found) {
+        if (lo >= hi) return;
+        int mid = (lo + hi) / 2;
+        const Point& point = g.points[mid];
+        offer(out, found, k, point.id, distance(point, query));
+        if (hi - lo == 1) return;
+
+        int dimension = g.split[mid];
+        int delta = query[dimension] - point.features[dimension];
+        bool left_first = delta < 0;
+        search(g, left_first ? lo : mid + 1, left_first ? mid : hi, query, k, out, found);
+        if (found < k || delta * delta < out[found - 1].distance) {
+            search(g, left_first ? mid + 1 : lo, left_first ? hi : mid, query, k, out, found);
+        }
+    }
+};
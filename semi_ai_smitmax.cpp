@@ -9,16 +9,46 @@
 #include <queue>
 #include <random>
 #include <unordered_map>
+#include <cstring>
+#include <type_traits>
+#include <cstdlib>
+#include <memory>
+#include <atomic>
+#include "packed_action.h"
+#include "node_arena.h"
+#include "bitboard.h"
+#include "rules_engine.h"
+#include "root_parallel.h"
+#include "tree_parallel.h"
+#include "time_manager.h"
+#include "opening_book.h"
+#ifndef SUBMISSION
+#include "opening_book_data.h"
+#endif
 using namespace std;
 
 // MERGED SMITSIMAX + TACTICAL AI
 // Combines multi-tree UCB search with comprehensive tactical evaluation
 // Priority scoring system (-1.0 to 1.0) with agent class strategies
+//
+// Every turn runs the tree search (search_original) until the TimeManager's
+// deadline. The opening book is for local runs only: it is read from a file,
+// and the packed copy in opening_book_data.h sits in #ifndef SUBMISSION
+// blocks, which tools/bundle.cpp leaves out of the submitted file.
 
 const int MAX_SEARCH_DEPTH = 6; // Balanced for performance
+const int TREE_LEVELS_PER_TURN = 2; // Movement node, then combat node
 const double EXPLORATION_PARAM = 1.4; // UCB exploration parameter
 const int MIN_RANDOM_VISITS = 8; // Random selection for first N visits
-const int MAX_SIMULATION_TIME = 85; // milliseconds - leave buffer for tactical evaluation
+const int WIDENING_MIN_CHILDREN = 6; // Progressive widening: children offered at 0 visits, plus sqrt(visits)
+const int NODE_ARENA_CAPACITY = 1 << 20; // 32 MB of nodes, allocated once per search object
+const int MAX_AGENTS = 10; // GridMaker.MAX_SPAWN_COUNT (5) per player x 2
+const int MAX_WORKER_ITERATIONS = 10000; // Per worker tree; bounds arena use
+const double VIRTUAL_LOSS = 100.0; // One agent down in evaluate_enhanced_game_state
+const int EXPANSION_SCRATCH_CAPACITY = 64; // More than create_tactical_moves makes for one node
+const int MAX_REPLAY_COMBINATIONS = 256; // Enemy order guesses tried when matching last turn for tree reuse
+const int BOOK_PRIOR_NEIGHBOURS = 4; // Nearest opening book positions that vote on root move ordering
+const double BOOK_PRIOR_WEIGHT = 0.5; // Tactical priority added to a unanimous neighbour vote
 
 // Agent class types from game
 enum AgentClass {
@@ -52,46 +82,86 @@ struct AgentState {
     AgentState& operator=(const AgentState& other) = default;
 };
 
+// Rollout data is indexed by dense agent slot: my agents occupy [0, my_count),
+// enemies [my_count, count), in turn-input order. Rollouts play whole turns on
+// the shared rules engine, so the slot tables are the engine's.
+// Per-agent data that never changes during a turn - filled once in initialize()
+struct AgentTable : RulesTable {
+    AgentClass agent_class[MAX_AGENTS];
+    int width, height;
+    // Opening book neighbours' choice for each of my agents, added to that
+    // root child's tactical priority; zero when no book is loaded
+    PackedAction prior_action[MAX_AGENTS];
+    float prior_bonus[MAX_AGENTS];
+};
+
+// Mutable per-agent data; restoring the root position before a rollout is a memcpy
+typedef RulesState RolloutState;
+
+RolloutState make_rollout_state(const vector<AgentState>& my_agents, const vector<AgentState>& enemy_agents) {
+    RolloutState state;
+    state.count = 0;
+    state.points[0] = state.points[1] = 0;
+    for (int side = 0; side < 2; side++) {
+        const vector<AgentState>& agents = side == 0 ? my_agents : enemy_agents;
+        for (const auto& agent : agents) {
+            if (state.count >= MAX_AGENTS) break;
+            int slot = state.count++;
+            state.x[slot] = (int8_t)agent.x;
+            state.y[slot] = (int8_t)agent.y;
+            state.cooldown[slot] = (uint8_t)agent.cooldown;
+            state.splash_bombs[slot] = (uint8_t)agent.splash_bombs;
+            state.wetness[slot] = (int16_t)agent.wetness;
+        }
+        if (side == 0) state.my_count = state.count;
+    }
+    state.rehash();
+    return state;
+}
+
 struct TacticalAction {
-    string type;
-    int target_id = -1;
-    int target_x = -1;
-    int target_y = -1;
+    PackedAction action;
     double priority_score = 0.0; // -1.0 to 1.0 range
-    string reasoning = "";
+    const char* reasoning = "";
 };
 
 // Smitsimax Node - represents a move choice in the agent's tree
+// Lives in a NodeArena: parent and children are arena indices, and the
+// children of a node occupy [first_child, first_child + child_count).
 struct SmitsimaxNode {
-    SmitsimaxNode* parent;
-    vector<SmitsimaxNode*> children;
-    
-    double total_score;
+    int parent;
+    int first_child;
     int visits;
+    uint16_t child_count;
     
-    // Move data (what this node represents)
-    string action_type; // "SHOOT", "MOVE", "THROW", "HUNKER_DOWN"
-    int target_x, target_y;
-    int target_agent_id;
+    // Move data (what this node represents): a MOVE or HUNKER_DOWN on a
+    // turn's movement level, the whole compound order on its combat level
+    PackedAction action;
     
     // Tactical evaluation data
-    double tactical_priority;
+    float tactical_priority;
     
-    SmitsimaxNode() : parent(nullptr), total_score(0.0), visits(0), 
-                     action_type("HUNKER_DOWN"), target_x(-1), target_y(-1), 
-                     target_agent_id(-1), tactical_priority(0.0) {}
+    double total_score;
     
-    ~SmitsimaxNode() {
-        for (auto* child : children) {
-            delete child;
-        }
+    void init(int parent_index, PackedAction move, double priority) {
+        parent = parent_index;
+        first_child = -1;
+        visits = 0;
+        child_count = 0;
+        action = move;
+        tactical_priority = (float)priority;
+        total_score = 0.0;
     }
     
+    bool has_children() const { return child_count > 0; }
+    
     double get_average_score() const {
         return visits > 0 ? total_score / visits : 0.0;
     }
 };
 
+static_assert(sizeof(SmitsimaxNode) == 32, "two SmitsimaxNodes per cache line");
+
 int manhattan_distance(int x1, int y1, int x2, int y2) {
     return abs(x1 - x2) + abs(y1 - y2);
 }
@@ -105,38 +175,10 @@ AgentClass determine_agent_class(const AgentData& data) {
     return GUNNER; // Default
 }
 
-// Calculate shooting damage with range penalties
-int calculate_shooting_damage(const AgentData& shooter, const AgentState& target, int distance) {
-    if (distance > shooter.optimal_range) return 0;
-    
-    int base_damage = shooter.soaking_power;
-    
-    // Distance penalty for non-optimal range
-    if (distance > 1) {
-        double penalty = 0.25 * (distance - 1);
-        base_damage = (int)(base_damage * (1.0 - penalty));
-    }
-    
-    return max(0, base_damage);
-}
-
-// Calculate bomb/throw damage and splash
-int calculate_throw_damage(const AgentData& thrower, int distance, bool is_splash = false) {
-    if (thrower.splash_bombs <= 0) return 0;
-    
-    int base_damage = thrower.soaking_power;
-    if (is_splash) base_damage /= 2; // Splash damage is halved
-    
-    // Throwing has different range mechanics than shooting
-    if (distance > thrower.optimal_range * 2) return 0;
-    
-    return max(0, base_damage);
-}
-
-// Evaluate tile strategic value (from tactical AI)
+// Evaluate tile strategic value (from tactical AI) for an agent of the side
+// whose first slot is `side_slot`
 double evaluate_tile_strategic_value(int x, int y, int width, int height, 
-                                   const vector<AgentState>& my_agents,
-                                   const vector<AgentState>& enemy_agents,
+                                   const RolloutState& state, int side_slot,
                                    AgentClass agent_class) {
     double score = 0.0;
     
@@ -159,10 +201,11 @@ double evaluate_tile_strategic_value(int x, int y, int width, int height,
     }
     
     // Enemy proximity evaluation
-    if (!enemy_agents.empty()) {
+    int enemies_begin = state.enemies_begin(side_slot), enemies_end = state.enemies_end(side_slot);
+    if (enemies_begin < enemies_end) {
         double min_enemy_dist = 999.0;
-        for (const auto& enemy : enemy_agents) {
-            double dist = manhattan_distance(x, y, enemy.x, enemy.y);
+        for (int e = enemies_begin; e < enemies_end; e++) {
+            double dist = manhattan_distance(x, y, state.x[e], state.y[e]);
             min_enemy_dist = min(min_enemy_dist, dist);
         }
         
@@ -177,12 +220,13 @@ double evaluate_tile_strategic_value(int x, int y, int width, int height,
     }
     
     // Ally coordination
-    if (!my_agents.empty()) {
+    int allies_begin = state.allies_begin(side_slot), allies_end = state.allies_end(side_slot);
+    if (allies_begin < allies_end) {
         double avg_ally_dist = 0.0;
         int ally_count = 0;
-        for (const auto& ally : my_agents) {
-            if (ally.x != x || ally.y != y) {
-                avg_ally_dist += manhattan_distance(x, y, ally.x, ally.y);
+        for (int a = allies_begin; a < allies_end; a++) {
+            if (state.x[a] != x || state.y[a] != y) {
+                avg_ally_dist += manhattan_distance(x, y, state.x[a], state.y[a]);
                 ally_count++;
             }
         }
@@ -198,131 +242,91 @@ double evaluate_tile_strategic_value(int x, int y, int width, int height,
 }
 
 // Calculate territorial control score (inspired by Python version)
-pair<int, int> calculate_controlled_area(const vector<AgentState>& my_agents, 
-                                        const vector<AgentState>& enemy_agents,
-                                        int width, int height) {
-    int my_tiles = 0, enemy_tiles = 0;
-    
-    for (int y = 0; y < height; y++) {
-        for (int x = 0; x < width; x++) {
-            // Find minimum distance to my agents (with wetness penalty)
-            double min_my_dist = 999.0;
-            for (const auto& agent : my_agents) {
-                if (agent.wetness < 100) { // Only alive agents
-                    double base_dist = manhattan_distance(x, y, agent.x, agent.y);
-                    double penalty_multiplier = (agent.wetness >= 50) ? 2.0 : 1.0; // Weakened agents have less control
-                    double effective_dist = base_dist * penalty_multiplier;
-                    min_my_dist = min(min_my_dist, effective_dist);
-                }
-            }
-            
-            // Find minimum distance to enemy agents (with wetness penalty)
-            double min_enemy_dist = 999.0;
-            for (const auto& agent : enemy_agents) {
-                if (agent.wetness < 100) { // Only alive agents
-                    double base_dist = manhattan_distance(x, y, agent.x, agent.y);
-                    double penalty_multiplier = (agent.wetness >= 50) ? 2.0 : 1.0; // Weakened agents have less control
-                    double effective_dist = base_dist * penalty_multiplier;
-                    min_enemy_dist = min(min_enemy_dist, effective_dist);
-                }
-            }
-            
-            // Determine tile control
-            if (min_my_dist < min_enemy_dist) {
-                my_tiles++;
-            } else if (min_enemy_dist < min_my_dist) {
-                enemy_tiles++;
-            }
-            // Tied tiles don't count for either side
-        }
-    }
-    
-    return {my_tiles, enemy_tiles};
+// Returns {tiles controlled by my side, tiles controlled by the enemy side}
+pair<int, int> calculate_controlled_area(const ZoneGrid& grid, const RolloutState& state) {
+    int owned[2];
+    count_control_zones(grid, state.count, state.my_count, state.x, state.y, state.wetness, owned);
+    return {owned[0], owned[1]};
 }
 
 // Calculate tactical priority for an action (from tactical AI) with territorial control
-double calculate_tactical_priority(const string& action_type, const AgentState& agent, 
-                                 const AgentData& agent_data, int target_id, int target_x, int target_y,
-                                 const vector<AgentState>& my_agents, const vector<AgentState>& enemy_agents,
-                                 int width, int height) {
+double calculate_tactical_priority(ActionType action_type, const AgentTable& table, const RolloutState& state,
+                                 int slot, int target_id, int target_x, int target_y) {
     
-    AgentClass agent_class = determine_agent_class(agent_data);
+    AgentClass agent_class = table.agent_class[slot];
+    int width = table.width, height = table.height;
     double tactical_component = 0.0;
     double positioning_component = 0.0;
     double survival_component = 0.0;
     double territorial_component = 0.0;
     
     // Tactical evaluation (50% weight - reduced to make room for territorial)
-    if (action_type == "SHOOT" && agent.cooldown == 0) {
+    if (action_type == ACTION_SHOOT && state.cooldown[slot] == 0) {
         tactical_component = 0.6; // High tactical value
         
         // Check if it's a kill shot
-        for (const auto& enemy : enemy_agents) {
-            if (enemy.agent_id == target_id) {
-                int distance = manhattan_distance(agent.x, agent.y, enemy.x, enemy.y);
-                int damage = calculate_shooting_damage(agent_data, enemy, distance);
-                if (enemy.wetness + damage >= 100) {
+        for (int e = state.enemies_begin(slot); e < state.enemies_end(slot); e++) {
+            if (table.agent_id[e] == target_id) {
+                int damage = RulesEngine::shooting_damage(table, state, slot, e, false);
+                if (state.wetness[e] + damage >= 100) {
                     tactical_component = 1.0; // Kill shot gets maximum priority
                 }
                 break;
             }
         }
-    } else if (action_type == "THROW" && agent.cooldown == 0 && agent.splash_bombs > 0) {
+    } else if (action_type == ACTION_THROW && state.splash_bombs[slot] > 0) {
         tactical_component = 0.4; // Moderate tactical value
         
-        // Count potential splash targets
+        // Count live enemies in the splash: the target and its 8 neighbours
         int splash_targets = 0;
-        for (const auto& enemy : enemy_agents) {
-            int dist = manhattan_distance(target_x, target_y, enemy.x, enemy.y);
-            if (dist <= 2) splash_targets++;
+        for (int e = state.enemies_begin(slot); e < state.enemies_end(slot); e++) {
+            if (state.wetness[e] < 100 && abs(state.x[e] - target_x) <= 1 && abs(state.y[e] - target_y) <= 1) {
+                splash_targets++;
+            }
         }
         if (splash_targets > 1) tactical_component = 0.7; // Multi-target bonus
         
-    } else if (action_type == "MOVE") {
+    } else if (action_type == ACTION_MOVE) {
         tactical_component = 0.1; // Low tactical value but strategic
     } else {
         tactical_component = -0.1; // Hunker down is defensive
     }
     
     // Positioning evaluation (15% weight)
-    if (action_type == "MOVE") {
+    if (action_type == ACTION_MOVE) {
         positioning_component = evaluate_tile_strategic_value(target_x, target_y, width, height,
-                                                            my_agents, enemy_agents, agent_class) * 0.15;
+                                                            state, slot, agent_class) * 0.15;
     } else {
         positioning_component = 0.0;
     }
     
     // Territorial control evaluation (20% weight - NEW!)
-    if (action_type == "MOVE") {
-        // Simulate the move and calculate territorial impact
-        vector<AgentState> test_my_agents = my_agents;
-        for (auto& test_agent : test_my_agents) {
-            if (test_agent.agent_id == agent.agent_id) {
-                test_agent.x = target_x;
-                test_agent.y = target_y;
-                break;
-            }
+    if (action_type == ACTION_MOVE) {
+        // Count the whole board before and after the move
+        RolloutState moved = state;
+        moved.x[slot] = (int8_t)target_x;
+        moved.y[slot] = (int8_t)target_y;
+        pair<int, int> before = calculate_controlled_area(table.zone_grid, state);
+        pair<int, int> after = calculate_controlled_area(table.zone_grid, moved);
+        if (!state.is_mine(slot)) {
+            swap(before.first, before.second);
+            swap(after.first, after.second);
         }
-        
-        // Calculate territorial control before and after move
-        auto [my_tiles_before, enemy_tiles_before] = calculate_controlled_area(my_agents, enemy_agents, width, height);
-        auto [my_tiles_after, enemy_tiles_after] = calculate_controlled_area(test_my_agents, enemy_agents, width, height);
-        
-        int territorial_gain = my_tiles_after - my_tiles_before;
-        int territorial_loss = enemy_tiles_after - enemy_tiles_before;
+        int territorial_gain = after.first - before.first;
+        int territorial_loss = after.second - before.second;
         
         // Normalize territorial component (-1 to 1)
         double total_tiles = width * height;
         territorial_component = ((territorial_gain - territorial_loss) / total_tiles) * 0.2;
         territorial_component = max(-0.2, min(0.2, territorial_component));
         
-    } else if (action_type == "SHOOT" || action_type == "THROW") {
+    } else if (action_type == ACTION_SHOOT || action_type == ACTION_THROW) {
         // Shooting/throwing doesn't directly change territory but weakening enemies helps
         territorial_component = 0.05; // Small territorial benefit from combat
     }
     
     // Survival component (15% weight - reduced)  
-    survival_component = 0.15 * (100 - agent.wetness) / 100.0;
+    survival_component = 0.15 * (100 - state.wetness[slot]) / 100.0;
     
     // Final priority score: weighted sum normalized to [-1, 1]
     // 50% tactical + 15% positioning + 20% territorial + 15% survival = 100%
@@ -332,190 +336,177 @@ double calculate_tactical_priority(const string& action_type, const AgentState&
 
 // Game simulation state
 struct SimulationState {
+    // Turn input, used by the heuristic move picker
     vector<AgentState> my_agents;
     vector<AgentState> enemy_agents;
     unordered_map<int, AgentData> agent_data;
     int width, height;
     
-    // Smitsimax specific data
-    vector<SmitsimaxNode*> current_nodes; // Current node for each agent
-    vector<double> lowest_scores;          // For normalization
-    vector<double> highest_scores;         // For normalization
-    vector<double> scale_parameters;       // Normalization range
+    // Rollout data, indexed by agent slot
+    AgentTable table;
+    RolloutState root;                     // Turn start, cooldowns already ticked
     
     SimulationState() = default;
-    
-    void reset_to_base_state(const vector<AgentState>& base_my, const vector<AgentState>& base_enemy) {
-        my_agents = base_my;
-        enemy_agents = base_enemy;
-        
-        // Reset cooldowns each turn
-        for (auto& agent : my_agents) {
-            if (agent.cooldown > 0) agent.cooldown--;
-        }
-        for (auto& agent : enemy_agents) {
-            if (agent.cooldown > 0) agent.cooldown--;
-        }
-    }
 };
 
-// Apply action to simulation state
-void apply_action(SimulationState& sim, int agent_index, bool is_my_agent) {
-    vector<AgentState>& agents = is_my_agent ? sim.my_agents : sim.enemy_agents;
-    vector<AgentState>& targets = is_my_agent ? sim.enemy_agents : sim.my_agents;
-    
-    if (agent_index >= agents.size()) return;
-    
-    AgentState& agent = agents[agent_index];
-    SmitsimaxNode* node = sim.current_nodes[is_my_agent ? agent_index : agent_index + sim.my_agents.size()];
-    
-    if (node->action_type == "SHOOT" && agent.cooldown == 0) {
-        // Find target and apply damage
-        for (auto& target : targets) {
-            if (target.agent_id == node->target_agent_id) {
-                int distance = manhattan_distance(agent.x, agent.y, target.x, target.y);
-                int damage = calculate_shooting_damage(sim.agent_data[agent.agent_id], target, distance);
-                target.wetness += damage;
-                agent.cooldown = sim.agent_data[agent.agent_id].shoot_cooldown;
-                break;
-            }
-        }
+// Progressive widening: a node offers only its best children by tactical
+// priority, WIDENING_MIN_CHILDREN of them and one more each time its visits
+// pass a square, so thin iteration budgets go to plausible actions first
+inline int widened_child_count(int visits, int child_count) {
+    return min(child_count, WIDENING_MIN_CHILDREN + (int)sqrt((double)max(visits, 0)));
+}
+
+// Children are appended to the arena back to back, best tactical priority
+// first (the order progressive widening offers them in)
+struct TacticalChildren {
+    NodeArena<SmitsimaxNode>& arena;
+    int parent;
+    PackedAction prior_action;
+    float prior_bonus;
+    int created = 0, first = -1;
+    
+    TacticalChildren(NodeArena<SmitsimaxNode>& arena, int parent, PackedAction prior_action, float prior_bonus)
+        : arena(arena), parent(parent), prior_action(prior_action), prior_bonus(prior_bonus) {}
+    
+    void add(PackedAction action, double priority) {
+        int index = arena.allocate();
+        if (index == NodeArena<SmitsimaxNode>::NONE) return;
+        if (first == -1) first = index;
+        if (action == prior_action) priority += prior_bonus;
+        arena[index].init(parent, action, priority);
+        created++;
     }
-    else if (node->action_type == "MOVE") {
-        // Move agent to new position
-        if (node->target_x >= 0 && node->target_x < sim.width && 
-            node->target_y >= 0 && node->target_y < sim.height) {
-            agent.x = node->target_x;
-            agent.y = node->target_y;
+    
+    int finish() {
+        if (created > 1) {
+            stable_sort(&arena[first], &arena[first] + created, [](const SmitsimaxNode& a, const SmitsimaxNode& b) {
+                return a.tactical_priority > b.tactical_priority;
+            });
         }
+        return created;
     }
-    else if (node->action_type == "THROW" && agent.cooldown == 0 && agent.splash_bombs > 0) {
-        // Apply throw damage (3x3 area = radius 1)
-        for (auto& target : targets) {
-            int dist_to_throw = manhattan_distance(target.x, target.y, node->target_x, node->target_y);
-            if (dist_to_throw <= 1) { // 3x3 splash area
-                int damage = sim.agent_data[agent.agent_id].soaking_power / 2;
-                target.wetness += damage;
-            }
-        }
-        agent.splash_bombs--;
-        agent.cooldown = sim.agent_data[agent.agent_id].shoot_cooldown;
+};
+
+// An agent's turn is two tree levels: a movement node for where it goes,
+// then a combat node below it for what it does from there, which holds the
+// whole compound order. The movement level: staying put (HUNKER_DOWN) and
+// every free tile next to the agent. Returns how many children were made; a
+// root's children also get the opening book's prior.
+int create_movement_moves(const AgentTable& table, const RolloutState& state, int slot, RulesEngine& engine,
+                          NodeArena<SmitsimaxNode>& arena, int parent, bool at_root) {
+    TacticalChildren children(arena, parent, table.prior_action[slot].movement(),
+                              at_root ? table.prior_bonus[slot] : 0.0f);
+    int x = state.x[slot], y = state.y[slot];
+    
+    children.add(PackedAction::hunker_down(),
+                 calculate_tactical_priority(ACTION_HUNKER_DOWN, table, state, slot, -1, -1, -1));
+    
+    // MOVEMENT options - use tactical evaluation for best positions. A MOVE
+    // only takes its first step this turn, so a diagonal whose step is another
+    // child's tile, or no step at all, plays the same turn and is left out.
+    const BoardGeometry& geo = table.board.geo;
+    Bitboard occupied;
+    for (int other = 0; other < state.count; other++) {
+        if (state.wetness[other] < 100) occupied |= geo.bit(state.x[other], state.y[other]);
     }
-    // HUNKER_DOWN does nothing but is still a valid choice
+    Bitboard self = geo.bit(x, y);
+    Bitboard destinations = geo.dilate8(self).minus(self) & table.board.walkable(occupied);
+    destinations.for_each([&](int tile) {
+        int nx = geo.x_of(tile), ny = geo.y_of(tile);
+        int step = engine.move_step(table, state, slot, nx, ny);
+        if (step != tile && (self.test(step) || destinations.test(step))) return;
+        children.add(PackedAction::move(nx, ny),
+                     calculate_tactical_priority(ACTION_MOVE, table, state, slot, -1, nx, ny));
+    });
+    return children.finish();
 }
 
-// Generate all possible moves for an agent with tactical evaluation
-vector<SmitsimaxNode*> create_tactical_moves(const AgentState& agent, const SimulationState& sim, bool is_my_agent) {
-    vector<SmitsimaxNode*> moves;
-    const AgentData& data = sim.agent_data.at(agent.agent_id);
+// The combat level below `movement`: HUNKER_DOWN, and the shots and throws
+// open from the tile the agent's MOVE steps onto, as the referee resolves
+// combat after every move. Each child's action is the compound order.
+int create_combat_moves(const AgentTable& table, const RolloutState& state, int slot, PackedAction movement,
+                        RulesEngine& engine, NodeArena<SmitsimaxNode>& arena, int parent, bool at_root) {
+    TacticalChildren children(arena, parent, table.prior_action[slot], at_root ? table.prior_bonus[slot] : 0.0f);
+    RolloutState moved = state;
+    if (movement.has_move()) {
+        int step = engine.move_step(table, state, slot, movement.target_x(), movement.target_y());
+        moved.x[slot] = (int8_t)table.board.geo.x_of(step);
+        moved.y[slot] = (int8_t)table.board.geo.y_of(step);
+    }
+    int x = moved.x[slot], y = moved.y[slot];
+    int enemies_begin = state.enemies_begin(slot), enemies_end = state.enemies_end(slot);
     
     // Always include HUNKER_DOWN
-    SmitsimaxNode* hunker = new SmitsimaxNode();
-    hunker->action_type = "HUNKER_DOWN";
-    hunker->tactical_priority = calculate_tactical_priority("HUNKER_DOWN", agent, data, -1, -1, -1,
-                                                          sim.my_agents, sim.enemy_agents, sim.width, sim.height);
-    moves.push_back(hunker);
+    children.add(PackedAction::combine(movement, PackedAction::hunker_down()),
+                 calculate_tactical_priority(ACTION_HUNKER_DOWN, table, moved, slot, -1, -1, -1));
     
     // SHOOTING options
-    if (agent.cooldown == 0) {
-        const vector<AgentState>& targets = is_my_agent ? sim.enemy_agents : sim.my_agents;
-        for (const auto& target : targets) {
-            if (target.wetness < 100) {
-                int distance = manhattan_distance(agent.x, agent.y, target.x, target.y);
-                if (distance <= data.optimal_range) {
-                    SmitsimaxNode* shoot = new SmitsimaxNode();
-                    shoot->action_type = "SHOOT";
-                    shoot->target_agent_id = target.agent_id;
-                    shoot->tactical_priority = calculate_tactical_priority("SHOOT", agent, data, target.agent_id, -1, -1,
-                                                                         sim.my_agents, sim.enemy_agents, sim.width, sim.height);
-                    moves.push_back(shoot);
+    if (state.cooldown[slot] == 0) {
+        for (int t = enemies_begin; t < enemies_end; t++) {
+            if (state.wetness[t] < 100) {
+                int distance = manhattan_distance(x, y, state.x[t], state.y[t]);
+                if (distance <= table.optimal_range[slot]) {
+                    children.add(PackedAction::combine(movement, PackedAction::shoot(table.agent_id[t])),
+                                 calculate_tactical_priority(ACTION_SHOOT, table, moved, slot, table.agent_id[t], -1, -1));
                 }
             }
         }
     }
     
-    // MOVEMENT options - use tactical evaluation for best positions
-    AgentClass agent_class = determine_agent_class(data);
-    int dx[] = {-1, 1, 0, 0, -1, -1, 1, 1};
-    int dy[] = {0, 0, -1, 1, -1, 1, -1, 1};
-    
-    for (int i = 0; i < 8; i++) {
-        int nx = agent.x + dx[i];
-        int ny = agent.y + dy[i];
-        
-        if (nx >= 0 && nx < sim.width && ny >= 0 && ny < sim.height) {
-            // Check if position is free
-            bool blocked = false;
-            for (const auto& other : sim.my_agents) {
-                if (other.x == nx && other.y == ny) {
-                    blocked = true;
-                    break;
-                }
-            }
-            for (const auto& other : sim.enemy_agents) {
-                if (other.x == nx && other.y == ny) {
-                    blocked = true;
-                    break;
-                }
-            }
-            
-            if (!blocked) {
-                SmitsimaxNode* move = new SmitsimaxNode();
-                move->action_type = "MOVE";
-                move->target_x = nx;
-                move->target_y = ny;
-                move->tactical_priority = calculate_tactical_priority("MOVE", agent, data, -1, nx, ny,
-                                                                    sim.my_agents, sim.enemy_agents, sim.width, sim.height);
-                moves.push_back(move);
-            }
+    // THROWING options (for agents with balloons; the referee checks the
+    // cooldown for SHOOT only). Any cell within THROW_DISTANCE_MAX can be the
+    // target, so a throw can land between enemies. Cells whose splash, the
+    // cell and its 8 neighbours, holds no live enemy are dominated by
+    // HUNKER_DOWN and never made: what is left is the in-range part of the
+    // enemies' 3x3 surroundings, at most 41 cells.
+    if (state.splash_bombs[slot] > 0) {
+        const BoardGeometry& geo = table.board.geo;
+        Bitboard enemy_tiles;
+        for (int t = enemies_begin; t < enemies_end; t++) {
+            if (state.wetness[t] < 100) enemy_tiles |= geo.bit(state.x[t], state.y[t]);
         }
+        Bitboard targets = geo.within_manhattan(geo.bit(x, y), RULES_THROW_DISTANCE_MAX) & geo.dilate8(enemy_tiles);
+        targets.for_each([&](int tile) {
+            int tx = geo.x_of(tile), ty = geo.y_of(tile);
+            children.add(PackedAction::combine(movement, PackedAction::throw_at(tx, ty)),
+                         calculate_tactical_priority(ACTION_THROW, table, moved, slot, -1, tx, ty));
+        });
     }
-    
-    // THROWING options (for agents with bombs)
-    if (agent.cooldown == 0 && agent.splash_bombs > 0) {
-        const vector<AgentState>& targets = is_my_agent ? sim.enemy_agents : sim.my_agents;
-        for (const auto& target : targets) {
-            if (target.wetness < 100) {
-                int distance = manhattan_distance(agent.x, agent.y, target.x, target.y);
-                if (distance <= data.optimal_range * 2) {
-                    SmitsimaxNode* throw_action = new SmitsimaxNode();
-                    throw_action->action_type = "THROW";
-                    throw_action->target_x = target.x;
-                    throw_action->target_y = target.y;
-                    throw_action->tactical_priority = calculate_tactical_priority("THROW", agent, data, -1, target.x, target.y,
-                                                                                sim.my_agents, sim.enemy_agents, sim.width, sim.height);
-                    moves.push_back(throw_action);
-                }
-            }
-        }
-    }
-    
-    return moves;
+    return children.finish();
 }
 
-// Enhanced game state evaluation combining Smitsimax with tactical AI
-double evaluate_enhanced_game_state(const SimulationState& sim, int agent_index, bool is_my_agent) {
+// Children of a node with the given action on the given level of an
+// agent's tree (0: a turn's movement, 1: its combat)
+int create_tactical_moves(const AgentTable& table, const RolloutState& state, int slot, int level,
+                          PackedAction action, RulesEngine& engine, NodeArena<SmitsimaxNode>& arena, int parent,
+                          bool at_root) {
+    return level == 0 ? create_movement_moves(table, state, slot, engine, arena, parent, at_root)
+                      : create_combat_moves(table, state, slot, action, engine, arena, parent, at_root);
+}
+
+// Enhanced game state evaluation combining Smitsimax with tactical AI,
+// scored from the point of view of the agent in `slot`
+double evaluate_enhanced_game_state(const AgentTable& table, const RolloutState& state,
+                                    int slot) {
     double score = 0.0;
     
     // Count live agents and health
     int my_live = 0, enemy_live = 0;
     int my_total_health = 0, enemy_total_health = 0;
     
-    for (const auto& agent : sim.my_agents) {
-        if (agent.wetness < 100) {
+    for (int s = 0; s < state.count; s++) {
+        if (state.wetness[s] >= 100) continue;
+        if (state.is_mine(s)) {
             my_live++;
-            my_total_health += (100 - agent.wetness);
-        }
-    }
-    
-    for (const auto& agent : sim.enemy_agents) {
-        if (agent.wetness < 100) {
+            my_total_health += (100 - state.wetness[s]);
+        } else {
             enemy_live++;
-            enemy_total_health += (100 - agent.wetness);
+            enemy_total_health += (100 - state.wetness[s]);
         }
     }
     
     // Basic scoring
+    bool is_my_agent = state.is_mine(slot);
     if (is_my_agent) {
         score += (my_live - enemy_live) * 100;
         score += (my_total_health - enemy_total_health) * 0.5;
@@ -525,7 +516,8 @@ double evaluate_enhanced_game_state(const SimulationState& sim, int agent_index,
     }
     
     // Territorial control scoring (NEW!)
-    auto [my_controlled, enemy_controlled] = calculate_controlled_area(sim.my_agents, sim.enemy_agents, sim.width, sim.height);
+    pair<int, int> controlled = calculate_controlled_area(table.zone_grid, state);
+    int my_controlled = controlled.first, enemy_controlled = controlled.second;
     if (is_my_agent) {
         score += (my_controlled - enemy_controlled) * 2.0; // Territory advantage
     } else {
@@ -533,37 +525,32 @@ double evaluate_enhanced_game_state(const SimulationState& sim, int agent_index,
     }
     
     // Agent-specific scoring with tactical considerations
-    const vector<AgentState>& agents = is_my_agent ? sim.my_agents : sim.enemy_agents;
-    if (agent_index < agents.size()) {
-        const AgentState& agent = agents[agent_index];
-        if (agent.wetness < 100) {
-            // Survival bonus
-            score += (100 - agent.wetness) * 0.3;
-            
-            // Positional bonus using tactical evaluation
-            AgentClass ac = determine_agent_class(sim.agent_data.at(agent.agent_id));
-            double position_value = evaluate_tile_strategic_value(agent.x, agent.y, sim.width, sim.height,
-                                                                sim.my_agents, sim.enemy_agents, ac);
-            score += position_value * 20;
-            
-            // Combat readiness
-            if (agent.cooldown == 0) score += 15;
-            
-            // Agent class specific bonuses
-            const vector<AgentState>& targets = is_my_agent ? sim.enemy_agents : sim.my_agents;
-            for (const auto& target : targets) {
-                if (target.wetness < 100) {
-                    int dist = manhattan_distance(agent.x, agent.y, target.x, target.y);
-                    const AgentData& data = sim.agent_data.at(agent.agent_id);
-                    
-                    if (dist <= data.optimal_range) {
-                        score += 10; // In optimal range
-                        if (agent.cooldown == 0) {
-                            int damage = calculate_shooting_damage(data, target, dist);
-                            score += damage * 0.5;
-                            if (target.wetness + damage >= 100) {
-                                score += 50; // Kill shot opportunity
-                            }
+    if (slot < state.count && state.wetness[slot] < 100) {
+        int x = state.x[slot], y = state.y[slot];
+        
+        // Survival bonus
+        score += (100 - state.wetness[slot]) * 0.3;
+        
+        // Positional bonus using tactical evaluation
+        double position_value = evaluate_tile_strategic_value(x, y, table.width, table.height,
+                                                            state, slot, table.agent_class[slot]);
+        score += position_value * 20;
+        
+        // Combat readiness
+        if (state.cooldown[slot] == 0) score += 15;
+        
+        // Agent class specific bonuses
+        for (int t = state.enemies_begin(slot); t < state.enemies_end(slot); t++) {
+            if (state.wetness[t] < 100) {
+                int dist = manhattan_distance(x, y, state.x[t], state.y[t]);
+                
+                if (dist <= table.optimal_range[slot]) {
+                    score += 10; // In optimal range
+                    if (state.cooldown[slot] == 0) {
+                        int damage = RulesEngine::shooting_damage(table, state, slot, t, false);
+                        score += damage * 0.5;
+                        if (state.wetness[t] + damage >= 100) {
+                            score += 50; // Kill shot opportunity
                         }
                     }
                 }
@@ -574,530 +561,579 @@ double evaluate_enhanced_game_state(const SimulationState& sim, int agent_index,
     return score;
 }
 
-// Pre-computed game state cache for instant decisions
-struct GameStateKey {
-    vector<pair<int, int>> my_positions;  // agent_id, x, y, wetness, cooldown
-    vector<pair<int, int>> enemy_positions;
-    
-    bool operator==(const GameStateKey& other) const {
-        return my_positions == other.my_positions && enemy_positions == other.enemy_positions;
-    }
-};
-
-struct GameStateHash {
-    size_t operator()(const GameStateKey& key) const {
-        size_t hash = 0;
-        for (auto& pos : key.my_positions) {
-            hash ^= std::hash<int>{}(pos.first) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
-            hash ^= std::hash<int>{}(pos.second) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
-        }
-        for (auto& pos : key.enemy_positions) {
-            hash ^= std::hash<int>{}(pos.first) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
-            hash ^= std::hash<int>{}(pos.second) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
-        }
-        return hash;
-    }
-};
-
-struct PrecomputedMove {
-    string action_type;
-    int target_x = -1, target_y = -1;
-    int target_agent_id = -1;
-    double confidence_score = 0.0;
-    string reasoning = "";
-};
+// What the referee applies for a tree or book action: a lone
+// MOVE is sent with HUNKER_DOWN, which costs nothing
+PackedAction issued_order(PackedAction action) {
+    return PackedAction::combine(action.movement(), action.combat());
+}
 
-// Smitsimax search implementation with pre-computation cache
-class MergedSmitsimaxSearch {
-private:
-    vector<SmitsimaxNode*> root_nodes;
-    SimulationState sim;
-    random_device rd;
+// One root-parallel Smitsimax worker: its own per-agent trees, rollout state,
+// rules engine scratch and RNG. Reads the turn's table and root state only.
+struct SearchWorker {
+    NodeArena<SmitsimaxNode> arena;
+    unique_ptr<NodeArena<SmitsimaxNode>> spare; // Promotion target, swapped with arena; see reserve_spare
+    vector<int> promote_queue;
+    vector<int> root_nodes;                // Arena index of each agent's root
+    RolloutState rollout;                  // Advanced a whole turn at a time by the rules engine
+    RulesEngine engine;
     mt19937 gen;
+    int iterations = 0;
     
-    // Pre-computation cache
-    unordered_map<GameStateKey, vector<PrecomputedMove>, GameStateHash> move_cache;
-    bool cache_built = false;
+    int current_nodes[MAX_AGENTS];         // Current node (arena index) for each agent
+    double lowest_scores[MAX_AGENTS];      // For normalization
+    double highest_scores[MAX_AGENTS];     // For normalization
+    double scale_parameters[MAX_AGENTS];   // Normalization range
     
-public:
-    MergedSmitsimaxSearch() : gen(rd()) {}
+    explicit SearchWorker(unsigned seed) : arena(NODE_ARENA_CAPACITY), gen(seed) {}
     
-    ~MergedSmitsimaxSearch() {
-        for (auto* root : root_nodes) {
-            delete root;
-            
+    // Drops previous trees in O(1) and creates a root per agent
+    void reset(int agent_count) {
+        arena.reset();
+        root_nodes.resize(agent_count);
+        iterations = 0;
+        for (int i = 0; i < agent_count; i++) {
+            root_nodes[i] = arena.allocate();
+            arena[root_nodes[i]].init(-1, PackedAction::hunker_down(), 0.0);
+            current_nodes[i] = root_nodes[i];
+            lowest_scores[i] = 0.0;
+            highest_scores[i] = 0.0;
+            scale_parameters[i] = 1.0;
         }
     }
     
-    // Create game state key for caching
-    GameStateKey create_state_key(const vector<AgentState>& my_agents, const vector<AgentState>& enemy_agents) {
-        GameStateKey key;
-        
-        for (const auto& agent : my_agents) {
-            key.my_positions.push_back({agent.agent_id, agent.x * 1000 + agent.y * 100 + agent.wetness + agent.cooldown});
+    // The combat node a turn node reaches by playing action, or -1
+    int turn_child(int node_index, PackedAction action) const {
+        const SmitsimaxNode& node = arena[node_index];
+        for (int m = node.first_child; m < node.first_child + node.child_count; m++) {
+            if (arena[m].action != action.movement()) continue;
+            const SmitsimaxNode& movement = arena[m];
+            for (int c = movement.first_child; c < movement.first_child + movement.child_count; c++) {
+                if (arena[c].action == issued_order(action)) return c;
+            }
         }
-        
-        for (const auto& agent : enemy_agents) {
-            key.enemy_positions.push_back({agent.agent_id, agent.x * 1000 + agent.y * 100 + agent.wetness + agent.cooldown});
+        return -1;
+    }
+    
+    void reserve_spare() {
+        if (!spare) spare.reset(new NodeArena<SmitsimaxNode>(NODE_ARENA_CAPACITY));
+    }
+    
+    // Tree reuse: makes each root's combat node for actions[agent] that
+    // agent's new root, copying the surviving subtrees breadth first into the
+    // spare arena (siblings stay contiguous) and swapping arenas. Returns
+    // false and keeps the trees when some root has no such node.
+    bool promote(const PackedAction* actions) {
+        int agent_count = (int)root_nodes.size();
+        int kept[MAX_AGENTS];
+        for (int a = 0; a < agent_count; a++) {
+            kept[a] = turn_child(root_nodes[a], actions[a]);
+            if (kept[a] == -1) return false;
         }
         
-        sort(key.my_positions.begin(), key.my_positions.end());
-        sort(key.enemy_positions.begin(), key.enemy_positions.end());
+        reserve_spare();
+        NodeArena<SmitsimaxNode>& next = *spare;
+        next.reset();
+        // A node's index in next is its position in the queue
+        promote_queue.clear();
+        for (int a = 0; a < agent_count; a++) {
+            root_nodes[a] = next.allocate();
+            next[root_nodes[a]] = arena[kept[a]];
+            next[root_nodes[a]].parent = -1;
+            promote_queue.push_back(kept[a]);
+        }
+        for (size_t head = 0; head < promote_queue.size(); head++) {
+            SmitsimaxNode& copy = next[(int)head];
+            int first = copy.first_child, count = copy.child_count;
+            copy.first_child = -1;
+            copy.child_count = 0;
+            for (int c = first; c < first + count; c++) {
+                int index = next.allocate();
+                if (index == NodeArena<SmitsimaxNode>::NONE) break;
+                next[index] = arena[c];
+                next[index].parent = (int)head;
+                if (copy.child_count == 0) copy.first_child = index;
+                copy.child_count++;
+                promote_queue.push_back(c);
+            }
+        }
+        swap(arena, next);
         
-        return key;
+        iterations = 0;
+        for (int a = 0; a < agent_count; a++) current_nodes[a] = root_nodes[a];
+        return true;
     }
     
-    // Pre-compute all possible game scenarios
-    void build_prediction_cache() {
-        if (cache_built) return;
-        
-        cerr << "=== BUILDING PREDICTION CACHE ===" << endl;
-        cerr << "Pre-computing all possible game scenarios..." << endl;
+    int select_child_ucb(int node_index, int agent_index) {
+        const SmitsimaxNode& node = arena[node_index];
+        if (!node.has_children()) return -1;
+        int offered = widened_child_count(node.visits, node.child_count);
+        if (node.visits < MIN_RANDOM_VISITS) {
+            // Random selection for first few visits to avoid resonance
+            uniform_int_distribution<> dis(0, offered - 1);
+            return node.first_child + dis(gen);
+        }
         
-        auto start_time = chrono::high_resolution_clock::now();
-        int scenarios_computed = 0;
+        // UCB selection with tactical priority integration
+        int best_child = -1;
+        double best_ucb = -numeric_limits<double>::infinity();
         
-        // Generate scenarios for different agent counts, positions, and health states
-        for (int my_alive = 1; my_alive <= sim.my_agents.size(); my_alive++) {
-            for (int enemy_alive = 1; enemy_alive <= sim.enemy_agents.size(); enemy_alive++) {
-                
-                // Sample different position combinations
-                for (int pos_variant = 0; pos_variant < 20; pos_variant++) {
-                    
-                    // Create a test scenario
-                    vector<AgentState> test_my = sim.my_agents;
-                    vector<AgentState> test_enemy = sim.enemy_agents;
-                    
-                    // Randomize positions and health for variety
-                    uniform_int_distribution<> pos_dist(0, min(sim.width-1, sim.height-1));
-                    uniform_int_distribution<> health_dist(10, 90);
-                    uniform_int_distribution<> cooldown_dist(0, 3);
-                    
-                    // Modify agent states for this scenario
-                    for (int i = 0; i < test_my.size(); i++) {
-                        if (i >= my_alive) {
-                            test_my[i].wetness = 100; // Dead
-                        } else {
-                            test_my[i].x = pos_dist(gen);
-                            test_my[i].y = pos_dist(gen);
-                            test_my[i].wetness = health_dist(gen);
-                            test_my[i].cooldown = cooldown_dist(gen);
-                        }
-                    }
-                    
-                    for (int i = 0; i < test_enemy.size(); i++) {
-                        if (i >= enemy_alive) {
-                            test_enemy[i].wetness = 100; // Dead
-                        } else {
-                            test_enemy[i].x = pos_dist(gen);
-                            test_enemy[i].y = pos_dist(gen);
-                            test_enemy[i].wetness = health_dist(gen);
-                            test_enemy[i].cooldown = cooldown_dist(gen);
-                        }
-                    }
-                    
-                    // Run quick search for this scenario
-                    SimulationState temp_sim = sim;
-                    temp_sim.my_agents = test_my;
-                    temp_sim.enemy_agents = test_enemy;
-                    
-                    // Quick tactical evaluation for each agent
-                    vector<PrecomputedMove> scenario_moves;
-                    for (int i = 0; i < test_my.size(); i++) {
-                        PrecomputedMove best_move;
-                        if (test_my[i].wetness < 100) {
-                            // Agent is ALIVE - compute real move
-                            best_move = compute_best_move_quick(test_my[i], temp_sim, i);
-                        } else {
-                            // Agent is DEAD - default action
-                            best_move.action_type = "HUNKER_DOWN";
-                            best_move.confidence_score = 0.0;
-                            best_move.reasoning = "Agent dead";
-                        }
-                        scenario_moves.push_back(best_move);
-                    }
-                    
-                    // Store in cache
-                    GameStateKey key = create_state_key(test_my, test_enemy);
-                    move_cache[key] = scenario_moves;
-                    scenarios_computed++;
-                    
-                    // Time limit for cache building
-                    auto current_time = chrono::high_resolution_clock::now();
-                    auto elapsed = chrono::duration_cast<chrono::milliseconds>(current_time - start_time);
-                    if (elapsed.count() > 2000) { // 2 second limit
-                        cerr << "Cache building time limit reached" << endl;
-                        goto cache_done;
-                    }
+        for (int c = node.first_child; c < node.first_child + offered; c++) {
+            const SmitsimaxNode& child = arena[c];
+            if (child.visits == 0) {
+                // Unvisited nodes get infinite priority, but prefer tactically sound moves
+                if (best_child == -1 || child.tactical_priority > arena[best_child].tactical_priority) {
+                    best_child = c;
                 }
+                continue;
+            }
+            
+            double avg_score = child.get_average_score();
+            double normalized_score = avg_score / (child.visits * scale_parameters[agent_index]);
+            double exploration = EXPLORATION_PARAM * sqrt(log(node.visits)) * (1.0 / sqrt(child.visits));
+            double tactical_bonus = child.tactical_priority * 0.3; // Blend tactical evaluation
+            double ucb = normalized_score + exploration + tactical_bonus;
+            
+            if (ucb > best_ucb) {
+                best_ucb = ucb;
+                best_child = c;
             }
         }
         
-        cache_done:
-        auto end_time = chrono::high_resolution_clock::now();
-        auto duration = chrono::duration_cast<chrono::milliseconds>(end_time - start_time);
-        
-        cerr << "Pre-computation complete!" << endl;
-        cerr << "Scenarios computed: " << scenarios_computed << endl;
-        cerr << "Cache size: " << move_cache.size() << " entries" << endl;
-        cerr << "Build time: " << duration.count() << "ms" << endl;
-        
-        cache_built = true;
+        return best_child;
     }
     
-    // Quick move computation for fresh real-time decisions
-    PrecomputedMove compute_best_move_quick(const AgentState& agent, const SimulationState& temp_sim, int agent_index) {
-        PrecomputedMove move;
-        const AgentData& data = temp_sim.agent_data.at(agent.agent_id);
-        AgentClass agent_class = determine_agent_class(data);
-        
-        double best_score = -1000.0;
-        
-        cerr << "  Analyzing agent " << agent.agent_id << " (" << 
-                (agent_class == SNIPER ? "SNIPER" : agent_class == BOMBER ? "BOMBER" : 
-                 agent_class == GUNNER ? "GUNNER" : agent_class == ASSAULT ? "ASSAULT" : "BERSERKER")
-                << ") at (" << agent.x << "," << agent.y << ") cooldown=" << agent.cooldown << endl;
+    void expand_node(const AgentTable& table, int node_index, int agent_index, int level) {
+        if (arena[node_index].has_children()) return;
         
-        // PRIORITY 1: SNIPER long-range shooting (ALWAYS PRIORITIZE SHOOTING OVER MOVEMENT)
-        if (agent_class == SNIPER && agent.cooldown == 0) {
-            for (const auto& enemy : temp_sim.enemy_agents) {
-                if (enemy.wetness < 100) {
-                    int distance = manhattan_distance(agent.x, agent.y, enemy.x, enemy.y);
-                    if (distance <= 6) { // SNIPER range
-                        int damage = calculate_shooting_damage(data, enemy, distance);
-                        if (damage > 0) { // Only shoot if damage > 0
-                            double score = 2000.0 + damage * 25.0; // ULTRA HIGH SHOOTING PRIORITY
-                            if (enemy.wetness + damage >= 100) score += 3000.0; // KILL SHOT MASSIVE BONUS
-                            if (distance >= 4) score += 1000.0; // Long range bonus (SNIPER specialty)
-                            if (distance == 6) score += 500.0; // Maximum range bonus
-                            
-                            cerr << "    SNIPER can shoot enemy " << enemy.agent_id << " at dist=" << distance 
-                                 << " damage=" << damage << " score=" << score << endl;
-                            
-                            if (score > best_score) {
-                                best_score = score;
-                                move.action_type = "SHOOT";
-                                move.target_agent_id = enemy.agent_id;
-                                move.confidence_score = 1.0; // Max confidence for shooting
-                                move.reasoning = "SNIPER long-range precision shot";
-                            }
-                        }
-                    }
-                }
+        int first = (int)arena.size();
+        const SmitsimaxNode& node = arena[node_index];
+        bool at_root = level == 0 ? node.parent == -1 : arena[node.parent].parent == -1;
+        int count = create_tactical_moves(table, rollout, agent_index, level, node.action, engine, arena, node_index, at_root);
+        if (count > 0) {
+            arena[node_index].first_child = first;
+            arena[node_index].child_count = (uint16_t)count;
+        }
+    }
+    
+    void backpropagate(int node_index, double score, int agent_index) {
+        while (node_index != -1) {
+            SmitsimaxNode& node = arena[node_index];
+            node.visits++;
+            node.total_score += score;
+            
+            // Update normalization parameters
+            if (score < lowest_scores[agent_index]) {
+                lowest_scores[agent_index] = score;
+            }
+            if (score > highest_scores[agent_index]) {
+                highest_scores[agent_index] = score;
             }
+            
+            double range = highest_scores[agent_index] - lowest_scores[agent_index];
+            scale_parameters[agent_index] = max(1.0, range);
+            
+            node_index = node.parent;
         }
-        
-        // PRIORITY 2: BOMBER splash bombing (FIND BEST BOMB LOCATION)
-        if (agent_class == BOMBER && agent.cooldown == 0 && agent.splash_bombs > 0) {
-            // Find best location for maximum splash damage
-            pair<int, int> best_bomb_location = {-1, -1};
-            double best_bomb_score = 0;
+    }
+    
+    // Iterates until the clock expires or the iteration cap
+    void run(const AgentTable& table, const RolloutState& root, SearchClock clock) {
+        while (iterations < MAX_WORKER_ITERATIONS && !clock.expired()) {
+            // Reset simulation to base state
+            memcpy(&rollout, &root, sizeof(RolloutState));
             
-            // Check each enemy position as potential bomb target
-            for (const auto& primary_enemy : temp_sim.enemy_agents) {
-                if (primary_enemy.wetness < 100) {
-                    int distance = manhattan_distance(agent.x, agent.y, primary_enemy.x, primary_enemy.y);
-                    if (distance <= 4) { // BOMBER throw range (2x optimal range)
+            // Selection and simulation phase: every tree picks its agent's
+            // movement and combat, then the rules engine plays the turn for
+            // all of them. A tree that ends at a movement node hunkers there.
+            for (int depth = 0; depth < MAX_SEARCH_DEPTH; depth++) {
+                PackedAction orders[MAX_AGENTS];
+                for (int agent_idx = 0; agent_idx < (int)root_nodes.size(); agent_idx++) {
+                    for (int level = 0; level < TREE_LEVELS_PER_TURN; level++) {
+                        int current = current_nodes[agent_idx];
                         
-                        // Count all enemies in splash radius around this target (3x3 = radius 1)
-                        int splash_targets = 0;
-                        int total_splash_damage = 0;
-                        for (const auto& splash_enemy : temp_sim.enemy_agents) {
-                            if (splash_enemy.wetness < 100) {
-                                int splash_dist = manhattan_distance(primary_enemy.x, primary_enemy.y, 
-                                                                   splash_enemy.x, splash_enemy.y);
-                                if (splash_dist <= 1) { // 3x3 area = splash radius 1
-                                    splash_targets++;
-                                    total_splash_damage += data.soaking_power / 2;
-                                }
-                            }
+                        // Expand if needed
+                        if (arena[current].visits == 1) {
+                            expand_node(table, current, agent_idx, level);
                         }
                         
-                        double bomb_score = 800.0 + total_splash_damage * 15.0; // BOMBER HUGE PRIORITY
-                        if (splash_targets > 1) bomb_score += splash_targets * 1000.0; // MULTI-TARGET MASSIVE BONUS
-                        
-                        cerr << "    BOMBER can bomb (" << primary_enemy.x << "," << primary_enemy.y 
-                             << ") targets=" << splash_targets << " damage=" << total_splash_damage 
-                             << " score=" << bomb_score << endl;
-                        
-                        if (bomb_score > best_bomb_score) {
-                            best_bomb_score = bomb_score;
-                            best_bomb_location = {primary_enemy.x, primary_enemy.y};
-                        }
+                        // Select child
+                        if (!arena[current].has_children()) break;
+                        int selected = select_child_ucb(current, agent_idx);
+                        if (selected == -1) break;
+                        arena[selected].visits++;
+                        current_nodes[agent_idx] = selected;
+                        orders[agent_idx] = issued_order(arena[selected].action);
                     }
                 }
+                engine.step(table, rollout, orders);
             }
             
-            if (best_bomb_score > best_score) {
-                best_score = best_bomb_score;
-                move.action_type = "THROW";
-                move.target_x = best_bomb_location.first;
-                move.target_y = best_bomb_location.second;
-                move.confidence_score = 1.0; // Max confidence for bombing
-                move.reasoning = "BOMBER splash bombing cluster";
+            // Enhanced evaluation and backpropagation
+            for (int agent_idx = 0; agent_idx < (int)root_nodes.size(); agent_idx++) {
+                double score = evaluate_enhanced_game_state(table, rollout, agent_idx);
+                backpropagate(current_nodes[agent_idx], score, agent_idx);
             }
-        }
-        
-        // PRIORITY 3: Other agent shooting (ALWAYS PRIORITIZE SHOOTING)
-        if (agent.cooldown == 0 && agent_class != SNIPER && agent_class != BOMBER) { 
-            for (const auto& enemy : temp_sim.enemy_agents) {
-                if (enemy.wetness < 100) {
-                    int distance = manhattan_distance(agent.x, agent.y, enemy.x, enemy.y);
-                    if (distance <= data.optimal_range) {
-                        int damage = calculate_shooting_damage(data, enemy, distance);
-                        if (damage > 0) { // Only shoot if damage > 0
-                            double score = 1500.0 + damage * 20.0; // VERY HIGH SHOOTING PRIORITY
-                            if (enemy.wetness + damage >= 100) score += 2500.0; // KILL SHOT HUGE BONUS
-                            
-                            // Agent class bonuses
-                            if (agent_class == GUNNER && distance <= 2) score += 500.0;
-                            if (agent_class == ASSAULT && distance <= 3) score += 600.0;
-                            if (agent_class == BERSERKER && distance <= 2) score += 800.0;
-                            
-                            cerr << "    " << (agent_class == GUNNER ? "GUNNER" : agent_class == ASSAULT ? "ASSAULT" : "BERSERKER")
-                                 << " can shoot enemy " << enemy.agent_id << " at dist=" << distance 
-                                 << " damage=" << damage << " score=" << score << endl;
-                            
-                            if (score > best_score) {
-                                best_score = score;
-                                move.action_type = "SHOOT";
-                                move.target_agent_id = enemy.agent_id;
-                                move.confidence_score = 1.0; // Max confidence for shooting
-                                move.reasoning = "Aggressive tactical shooting";
-                            }
-                        }
-                    }
-                }
+            
+            // Reset current nodes to roots for next iteration
+            for (int i = 0; i < (int)root_nodes.size(); i++) {
+                current_nodes[i] = root_nodes[i];
             }
+            
+            iterations++;
         }
-        
-        // PRIORITY 4: ASSAULT/GUNNER throwing (PRIORITIZE OVER MOVEMENT)
-        if (agent.cooldown == 0 && agent.splash_bombs > 0 && 
-            (agent_class == ASSAULT || agent_class == GUNNER)) {
-            for (const auto& enemy : temp_sim.enemy_agents) {
-                if (enemy.wetness < 100) {
-                    int distance = manhattan_distance(agent.x, agent.y, enemy.x, enemy.y);
-                    if (distance <= data.optimal_range * 2) {
+    }
+};
+
+// SmitsimaxNode of the tree-parallel search. Every thread updates the
+// statistics; the children range is written once, by the thread that claimed
+// the expansion, and becomes visible when child_count is published.
+struct SharedSmitsimaxNode {
+    int parent;
+    int first_child;
+    atomic<int> child_count;
+    atomic<int> expand_state;
+    atomic<int> visits;
+    atomic<double> total_score;
+    PackedAction action;
+    float tactical_priority;
+    
+    void init(int parent_index, PackedAction move, float priority) {
+        parent = parent_index;
+        first_child = -1;
+        child_count.store(0, memory_order_relaxed);
+        expand_state.store(EXPAND_NONE, memory_order_relaxed);
+        visits.store(0, memory_order_relaxed);
+        total_score.store(0.0, memory_order_relaxed);
+        action = move;
+        tactical_priority = priority;
+    }
+};
+
+// Per-agent Smitsimax trees that all threads descend together (tree
+// parallelism). Each thread runs SearchWorker::run's iteration against the
+// shared trees with its own rollout state, engine scratch, RNG and score
+// range. Virtual loss on the way down keeps concurrent descents apart.
+class SharedSmitsimaxTrees {
+public:
+    SharedNodeArena<SharedSmitsimaxNode> arena;
+    vector<int> root_nodes;
+    atomic<int> iterations;
+    
+    SharedSmitsimaxTrees() : arena(NODE_ARENA_CAPACITY), iterations(0) {}
+    
+    // Only while no thread is running
+    void reset(int agent_count) {
+        arena.reset();
+        iterations.store(0, memory_order_relaxed);
+        root_nodes.resize(agent_count);
+        int first = arena.allocate_range(agent_count);
+        for (int i = 0; i < agent_count; i++) {
+            root_nodes[i] = first + i;
+            arena[root_nodes[i]].init(-1, PackedAction::hunker_down(), 0.0f);
+        }
+    }
+    
+    // One thread's share of the search; every thread calls this at once
+    void run(const AgentTable& table, const RolloutState& root, unsigned seed, int max_iterations, SearchClock clock) {
+        ThreadState t(seed, (int)root_nodes.size());
+        while (!clock.expired()) {
+            if (iterations.fetch_add(1, memory_order_relaxed) >= max_iterations) break;
+            memcpy(&t.rollout, &root, sizeof(RolloutState));
+            for (int i = 0; i < (int)root_nodes.size(); i++) {
+                t.current_nodes[i] = root_nodes[i];
+            }
+            
+            for (int depth = 0; depth < MAX_SEARCH_DEPTH; depth++) {
+                PackedAction orders[MAX_AGENTS];
+                for (int agent_idx = 0; agent_idx < (int)root_nodes.size(); agent_idx++) {
+                    for (int level = 0; level < TREE_LEVELS_PER_TURN; level++) {
+                        int current = t.current_nodes[agent_idx];
                         
-                        int splash_count = 0;
-                        int total_damage = 0;
-                        for (const auto& other_enemy : temp_sim.enemy_agents) {
-                            if (other_enemy.wetness < 100) {
-                                int splash_dist = manhattan_distance(enemy.x, enemy.y, other_enemy.x, other_enemy.y);
-                                if (splash_dist <= 1) { // 3x3 area = splash radius 1
-                                    splash_count++;
-                                    total_damage += data.soaking_power / 2;
-                                }
-                            }
+                        // Visits run ahead of 1 under contention, so expand from 1 on
+                        if (arena[current].visits.load(memory_order_relaxed) >= 1) {
+                            expand_node(table, t, current, agent_idx, level);
                         }
                         
-                        double score = 600.0 + total_damage * 12.0; // THROWING PRIORITY
-                        if (splash_count > 1) score += splash_count * 800.0; // MULTI-TARGET BONUS
-                        
-                        cerr << "    " << (agent_class == ASSAULT ? "ASSAULT" : "GUNNER")
-                             << " can throw at (" << enemy.x << "," << enemy.y 
-                             << ") targets=" << splash_count << " damage=" << total_damage 
-                             << " score=" << score << endl;
-                        
-                        if (score > best_score) {
-                            best_score = score;
-                            move.action_type = "THROW";
-                            move.target_x = enemy.x;
-                            move.target_y = enemy.y;
-                            move.confidence_score = 0.9; // High confidence for throwing
-                            move.reasoning = "Tactical splash attack";
-                        }
+                        int selected = select_child_ucb(t, current, agent_idx);
+                        if (selected == -1) break;
+                        // Virtual loss: a visit and a pessimistic score until backpropagation
+                        arena[selected].visits.fetch_add(1, memory_order_relaxed);
+                        atomic_add(arena[selected].total_score, -VIRTUAL_LOSS);
+                        t.current_nodes[agent_idx] = selected;
+                        orders[agent_idx] = issued_order(arena[selected].action);
                     }
                 }
+                t.engine.step(table, t.rollout, orders);
+            }
+            
+            for (int agent_idx = 0; agent_idx < (int)root_nodes.size(); agent_idx++) {
+                double score = evaluate_enhanced_game_state(table, t.rollout, agent_idx);
+                backpropagate(t, t.current_nodes[agent_idx], score, agent_idx);
             }
         }
-        
-        // PRIORITY 5: Movement (AGGRESSIVE COMBAT POSITIONING)
-        int dx[] = {-1, 1, 0, 0, -1, -1, 1, 1};
-        int dy[] = {0, 0, -1, 1, -1, 1, -1, 1};
-        
-        // Find closest enemy for targeting
-        int closest_enemy_dist = 999;
-        pair<int, int> closest_enemy_pos = {-1, -1};
-        for (const auto& enemy : temp_sim.enemy_agents) {
-            if (enemy.wetness < 100) {
-                int dist = manhattan_distance(agent.x, agent.y, enemy.x, enemy.y);
-                if (dist < closest_enemy_dist) {
-                    closest_enemy_dist = dist;
-                    closest_enemy_pos = {enemy.x, enemy.y};
-                }
+    }
+    
+    int completed_iterations(int max_iterations) const {
+        return min(iterations.load(memory_order_relaxed), max_iterations);
+    }
+    
+    // Copies every root and its first turn (movement and combat nodes) into
+    // plain nodes of the worker's arena, where the move selection reads them.
+    // No thread may be running.
+    void export_roots(SearchWorker& worker) const {
+        worker.reset((int)root_nodes.size());
+        for (int agent = 0; agent < (int)root_nodes.size(); agent++) {
+            const SharedSmitsimaxNode& root = arena[root_nodes[agent]];
+            SmitsimaxNode& copy = worker.arena[worker.root_nodes[agent]];
+            copy.visits = root.visits.load(memory_order_relaxed);
+            copy.total_score = root.total_score.load(memory_order_relaxed);
+            export_children(worker.arena, root, worker.root_nodes[agent]);
+            for (int c = 0; c < copy.child_count; c++) {
+                export_children(worker.arena, arena[root.first_child + c], copy.first_child + c);
             }
         }
+    }
+    
+private:
+    void export_children(NodeArena<SmitsimaxNode>& out, const SharedSmitsimaxNode& node, int copy_index) const {
+        int count = node.child_count.load(memory_order_acquire);
+        for (int c = 0; c < count; c++) {
+            const SharedSmitsimaxNode& child = arena[node.first_child + c];
+            int index = out.allocate();
+            if (index == NodeArena<SmitsimaxNode>::NONE) break;
+            out[index].init(copy_index, child.action, child.tactical_priority);
+            out[index].visits = child.visits.load(memory_order_relaxed);
+            out[index].total_score = child.total_score.load(memory_order_relaxed);
+            SmitsimaxNode& copy = out[copy_index];
+            if (copy.child_count == 0) copy.first_child = index;
+            copy.child_count++;
+        }
+    }
+    
+    // Everything a thread owns while descending the shared trees
+    struct ThreadState {
+        RolloutState rollout;
+        RulesEngine engine;
+        mt19937 gen;
+        NodeArena<SmitsimaxNode> scratch;  // create_tactical_moves output before it is published
+        int current_nodes[MAX_AGENTS];
+        double lowest_scores[MAX_AGENTS];
+        double highest_scores[MAX_AGENTS];
+        double scale_parameters[MAX_AGENTS];
+        
+        ThreadState(unsigned seed, int agent_count) : gen(seed), scratch(EXPANSION_SCRATCH_CAPACITY) {
+            for (int i = 0; i < agent_count; i++) {
+                lowest_scores[i] = 0.0;
+                highest_scores[i] = 0.0;
+                scale_parameters[i] = 1.0;
+            }
+        }
+    };
+    
+    // SearchWorker::select_child_ucb over atomic statistics
+    int select_child_ucb(ThreadState& t, int node_index, int agent_index) {
+        const SharedSmitsimaxNode& node = arena[node_index];
+        int count = node.child_count.load(memory_order_acquire);
+        if (count == 0) return -1;
+        int parent_visits = node.visits.load(memory_order_relaxed);
+        int offered = widened_child_count(parent_visits, count);
+        if (parent_visits < MIN_RANDOM_VISITS) {
+            uniform_int_distribution<> dis(0, offered - 1);
+            return node.first_child + dis(t.gen);
+        }
         
-        for (int i = 0; i < 8; i++) {
-            int nx = agent.x + dx[i];
-            int ny = agent.y + dy[i];
-            
-            if (nx >= 0 && nx < temp_sim.width && ny >= 0 && ny < temp_sim.height) {
-                // Check if position is free
-                bool blocked = false;
-                for (const auto& other : temp_sim.my_agents) {
-                    if (other.x == nx && other.y == ny && other.agent_id != agent.agent_id) {
-                        blocked = true;
-                        break;
-                    }
-                }
-                for (const auto& other : temp_sim.enemy_agents) {
-                    if (other.x == nx && other.y == ny) {
-                        blocked = true;
-                        break;
-                    }
-                }
-                
-                if (!blocked) {
-                    double strategic_score = evaluate_tile_strategic_value(nx, ny, temp_sim.width, temp_sim.height,
-                                                                        temp_sim.my_agents, temp_sim.enemy_agents, agent_class);
-                    
-                    // AGGRESSIVE COMBAT POSITIONING - prioritize getting in range
-                    double combat_positioning_score = 0.0;
-                    
-                    // Calculate improvement in combat potential
-                    for (const auto& enemy : temp_sim.enemy_agents) {
-                        if (enemy.wetness < 100) {
-                            int current_dist = manhattan_distance(agent.x, agent.y, enemy.x, enemy.y);
-                            int new_dist = manhattan_distance(nx, ny, enemy.x, enemy.y);
-                            
-                            // MASSIVE bonuses for getting into combat range
-                            if (new_dist <= data.optimal_range && current_dist > data.optimal_range) {
-                                combat_positioning_score += 800.0; // ENTERING SHOOTING RANGE = HUGE BONUS
-                            }
-                            if (new_dist <= data.optimal_range) {
-                                combat_positioning_score += 400.0; // STAYING IN RANGE
-                            }
-                            
-                            // Agent-specific range bonuses
-                            if (agent_class == SNIPER) {
-                                if (new_dist >= 4 && new_dist <= 6) combat_positioning_score += 600.0; // SNIPER optimal range
-                                if (new_dist > current_dist && current_dist < 4) combat_positioning_score += 300.0; // Get sniper distance
-                            }
-                            if (agent_class == BOMBER && new_dist <= 4) {
-                                combat_positioning_score += 500.0; // BOMBER in throw range
-                                if (new_dist <= 2) combat_positioning_score += 300.0; // Optimal bomber range
-                            }
-                            if (agent_class == BERSERKER && new_dist <= 2) {
-                                combat_positioning_score += 700.0; // BERSERKER close combat
-                            }
-                            
-                            // Direction bonus - move toward closest enemy
-                            if (closest_enemy_pos.first != -1) {
-                                int current_approach = manhattan_distance(agent.x, agent.y, closest_enemy_pos.first, closest_enemy_pos.second);
-                                int new_approach = manhattan_distance(nx, ny, closest_enemy_pos.first, closest_enemy_pos.second);
-                                if (new_approach < current_approach) {
-                                    combat_positioning_score += 200.0; // APPROACHING ENEMY
-                                }
-                            }
-                        }
-                    }
-                    
-                    // Combined scoring - combat positioning should compete with low-tier combat actions
-                    double combined_score = strategic_score * 50.0 + combat_positioning_score;
-                    
-                    // CRITICAL: Movement MUST never beat shooting/bombing - cap at 1400 max
-                    if (combined_score > 1400.0) {
-                        combined_score = 1400.0; // Ensure shooting (1500+) always beats movement
-                    }
-                    
-                    cerr << "      Move to (" << nx << "," << ny << ") strategic=" << strategic_score 
-                         << " combat_pos=" << combat_positioning_score << " total=" << combined_score << endl;
-                    
-                    if (combined_score > best_score) {
-                        best_score = combined_score;
-                        move.action_type = "MOVE";
-                        move.target_x = nx;
-                        move.target_y = ny;
-                        move.confidence_score = min(1.0, combined_score / 1400.0); // Scale to movement cap
-                        move.reasoning = (combat_positioning_score >= 400.0) ? "Aggressive approach for combat" : "Strategic positioning";
-                    }
+        int best_child = -1;
+        double best_ucb = -numeric_limits<double>::infinity();
+        for (int c = node.first_child; c < node.first_child + offered; c++) {
+            const SharedSmitsimaxNode& child = arena[c];
+            int visits = child.visits.load(memory_order_relaxed);
+            if (visits == 0) {
+                if (best_child == -1 || child.tactical_priority > arena[best_child].tactical_priority) {
+                    best_child = c;
                 }
+                continue;
+            }
+            
+            double avg_score = child.total_score.load(memory_order_relaxed) / visits;
+            double normalized_score = avg_score / (visits * t.scale_parameters[agent_index]);
+            double exploration = EXPLORATION_PARAM * sqrt(log(parent_visits)) * (1.0 / sqrt(visits));
+            double ucb = normalized_score + exploration + child.tactical_priority * 0.3;
+            if (ucb > best_ucb) {
+                best_ucb = ucb;
+                best_child = c;
             }
         }
-        
-        // Default to hunker down if no good options
-        if (move.action_type.empty()) {
-            move.action_type = "HUNKER_DOWN";
-            move.confidence_score = 0.1;
-            move.reasoning = "Safe defensive option";
+        return best_child;
+    }
+    
+    // The winner of the claim builds the children in its scratch arena, copies
+    // them into a freshly claimed range and publishes the count
+    void expand_node(const AgentTable& table, ThreadState& t, int node_index, int agent_index, int level) {
+        SharedSmitsimaxNode& node = arena[node_index];
+        if (!claim_expansion(node.expand_state)) return;
+        
+        t.scratch.reset();
+        bool at_root = level == 0 ? node.parent == -1 : arena[node.parent].parent == -1;
+        int count = create_tactical_moves(table, t.rollout, agent_index, level, node.action, t.engine, t.scratch, node_index, at_root);
+        if (count == 0) return;
+        int first = arena.allocate_range(count);
+        if (first == SharedNodeArena<SharedSmitsimaxNode>::NONE) return;
+        for (int c = 0; c < count; c++) {
+            arena[first + c].init(node_index, t.scratch[c].action, t.scratch[c].tactical_priority);
         }
-        
-        cerr << "    DECISION: " << move.action_type;
-        if (move.action_type == "SHOOT") cerr << " target:" << move.target_agent_id;
-        if (move.action_type == "MOVE") cerr << " to:(" << move.target_x << "," << move.target_y << ")";
-        if (move.action_type == "THROW") cerr << " at:(" << move.target_x << "," << move.target_y << ")";
-        cerr << " confidence:" << move.confidence_score << endl;
-        
-        return move;
+        node.first_child = first;
+        node.child_count.store(count, memory_order_release);
     }
     
-    // Fast lookup for pre-computed moves - ALWAYS COMPUTE FRESH FOR ACCURACY
-    vector<PrecomputedMove> get_cached_moves(const vector<AgentState>& my_agents, const vector<AgentState>& enemy_agents) {
-        cerr << "COMPUTING FRESH MOVES: Analyzing current battlefield state" << endl;
-        
-        // ALWAYS compute fresh moves for accuracy - no bad cache matches
-        vector<PrecomputedMove> moves;
-        for (int i = 0; i < my_agents.size(); i++) {
-            PrecomputedMove move;
-            if (my_agents[i].wetness < 100) {
-                // Agent is ALIVE - compute best move with current state
-                SimulationState fresh_sim = sim;
-                fresh_sim.my_agents = my_agents;
-                fresh_sim.enemy_agents = enemy_agents;
-                move = compute_best_move_quick(my_agents[i], fresh_sim, i);
-                cerr << "Agent " << my_agents[i].agent_id << " ALIVE: Computed " << move.action_type 
-                     << " (confidence:" << move.confidence_score << ")" << endl;
-            } else {
-                // Agent is DEAD
-                move.action_type = "HUNKER_DOWN";
-                move.confidence_score = 0.0;
-                move.reasoning = "Agent dead";
-                cerr << "Agent " << my_agents[i].agent_id << " DEAD: Default HUNKER_DOWN" << endl;
-            }
-            moves.push_back(move);
+    void backpropagate(ThreadState& t, int node_index, double score, int agent_index) {
+        t.lowest_scores[agent_index] = min(t.lowest_scores[agent_index], score);
+        t.highest_scores[agent_index] = max(t.highest_scores[agent_index], score);
+        t.scale_parameters[agent_index] = max(1.0, t.highest_scores[agent_index] - t.lowest_scores[agent_index]);
+        
+        while (node_index != -1) {
+            SharedSmitsimaxNode& node = arena[node_index];
+            node.visits.fetch_add(1, memory_order_relaxed);
+            // Every node below a root was selected on the way down and carries
+            // this thread's virtual loss
+            atomic_add(node.total_score, node.parent == -1 ? score : score + VIRTUAL_LOSS);
+            node_index = node.parent;
         }
-        
-        return moves;
     }
+};
+
+enum SearchParallelism {
+    ROOT_PARALLEL, // A tree set per thread, root statistics merged at the deadline
+    TREE_PARALLEL  // One tree set descended by every thread
+};
+
+// Smitsimax search over one tree per agent
+class MergedSmitsimaxSearch {
+private:
+    SimulationState sim;
+    
+    random_device rd;
+    
+    // Root-parallel workers
+    vector<unique_ptr<SearchWorker>> workers;
+    int thread_count = 1;
+    SearchParallelism parallelism = ROOT_PARALLEL;
+    RootMergePolicy merge_policy = ROOT_MERGE_SUM;
+    unique_ptr<SharedSmitsimaxTrees> shared_trees; // Built on first tree-parallel search
+    int last_iterations = 0;
+    
+    // Tree reuse across turns: what the last search_original grew from, and
+    // the orders played from there (the tree's action, and what the referee
+    // actually applied)
+    bool reuse_trees = true;
+    bool trees_fresh = false;
+    bool trees_reused = false; // Whether this turn's initialize() promoted them
+    int previous_ids[MAX_AGENTS];
+    PackedAction played_actions[MAX_AGENTS];
+    PackedAction issued_orders[MAX_AGENTS];
+    bool played_known[MAX_AGENTS] = {};
+    RulesEngine replay_engine;
+    
+    const OpeningBook* opening_book = nullptr; // Consulted before searching
+    
+public:
+    MergedSmitsimaxSearch() {
+        workers.emplace_back(new SearchWorker(rd()));
+    }
+    
+    // Worker threads for search_original, whether they share one tree set,
+    // and how root-parallel statistics merge
+    void set_parallelism(int threads, SearchParallelism mode, RootMergePolicy policy = ROOT_MERGE_SUM) {
+        thread_count = max(1, threads);
+        parallelism = mode;
+        merge_policy = policy;
+    }
+    
+    int iterations_last_search() const { return last_iterations; }
+    
+    void set_opening_book(const OpeningBook* book) { opening_book = book; }
+    
+    // The position initialize() set up, as the rules engine sees it
+    const AgentTable& rules_table() const { return sim.table; }
+    const RolloutState& root_state() const { return sim.root; }
+    
+    void set_tree_reuse(bool enabled) { reuse_trees = enabled; }
+    bool reused_last_turn() const { return trees_reused; }
     
-    // Calculate similarity between game scenarios
-    double calculate_scenario_similarity(const GameStateKey& key1, const GameStateKey& key2) {
-        if (key1.my_positions.size() != key2.my_positions.size() ||
-            key1.enemy_positions.size() != key2.enemy_positions.size()) {
-            return 0.0;
+    // Visits behind an agent's root in the main worker's trees; a promoted
+    // root keeps those of the combat node it was played from
+    int root_visits(int agent_index) const {
+        const SearchWorker& main = *workers[0];
+        return main.arena[main.root_nodes[agent_index]].visits;
+    }
+    
+    // My agent's move this turn: the tree action it came from and the order
+    // the referee will apply, which differ when the output adds commands
+    void note_played(int agent_index, PackedAction action, PackedAction issued) {
+        if (agent_index < 0 || agent_index >= MAX_AGENTS) return;
+        played_actions[agent_index] = action;
+        issued_orders[agent_index] = issued;
+        played_known[agent_index] = true;
+    }
+    
+    // Nodes in the largest single tree set the last search_original grew:
+    // the shared one, or the biggest worker's
+    size_t tree_nodes_last_search() const {
+        if (parallelism == TREE_PARALLEL && shared_trees) return shared_trees->arena.size();
+        size_t largest = 0;
+        for (int w = 0; w < thread_count && w < (int)workers.size(); w++) {
+            largest = max(largest, workers[w]->arena.size());
         }
-        
-        double similarity = 0.0;
-        int comparisons = 0;
-        
-        // Compare agent positions and states
-        for (int i = 0; i < key1.my_positions.size(); i++) {
-            int pos1 = key1.my_positions[i].second;
-            int pos2 = key2.my_positions[i].second;
-            
-            int x1 = pos1 / 1000, y1 = (pos1 % 1000) / 100, h1 = (pos1 % 100) / 10;
-            int x2 = pos2 / 1000, y2 = (pos2 % 1000) / 100, h2 = (pos2 % 100) / 10;
-            
-            double pos_sim = 1.0 - (manhattan_distance(x1, y1, x2, y2) / 20.0);
-            double health_sim = 1.0 - abs(h1 - h2) / 10.0;
-            
-            similarity += max(0.0, (pos_sim + health_sim) / 2.0);
-            comparisons++;
+        return largest;
+    }
+    
+    // The book's compound orders for my agents (as many as MAX_AGENTS) when it
+    // holds this exact position
+    bool book_orders(PackedAction* orders) const {
+        int visits = 0;
+        if (!opening_book || !opening_book->probe(sim.table, sim.root, orders, &visits)) return false;
+        cerr << "Opening book hit: " << visits << " visits behind every order" << endl;
+        return true;
+    }
+    
+    // Root move ordering from the opening book's nearest positions: each of
+    // my agents gets the action its neighbours chose most, weighted by
+    // closeness, with a bonus in proportion to that action's share of the vote.
+    // The live search reads it when it expands fresh roots. Without a book
+    // (the submission carries none) every bonus is zero, and promoted roots
+    // keep the order they were expanded with.
+    void set_book_priors() {
+        for (int slot = 0; slot < MAX_AGENTS; slot++) {
+            sim.table.prior_action[slot] = PackedAction::hunker_down();
+            sim.table.prior_bonus[slot] = 0.0f;
         }
-        
-        return comparisons > 0 ? similarity / comparisons : 0.0;
+        if (!opening_book) return;
+        BookNeighbour neighbours[BOOK_PRIOR_NEIGHBOURS];
+        int found = opening_book->nearest(sim.table, sim.root, BOOK_PRIOR_NEIGHBOURS, neighbours);
+        if (found == 0) return;
+        
+        for (int slot = 0; slot < sim.root.my_count; slot++) {
+            double total = 0.0, best = 0.0;
+            for (int n = 0; n < found; n++) {
+                double vote = 0.0;
+                for (int m = 0; m < found; m++) {
+                    if (neighbours[m].actions[slot] == neighbours[n].actions[slot]) vote += 1.0 / (1.0 + neighbours[m].distance);
+                }
+                total += 1.0 / (1.0 + neighbours[n].distance);
+                if (vote > best) {
+                    best = vote;
+                    sim.table.prior_action[slot] = issued_order(neighbours[n].actions[slot]);
+                }
+            }
+            sim.table.prior_bonus[slot] = (float)(BOOK_PRIOR_WEIGHT * best / total);
+        }
+        cerr << "BOOK PRIORS: " << found << " neighbour(s), nearest at squared distance " << neighbours[0].distance << endl;
     }
     
     void initialize(const vector<AgentState>& my_agents, const vector<AgentState>& enemy_agents,
-                   const unordered_map<int, AgentData>& agent_data, int width, int height) {
-        
-        // Clean up previous trees
-        for (auto* root : root_nodes) {
-            delete root;
-        }
-        root_nodes.clear();
+                   const unordered_map<int, AgentData>& agent_data, const BoardLayers& board) {
+        int width = board.geo.width, height = board.geo.height;
+        RolloutState previous_root = sim.root;
+        for (int slot = 0; slot < sim.root.count; slot++) previous_ids[slot] = sim.table.agent_id[slot];
         
         // Setup simulation state
         sim.my_agents = my_agents;
@@ -1106,304 +1142,253 @@ public:
         sim.width = width;
         sim.height = height;
         
-        // Create root nodes for each agent
-        int total_agents = my_agents.size() + enemy_agents.size();
-        root_nodes.resize(total_agents);
-        sim.current_nodes.resize(total_agents);
-        sim.lowest_scores.resize(total_agents, 0.0);
-        sim.highest_scores.resize(total_agents, 0.0);
-        sim.scale_parameters.resize(total_agents, 1.0);
+        // Slot tables for rollouts. The turn input already has this turn's
+        // cooldowns ticked, which is the state the rules engine starts from.
+        sim.root = make_rollout_state(my_agents, enemy_agents);
+        sim.table.width = width;
+        sim.table.height = height;
+        sim.table.set_board(board);
+        for (int slot = 0; slot < sim.root.count; slot++) {
+            const AgentState& agent = sim.root.is_mine(slot) ? my_agents[slot] : enemy_agents[slot - sim.root.my_count];
+            const AgentData& data = agent_data.at(agent.agent_id);
+            sim.table.agent_id[slot] = agent.agent_id;
+            sim.table.shoot_cooldown[slot] = data.shoot_cooldown;
+            sim.table.optimal_range[slot] = data.optimal_range;
+            sim.table.soaking_power[slot] = data.soaking_power;
+            sim.table.agent_class[slot] = data.agent_class;
+        }
+        set_book_priors();
         
-        for (int i = 0; i < total_agents; i++) {
-            root_nodes[i] = new SmitsimaxNode();
-            sim.current_nodes[i] = root_nodes[i];
+        // Keep last turn's subtrees when the turn went as observed, otherwise
+        // drop them in O(1)
+        trees_reused = reuse_trees && trees_fresh && promote_trees(previous_root);
+        if (!trees_reused) {
+            for (auto& worker : workers) worker->reset(0);
         }
+        trees_fresh = false;
+        for (int i = 0; i < MAX_AGENTS; i++) played_known[i] = false;
     }
     
-    SmitsimaxNode* select_child_ucb(SmitsimaxNode* node, int agent_index) {
-        if (node->children.empty()) return nullptr;
-        if (node->visits < MIN_RANDOM_VISITS) {
-            // Random selection for first few visits to avoid resonance
-            uniform_int_distribution<> dis(0, node->children.size() - 1);
-            return node->children[dis(gen)];
+    // The enemies' moves are not observed directly. For each enemy, the
+    // compound orders below its root that explain its own position, cooldown
+    // and balloons (others idle) are candidates; the first combination that
+    // replays last turn's root into exactly this turn's input is taken as
+    // what happened.
+    bool promote_trees(const RolloutState& previous) {
+        const SearchWorker& main = *workers[0];
+        int n = sim.root.count, my_count = sim.root.my_count;
+        if ((int)main.root_nodes.size() != n || previous.count != n || previous.my_count != my_count) return false;
+        for (int slot = 0; slot < n; slot++) {
+            if (previous_ids[slot] != sim.table.agent_id[slot]) return false;
+            if (slot < my_count && !played_known[slot]) return false;
         }
         
-        // UCB selection with tactical priority integration
-        SmitsimaxNode* best_child = nullptr;
-        double best_ucb = -numeric_limits<double>::infinity();
-        
-        for (auto* child : node->children) {
-            if (child->visits == 0) {
-                // Unvisited nodes get infinite priority, but prefer tactically sound moves
-                if (best_child == nullptr || child->tactical_priority > best_child->tactical_priority) {
-                    best_child = child;
+        PackedAction orders[MAX_AGENTS];
+        for (int slot = 0; slot < n; slot++) {
+            orders[slot] = slot < my_count ? issued_orders[slot] : PackedAction::move(previous.x[slot], previous.y[slot]);
+        }
+        vector<PackedAction> candidates[MAX_AGENTS];
+        for (int e = my_count; e < n; e++) {
+            const SmitsimaxNode& root = main.arena[main.root_nodes[e]];
+            for (int m = root.first_child; m < root.first_child + root.child_count; m++) {
+                const SmitsimaxNode& movement = main.arena[m];
+                for (int c = movement.first_child; c < movement.first_child + movement.child_count; c++) {
+                    PackedAction trial[MAX_AGENTS];
+                    memcpy(trial, orders, sizeof(trial));
+                    trial[e] = main.arena[c].action;
+                    RolloutState next = previous;
+                    replay_engine.step(sim.table, next, trial);
+                    if (next.x[e] == sim.root.x[e] && next.y[e] == sim.root.y[e] && next.cooldown[e] == sim.root.cooldown[e]
+                        && next.splash_bombs[e] == sim.root.splash_bombs[e]) {
+                        candidates[e].push_back(main.arena[c].action);
+                    }
                 }
-                continue;
-            }
-            
-            double avg_score = child->get_average_score();
-            double normalized_score = avg_score / (child->visits * sim.scale_parameters[agent_index]);
-            double exploration = EXPLORATION_PARAM * sqrt(log(node->visits)) * (1.0 / sqrt(child->visits));
-            double tactical_bonus = child->tactical_priority * 0.3; // Blend tactical evaluation
-            double ucb = normalized_score + exploration + tactical_bonus;
-            
-            if (ucb > best_ucb) {
-                best_ucb = ucb;
-                best_child = child;
             }
+            if (candidates[e].empty()) return false;
         }
         
-        return best_child;
+        // Odometer over the candidate lists, bounded
+        int pick[MAX_AGENTS] = {};
+        for (int tried = 0; tried < MAX_REPLAY_COMBINATIONS; tried++) {
+            for (int e = my_count; e < n; e++) orders[e] = candidates[e][pick[e]];
+            RolloutState next = previous;
+            replay_engine.step(sim.table, next, orders);
+            bool same = true;
+            for (int slot = 0; slot < n && same; slot++) {
+                same = next.x[slot] == sim.root.x[slot] && next.y[slot] == sim.root.y[slot]
+                    && next.cooldown[slot] == sim.root.cooldown[slot]
+                    && next.splash_bombs[slot] == sim.root.splash_bombs[slot]
+                    && next.wetness[slot] == sim.root.wetness[slot];
+            }
+            if (same) {
+                PackedAction actions[MAX_AGENTS];
+                for (int slot = 0; slot < n; slot++) actions[slot] = slot < my_count ? played_actions[slot] : orders[slot];
+                int promoted = 0;
+                for (int w = 0; w < (int)workers.size(); w++) {
+                    if (w < thread_count && (int)workers[w]->root_nodes.size() == n && workers[w]->promote(actions)) {
+                        promoted++;
+                    } else {
+                        workers[w]->reset(0);
+                    }
+                }
+                cerr << "Tree reuse: promoted last turn's subtrees in " << promoted << " worker(s), "
+                     << workers[0]->arena.size() << " nodes kept" << endl;
+                return promoted > 0;
+            }
+            int e = my_count;
+            while (e < n && ++pick[e] == (int)candidates[e].size()) pick[e++] = 0;
+            if (e == n) break;
+        }
+        cerr << "Tree reuse: observed turn diverges from the trees, rebuilding" << endl;
+        return false;
     }
     
-    void expand_node(SmitsimaxNode* node, int agent_index) {
-        if (!node->children.empty()) return;
-        
-        bool is_my_agent = agent_index < sim.my_agents.size();
-        const vector<AgentState>& agents = is_my_agent ? sim.my_agents : sim.enemy_agents;
-        int actual_index = is_my_agent ? agent_index : agent_index - sim.my_agents.size();
-        
-        if (actual_index < agents.size()) {
-            vector<SmitsimaxNode*> moves = create_tactical_moves(agents[actual_index], sim, is_my_agent);
-            for (auto* move : moves) {
-                move->parent = node;
-                node->children.push_back(move);
+    // Folds the children of the same node in workers 1.. (others[w], -1 when
+    // that worker has none) into worker 0's node, down `levels` levels
+    void merge_children(int node_index, const int* others, int levels) {
+        SearchWorker& main = *workers[0];
+        const SmitsimaxNode& node = main.arena[node_index];
+        vector<int> other_children(thread_count, -1);
+        for (int c = 0; c < node.child_count; c++) {
+            SmitsimaxNode& child = main.arena[node.first_child + c];
+            RootChildMerge merged(merge_policy);
+            merged.add(child.visits, child.total_score);
+            for (int w = 1; w < thread_count; w++) {
+                other_children[w] = -1;
+                if (others[w] < 0) continue;
+                const SearchWorker& other = *workers[w];
+                const SmitsimaxNode& other_node = other.arena[others[w]];
+                if (other_node.child_count != node.child_count) continue;
+                const SmitsimaxNode& other_child = other.arena[other_node.first_child + c];
+                if (other_child.action != child.action) continue;
+                merged.add(other_child.visits, other_child.total_score);
+                other_children[w] = other_node.first_child + c;
             }
+            if (levels > 1) merge_children(node.first_child + c, other_children.data(), levels - 1);
+            child.visits = merged.merged_visits();
+            child.total_score = merged.merged_score_sum();
         }
     }
     
-    void backpropagate(SmitsimaxNode* node, double score, int agent_index) {
-        while (node != nullptr) {
-            node->visits++;
-            node->total_score += score;
-            
-            // Update normalization parameters
-            if (score < sim.lowest_scores[agent_index]) {
-                sim.lowest_scores[agent_index] = score;
-            }
-            if (score > sim.highest_scores[agent_index]) {
-                sim.highest_scores[agent_index] = score;
+    // Folds the first turn of workers 1.. (movement and combat nodes) into
+    // worker 0's trees, which the move selection reads
+    void merge_worker_roots() {
+        if (thread_count == 1) return;
+        SearchWorker& main = *workers[0];
+        vector<int> other_roots(thread_count, -1);
+        for (int agent = 0; agent < (int)main.root_nodes.size(); agent++) {
+            for (int w = 1; w < thread_count; w++) other_roots[w] = workers[w]->root_nodes[agent];
+            merge_children(main.root_nodes[agent], other_roots.data(), TREE_LEVELS_PER_TURN);
+            SmitsimaxNode& root = main.arena[main.root_nodes[agent]];
+            for (int w = 1; w < thread_count; w++) {
+                root.visits += workers[w]->arena[workers[w]->root_nodes[agent]].visits;
             }
-            
-            double range = sim.highest_scores[agent_index] - sim.lowest_scores[agent_index];
-            sim.scale_parameters[agent_index] = max(1.0, range);
-            
-            node = node->parent;
         }
     }
     
-    vector<SmitsimaxNode*> search(int max_time_ms = MAX_SIMULATION_TIME) {
-        cerr << "=== USING PRE-COMPUTED CACHE SYSTEM ===" << endl;
-        
-        // Calculate current territorial control
-        auto [my_controlled, enemy_controlled] = calculate_controlled_area(sim.my_agents, sim.enemy_agents, sim.width, sim.height);
-        double total_tiles = sim.width * sim.height;
-        double my_control_percent = (my_controlled / total_tiles) * 100.0;
-        double enemy_control_percent = (enemy_controlled / total_tiles) * 100.0;
-        
-        cerr << "TERRITORIAL CONTROL: My=" << my_controlled << "(" << my_control_percent << "%) "
-             << "Enemy=" << enemy_controlled << "(" << enemy_control_percent << "%) "
-             << "Neutral=" << (total_tiles - my_controlled - enemy_controlled) << endl;
-        
-        // Try cache lookup first
-        vector<PrecomputedMove> cached_moves = get_cached_moves(sim.my_agents, sim.enemy_agents);
-        
-        // Convert cached moves to SmitsimaxNode format
-        vector<SmitsimaxNode*> result_moves;
-        
-        for (int i = 0; i < sim.my_agents.size(); i++) {
-            SmitsimaxNode* move_node = new SmitsimaxNode();
-            
-            if (i < cached_moves.size()) {
-                PrecomputedMove& cached = cached_moves[i];
-                move_node->action_type = cached.action_type;
-                move_node->target_x = cached.target_x;
-                move_node->target_y = cached.target_y;
-                move_node->target_agent_id = cached.target_agent_id;
-                move_node->tactical_priority = cached.confidence_score;
-                move_node->visits = 100; // High confidence indicator
-                move_node->total_score = cached.confidence_score * 100;
-                
-                cerr << "Agent " << sim.my_agents[i].agent_id << " CACHED: " << cached.action_type;
-                if (cached.action_type == "SHOOT") cerr << " target:" << cached.target_agent_id;
-                if (cached.action_type == "MOVE") cerr << " to:(" << cached.target_x << "," << cached.target_y << ")";
-                cerr << " (confidence:" << cached.confidence_score << " reason:" << cached.reasoning << ")" << endl;
-            } else {
-                // Fallback
-                move_node->action_type = "HUNKER_DOWN";
-                move_node->tactical_priority = 0.1;
-                move_node->visits = 1;
-                cerr << "Agent " << sim.my_agents[i].agent_id << " FALLBACK: HUNKER_DOWN" << endl;
-            }
-            
-            result_moves.push_back(move_node);
+    // Live agents over the most a game can have, for TimeManager::search_deadline
+    double position_complexity() const {
+        int live = 0;
+        for (int slot = 0; slot < sim.root.count; slot++) {
+            if (sim.root.wetness[slot] < 100) live++;
         }
-        
-        cerr << "=== INSTANT CACHE LOOKUP COMPLETE ===" << endl;
-        return result_moves;
+        return (double)live / MAX_AGENTS;
+    }
+    
+    // Fixed-budget search from now for offline tools, clock read every 250 us
+    // at most; live turns pass the TimeManager's deadline instead
+    vector<SmitsimaxNode*> search_original(int max_time_ms) {
+        return search_original(TimeManager::Clock::now() + chrono::milliseconds(max_time_ms), chrono::microseconds(250));
     }
     
-    // Original search method renamed for backup use
-    vector<SmitsimaxNode*> search_original(int max_time_ms = MAX_SIMULATION_TIME) {
+    // Grows every agent's tree until the deadline and returns, per agent, the
+    // combat node under its best movement: a compound MOVE+combat order
+    vector<SmitsimaxNode*> search_original(TimeManager::Clock::time_point deadline,
+                                           TimeManager::Clock::duration check_interval) {
         auto start_time = chrono::high_resolution_clock::now();
         
-        cerr << "=== MERGED SMITSIMAX + TACTICAL SEARCH ===" << endl;
-        cerr << "Searching with " << root_nodes.size() << " agent trees (enhanced tactical evaluation)" << endl;
-        
         int iterations = 0;
-        
-        while (true) {
-            auto current_time = chrono::high_resolution_clock::now();
-            auto elapsed = chrono::duration_cast<chrono::milliseconds>(current_time - start_time);
-            if (elapsed.count() >= max_time_ms) {
-                cerr << "Search timeout reached at " << elapsed.count() << "ms" << endl;
-                break;
-            }
-            
-            // Safety check to prevent infinite loops
-            if (iterations > 10000) {
-                cerr << "Maximum iterations reached: " << iterations << endl;
-                break;
-            }
-            
-            // Reset simulation to base state
-            sim.reset_to_base_state(sim.my_agents, sim.enemy_agents);
-            
-            // Selection and simulation phase
-            for (int depth = 0; depth < MAX_SEARCH_DEPTH; depth++) {
-                // Process each agent
-                for (int agent_idx = 0; agent_idx < root_nodes.size(); agent_idx++) {
-                    SmitsimaxNode* current = sim.current_nodes[agent_idx];
-                    
-                    // Expand if needed
-                    if (current->visits == 1) {
-                        expand_node(current, agent_idx);
-                    }
-                    
-                    // Select child
-                    if (!current->children.empty()) {
-                        SmitsimaxNode* selected = select_child_ucb(current, agent_idx);
-                        if (selected) {
-                            selected->visits++;
-                            sim.current_nodes[agent_idx] = selected;
-                            
-                            // Apply the move
-                            bool is_my_agent = agent_idx < sim.my_agents.size();
-                            int actual_index = is_my_agent ? agent_idx : agent_idx - sim.my_agents.size();
-                            apply_action(sim, actual_index, is_my_agent);
-                        }
-                    }
-                }
-            }
-            
-            // Enhanced evaluation and backpropagation
-            for (int agent_idx = 0; agent_idx < root_nodes.size(); agent_idx++) {
-                bool is_my_agent = agent_idx < sim.my_agents.size();
-                int actual_index = is_my_agent ? agent_idx : agent_idx - sim.my_agents.size();
-                
-                double score = evaluate_enhanced_game_state(sim, actual_index, is_my_agent);
-                backpropagate(sim.current_nodes[agent_idx], score, agent_idx);
-            }
-            
-            // Reset current nodes to roots for next iteration
-            for (int i = 0; i < root_nodes.size(); i++) {
-                sim.current_nodes[i] = root_nodes[i];
+        if (parallelism == TREE_PARALLEL) {
+            // Every thread descends the same trees; worker 0 receives the roots
+            if (!shared_trees) shared_trees.reset(new SharedSmitsimaxTrees());
+            shared_trees->reset(sim.root.count);
+            vector<unsigned> seeds(thread_count);
+            for (unsigned& seed : seeds) seed = rd();
+            int max_iterations = MAX_WORKER_ITERATIONS * thread_count;
+            run_root_workers(thread_count, [&](int w) {
+                shared_trees->run(sim.table, sim.root, seeds[w], max_iterations, SearchClock(deadline, check_interval));
+            });
+            iterations = shared_trees->completed_iterations(max_iterations);
+            shared_trees->export_roots(*workers[0]);
+        } else {
+            // Each worker gets its own trees and an independent RNG
+            while ((int)workers.size() < thread_count) workers.emplace_back(new SearchWorker(rd()));
+            // Workers that promoted last turn's trees keep them. The arena a
+            // promotion copies into is built here, inside this search's
+            // budget, rather than on the first turn that reuses trees.
+            for (int w = 0; w < thread_count; w++) {
+                if ((int)workers[w]->root_nodes.size() != sim.root.count) workers[w]->reset(sim.root.count);
+                if (reuse_trees) workers[w]->reserve_spare();
             }
+            run_root_workers(thread_count, [&](int w) {
+                workers[w]->run(sim.table, sim.root, SearchClock(deadline, check_interval));
+            });
             
-            iterations++;
+            for (int w = 0; w < thread_count; w++) iterations += workers[w]->iterations;
+            merge_worker_roots();
         }
+        last_iterations = iterations;
+        trees_fresh = parallelism == ROOT_PARALLEL;
+        
+        auto elapsed = chrono::duration_cast<chrono::milliseconds>(chrono::high_resolution_clock::now() - start_time);
+        cerr << "Search: " << iterations << " iterations on " << thread_count << " thread(s) in "
+             << elapsed.count() << "ms" << endl;
         
-        cerr << "Merged search completed " << iterations << " iterations in " 
-             << max_time_ms << "ms" << endl;
+        NodeArena<SmitsimaxNode>& arena = workers[0]->arena;
+        const vector<int>& root_nodes = workers[0]->root_nodes;
         
         // Select best moves using combined scoring
         vector<SmitsimaxNode*> best_moves;
-        for (int i = 0; i < sim.my_agents.size(); i++) {
-            SmitsimaxNode* root = root_nodes[i];
+        for (int i = 0; i < sim.root.my_count; i++) {
+            // The best movement, then the best combat from there
             SmitsimaxNode* best_child = nullptr;
-            double best_combined_score = -numeric_limits<double>::infinity();
-            
-            const AgentState& agent = sim.my_agents[i];
-            AgentClass ac = sim.agent_data[agent.agent_id].agent_class;
-            string class_name = (ac == SNIPER ? "SNIPER" : ac == BOMBER ? "BOMBER" : 
-                               ac == BERSERKER ? "BERSERKER" : ac == ASSAULT ? "ASSAULT" : "GUNNER");
-            
-            cerr << "Agent " << agent.agent_id << " (" << class_name << ") merged analysis:" << endl;
-            
-            for (auto* child : root->children) {
-                double smitsimax_score = child->get_average_score();
-                double tactical_score = child->tactical_priority;
-                double visit_confidence = min(1.0, child->visits / 30.0);
-                
-                // Combined score: 60% Smitsimax + 40% Tactical Priority
-                double combined_score = (smitsimax_score * 0.6 + tactical_score * 40 * 0.4) * visit_confidence;
-                
-                cerr << "  " << child->action_type;
-                if (child->action_type == "SHOOT") cerr << " target:" << child->target_agent_id;
-                if (child->action_type == "MOVE") cerr << " to:(" << child->target_x << "," << child->target_y << ")";
-                if (child->action_type == "THROW") cerr << " at:(" << child->target_x << "," << child->target_y << ")";
-                cerr << " -> visits:" << child->visits << " smitsimax:" << smitsimax_score 
-                     << " tactical:" << tactical_score << " combined:" << combined_score << endl;
-                
-                if (combined_score > best_combined_score) {
-                    best_combined_score = combined_score;
-                    best_child = child;
-                }
-            }
-            
-            best_moves.push_back(best_child);
-            
-            if (best_child) {
-                cerr << "*** BEST MERGED DECISION: " << best_child->action_type 
-                     << " (combined_score:" << best_combined_score << ") ***" << endl;
-            } else {
-                cerr << "*** NO MOVE SELECTED - DEFAULTING TO HUNKER_DOWN ***" << endl;
-            }
-        }
-        
-        // Opponent prediction analysis
-        cerr << endl << "=== OPPONENT PREDICTION ANALYSIS ===" << endl;
-        for (int i = sim.my_agents.size(); i < root_nodes.size(); i++) {
-            SmitsimaxNode* enemy_root = root_nodes[i];
-            SmitsimaxNode* predicted_enemy_move = nullptr;
-            double best_enemy_score = -numeric_limits<double>::infinity();
-            
-            int enemy_index = i - sim.my_agents.size();
-            if (enemy_index < sim.enemy_agents.size()) {
-                cerr << "Enemy " << sim.enemy_agents[enemy_index].agent_id << " prediction:" << endl;
-                
-                for (auto* child : enemy_root->children) {
-                    double avg_score = child->get_average_score();
-                    cerr << "  Likely: " << child->action_type;
-                    if (child->action_type == "SHOOT") cerr << " target:" << child->target_agent_id;
-                    if (child->action_type == "MOVE") cerr << " to:(" << child->target_x << "," << child->target_y << ")";
-                    cerr << " (visits:" << child->visits << " score:" << avg_score << ")" << endl;
+            const SmitsimaxNode* parent = &arena[root_nodes[i]];
+            for (int level = 0; level < TREE_LEVELS_PER_TURN; level++) {
+                SmitsimaxNode* level_best = nullptr;
+                double level_best_score = -numeric_limits<double>::infinity();
+                for (int c = parent->first_child; c < parent->first_child + parent->child_count; c++) {
+                    SmitsimaxNode* child = &arena[c];
+                    if (child->visits == 0) continue; // Never widened to
+                    double smitsimax_score = child->get_average_score();
+                    double tactical_score = child->tactical_priority;
+                    double visit_confidence = min(1.0, child->visits / 30.0);
                     
-                    if (avg_score > best_enemy_score) {
-                        best_enemy_score = avg_score;
-                        predicted_enemy_move = child;
-                    }
-                }
-                
-                if (predicted_enemy_move) {
-                    cerr << "  *** MOST LIKELY: " << predicted_enemy_move->action_type;
-                    if (predicted_enemy_move->action_type == "SHOOT") {
-                        cerr << " targeting agent " << predicted_enemy_move->target_agent_id;
+                    // Combined score: 60% Smitsimax + 40% Tactical Priority
+                    double combined_score = (smitsimax_score * 0.6 + tactical_score * 40 * 0.4) * visit_confidence;
+                    
+                    if (combined_score > level_best_score) {
+                        level_best_score = combined_score;
+                        level_best = child;
                     }
-                    cerr << " ***" << endl;
                 }
+                if (!level_best) break;
+                best_child = level_best;
+                parent = level_best;
             }
+            
+            best_moves.push_back(best_child);
         }
         
-        cerr << "=== MERGED SEARCH END ===" << endl;
-        
         return best_moves;
     }
 };
 
 int main() {
+    // The first turn's clock starts with the first input
+    TimeManager timer;
     int my_id;
     cin >> my_id;
+    timer.begin_game();
     cin.ignore();
     
     int agent_data_count;
@@ -1434,55 +1419,49 @@ int main() {
     cin >> width >> height;
     cin.ignore();
     
-    // Skip map data for now (can be added later if needed)
+    // Map tiles go straight into the bitboard layers
+    BoardLayers board;
+    board.init(width, height);
     for (int i = 0; i < height; i++) {
         for (int j = 0; j < width; j++) {
             int x, y, tile_type;
             cin >> x >> y >> tile_type;
             cin.ignore();
+            board.set_tile(x, y, tile_type);
         }
     }
     
     MergedSmitsimaxSearch search;
-    
-    cerr << "=== INITIALIZING PRE-COMPUTATION SYSTEM ===" << endl;
-    cerr << "Building prediction cache before game starts..." << endl;
-    
-    // Initialize search with dummy data to build cache
-    vector<AgentState> initial_my, initial_enemy;
-    for (int id : my_agent_ids) {
-        AgentState agent;
-        agent.agent_id = id;
-        agent.x = 0; agent.y = 0; agent.cooldown = 0; agent.splash_bombs = all_agents_data[id].splash_bombs;
-        agent.wetness = 50; // Mid health for cache building
-        initial_my.push_back(agent);
+    // Offline analysis runs can give search_original more cores, with
+    // SMITSIMAX_PARALLEL=tree to have them share one tree set
+    if (const char* threads = getenv("SMITSIMAX_THREADS")) {
+        const char* mode = getenv("SMITSIMAX_PARALLEL");
+        bool tree = mode && string(mode) == "tree";
+        search.set_parallelism(atoi(threads), tree ? TREE_PARALLEL : ROOT_PARALLEL);
     }
-    for (int id : enemy_agent_ids) {
-        AgentState agent;
-        agent.agent_id = id;
-        agent.x = width-1; agent.y = height-1; agent.cooldown = 0; agent.splash_bombs = 1;
-        agent.wetness = 50;
-        initial_enemy.push_back(agent);
-    }
-    
-    search.initialize(initial_my, initial_enemy, all_agents_data, width, height);
-    search.build_prediction_cache(); // Pre-compute everything!
     
-    cerr << "=== CACHE READY - STARTING REAL-TIME GAME ===" << endl;
+    // A book file from tools/book_maker.cpp, otherwise the one compiled into
+    // local builds; either is expanded on first lookup. The submission has
+    // neither and searches every turn from scratch.
+    OpeningBook book;
+    const char* book_path = getenv("SMITSIMAX_BOOK");
+    if (!book.open(book_path ? book_path : "opening_book.bin")) {
+#ifndef SUBMISSION
+        book.attach_packed(OPENING_BOOK_DATA, OPENING_BOOK_DATA_LENGTH);
+#endif
+    }
+    search.set_opening_book(&book);
     
     while (true) {
-        auto turn_start = chrono::high_resolution_clock::now();
-        
         int agent_count;
         cin >> agent_count;
         if (cin.fail()) {
             cerr << "ERROR: Failed to read agent_count!" << endl;
             break;
         }
+        timer.start_turn();
         cin.ignore();
         
-        cerr << "=== TURN START: Reading " << agent_count << " agents ===" << endl;
-        
         vector<AgentState> my_current_agents;
         vector<AgentState> enemy_current_agents;
         
@@ -1509,107 +1488,44 @@ int main() {
         }
         cin.ignore();
         
-        cerr << "=== TURN INFO ===" << endl;
-        cerr << "Game expects " << my_agent_count << " action lines from me" << endl;
-        cerr << "I have " << my_current_agents.size() << " live agents" << endl;
-        
-        cerr << "=== MERGED SMITSIMAX + TACTICAL AI ===" << endl;
-        cerr << "Expected my_agent_count: " << my_agent_count << endl;
-        cerr << "Actual my_current_agents.size(): " << my_current_agents.size() << endl;
-        cerr << "My agents: " << my_current_agents.size() 
-             << ", Enemy agents: " << enemy_current_agents.size() << endl;
-        
-        cerr << "My agent IDs: ";
-        for (int id : my_agent_ids) cerr << id << " ";
-        cerr << endl;
-        
-        cerr << "Live agent IDs: ";
-        for (const auto& agent : my_current_agents) cerr << agent.agent_id << " ";
-        cerr << endl;
-        
-        // Print current state with detailed info
-        cerr << "Current battlefield:" << endl;
-        for (const auto& agent : my_current_agents) {
-            AgentClass ac = all_agents_data[agent.agent_id].agent_class;
-            string class_name = (ac == SNIPER ? "SNIPER" : ac == BOMBER ? "BOMBER" : 
-                               ac == BERSERKER ? "BERSERKER" : ac == ASSAULT ? "ASSAULT" : "GUNNER");
-            cerr << "  My " << class_name << " " << agent.agent_id << ": pos(" << agent.x << "," << agent.y 
-                 << ") cooldown=" << agent.cooldown << " wetness=" << agent.wetness 
-                 << " bombs=" << agent.splash_bombs << endl;
-        }
-        for (const auto& agent : enemy_current_agents) {
-            cerr << "  Enemy " << agent.agent_id << ": pos(" << agent.x << "," << agent.y 
-                 << ") cooldown=" << agent.cooldown << " wetness=" << agent.wetness << endl;
-        }
-        
-        // Initialize and run INSTANT cache lookup (no real-time search needed!)
-        cerr << "Updating search state for turn with " << my_current_agents.size() << " my agents, " 
-             << enemy_current_agents.size() << " enemy agents" << endl;
-        
-        search.initialize(my_current_agents, enemy_current_agents, all_agents_data, width, height);
-        
-        cerr << "Running INSTANT cache lookup..." << endl;
-        vector<SmitsimaxNode*> best_moves;
-        
-        try {
-            best_moves = search.search(); // Uses cache now!
-            cerr << "Cache lookup completed instantly, got " << best_moves.size() << " moves" << endl;
-        } catch (...) {
-            cerr << "Cache lookup failed! Using emergency defaults." << endl;
-            // Create default moves for all agents
-            for (int i = 0; i < my_current_agents.size(); i++) {
-                best_moves.push_back(nullptr);
+        search.initialize(my_current_agents, enemy_current_agents, all_agents_data, board);
+        
+        // A compound MOVE+combat order per live agent: the book's on an exact
+        // hit, otherwise the move and combat nodes the search settled on
+        PackedAction orders[MAX_AGENTS];
+        for (int i = 0; i < MAX_AGENTS; i++) orders[i] = PackedAction::hunker_down();
+        if (!search.book_orders(orders)) {
+            try {
+                auto deadline = timer.search_deadline(search.position_complexity());
+                vector<SmitsimaxNode*> best_moves = search.search_original(deadline, timer.check_interval());
+                for (int i = 0; i < (int)best_moves.size(); i++) {
+                    if (best_moves[i]) orders[i] = best_moves[i]->action;
+                }
+            } catch (...) {
+                cerr << "Search failed! Using emergency defaults." << endl;
             }
         }
         
-        // Output actions - SIMPLE FORMAT ONLY
-        cerr << endl << "=== GENERATING SIMPLE OUTPUT FORMAT ===" << endl;
-        
         for (int i = 0; i < my_agent_count; i++) {
             string final_action;
             
-            if (i < my_current_agents.size()) {
+            if (i < (int)my_current_agents.size()) {
                 // Live agent - use AI decision
-                int agent_id = my_current_agents[i].agent_id;
-                
-                if (i < best_moves.size() && best_moves[i]) {
-                    SmitsimaxNode* move = best_moves[i];
-                    
-                    if (move->action_type == "SHOOT") {
-                        final_action = to_string(agent_id) + ";SHOOT " + to_string(move->target_agent_id) + "; HUNKER_DOWN";
-                        cerr << "Agent " << agent_id << " -> SHOOT " << move->target_agent_id << endl;
-                    } else if (move->action_type == "MOVE") {
-                        final_action = to_string(agent_id) + ";MOVE " + to_string(move->target_x) + " " + to_string(move->target_y) + "; HUNKER_DOWN";
-                        cerr << "Agent " << agent_id << " -> MOVE " << move->target_x << " " << move->target_y << endl;
-                    } else if (move->action_type == "THROW") {
-                        final_action = to_string(agent_id) + ";THROW " + to_string(move->target_x) + " " + to_string(move->target_y) + "; HUNKER_DOWN";
-                        cerr << "Agent " << agent_id << " -> THROW " << move->target_x << " " << move->target_y << endl;
-                    } else {
-                        final_action = to_string(agent_id) + ";HUNKER_DOWN; HUNKER_DOWN";
-                        cerr << "Agent " << agent_id << " -> HUNKER_DOWN" << endl;
-                    }
-                } else {
-                    final_action = to_string(agent_id) + ";HUNKER_DOWN; HUNKER_DOWN";
-                    cerr << "Agent " << agent_id << " -> DEFAULT HUNKER_DOWN" << endl;
-                }
+                PackedAction issued = issued_order(orders[i]);
+                search.note_played(i, orders[i], issued);
+                final_action = command_line(my_current_agents[i].agent_id, issued);
             } else {
                 // Dead agent - use default ID
                 int default_id = (i < my_agent_ids.size()) ? my_agent_ids[i] : my_agent_ids[0];
-                final_action = to_string(default_id) + ";HUNKER_DOWN; HUNKER_DOWN";
-                cerr << "Dead agent slot " << i << " -> Agent " << default_id << " HUNKER_DOWN" << endl;
+                final_action = command_line(default_id, PackedAction::hunker_down());
             }
             
             cout << final_action << endl;
-            cerr << "SENT TO GAME: " << final_action << endl;
         }
         
-        // CRITICAL: Ensure all output is flushed immediately
         cout.flush();
-        cerr.flush();
-        auto turn_end = chrono::high_resolution_clock::now();
-        auto duration = chrono::duration_cast<chrono::milliseconds>(turn_end - turn_start);
-        cerr << "INSTANT cached turn time: " << duration.count() << "ms (cache system)" << endl;
-        cerr << "========================================" << endl << endl;
+        cerr << "Turn " << timer.turn_number() << ": " << (int)timer.elapsed_ms() << "ms of " << timer.turn_limit_ms()
+             << "ms since input" << endl;
     }
     
     return 0;
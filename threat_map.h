@@ -0,0 +1,104 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include "bitboard.h"
+#include "rules_engine.h"
+
+// THREAT MAP
+// What one team's agents can do to every tile next turn, built once per turn
+// so heuristics read a tile instead of looping over enemies and tiles each
+// time. Each agent may first step onto a free orthogonal floor tile, as
+// Game.doMoves allows, then spend its one combat action on a shot (cooldown 0)
+// or a throw (a balloon left):
+//
+//   shot[s][t]     line of fire of source s: the best Game.doShoots damage it
+//                  can deal to an unhunkered agent on t from any tile it can
+//                  reach; full damage to optimal_range, half to twice that,
+//                  cover from the CoverTable
+//   splash[s]      tiles a throw by source s can splash for THROW_DAMAGE
+//   shooting[t]    sum of shot[s][t]
+//   splashing[t]   THROW_DAMAGE per source that can splash t
+//   incoming[t]    sum over sources of the larger of the two: what an agent
+//                  on t takes if every source spends its action on it
+//   shooters[t]    sources with a shot at t
+//
+// The shot layer walks whole CoverTable rows with straight-line arithmetic
+// (damage = (soaking_power * band * quarters + 4) / 8, band 2 in range, 1 in
+// falloff, 0 beyond, which is the referee's rounding), a loop the compiler
+// vectorizes; the splash layer is bitboard dilation.
+
+struct ThreatSource {
+    int x, y;
+    int optimal_range;
+    int soaking_power;
+    int cooldown;
+    int splash_bombs;
+};
+
+struct ThreatMap {
+    static const int MAX_TILES = BoardGeometry::MAX_TILES;
+    static const int MAX_SOURCES = RULES_MAX_AGENTS;
+
+    int source_count = 0;
+    int16_t shot[MAX_SOURCES][MAX_TILES];
+    Bitboard splash[MAX_SOURCES];
+    int16_t shooting[MAX_TILES];
+    int16_t splashing[MAX_TILES];
+    int16_t incoming[MAX_TILES];
+    uint8_t shooters[MAX_TILES];
+
+    // `occupied` holds every live agent's tile at turn start
+    void build(const BoardLayers& board, const CoverTable& cover, const Bitboard& occupied,
+               const ThreatSource* sources, int count) {
+        const BoardGeometry& geo = board.geo;
+        int tiles = std::min(geo.width * geo.height, (int)MAX_TILES);
+        source_count = std::min(count, (int)MAX_SOURCES);
+        std::fill(shooting, shooting + MAX_TILES, 0);
+        std::fill(splashing, splashing + MAX_TILES, 0);
+        std::fill(incoming, incoming + MAX_TILES, 0);
+        std::fill(shooters, shooters + MAX_TILES, 0);
+
+        for (int s = 0; s < source_count; s++) {
+            const ThreatSource& source = sources[s];
+            Bitboard start = geo.bit(source.x, source.y);
+            Bitboard reach = start | (geo.dilate4(start) & board.walkable(occupied));
+
+            int16_t* line = shot[s];
+            std::fill(line, line + MAX_TILES, 0);
+            if (source.cooldown == 0 && source.soaking_power > 0) {
+                reach.for_each([&](int from) { add_line_of_fire(geo, cover, source, from, tiles, line); });
+            }
+            splash[s] = source.splash_bombs > 0
+                      ? geo.dilate8(geo.within_manhattan(reach, RULES_THROW_DISTANCE_MAX)) : Bitboard();
+
+            for (int t = 0; t < tiles; t++) {
+                int thrown = splash[s].test(t) ? RULES_THROW_DAMAGE : 0;
+                shooting[t] += line[t];
+                splashing[t] += thrown;
+                incoming[t] += std::max<int>(line[t], thrown);
+                shooters[t] += line[t] > 0;
+            }
+        }
+    }
+
+private:
+    static void add_line_of_fire(const BoardGeometry& geo, const CoverTable& cover, const ThreatSource& source,
+                                 int from, int tiles, int16_t* line) {
+        int fx = geo.x_of(from), fy = geo.y_of(from);
+        int range = source.optimal_range, power = source.soaking_power;
+        const uint8_t* quarters = cover.quarters + from * MAX_TILES;
+        for (int y = 0; y < geo.height; y++) {
+            int row = y * geo.width;
+            int end = std::min(geo.width, tiles - row);
+            int dy = std::abs(y - fy);
+            for (int x = 0; x < end; x++) {
+                int distance = dy + std::abs(x - fx);
+                int band = (distance <= range) + (distance <= 2 * range);
+                int damage = (power * band * quarters[row + x] + 4) >> 3;
+                line[row + x] = (int16_t)std::max<int>(line[row + x], damage);
+            }
+        }
+    }
+};
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+
+// TIME MANAGER
+// Per-turn search budgets measured from when the turn's input arrived rather
+// than from when the search started, so parsing and setup count against the
+// referee's limit (1000 ms for the first turn, 50 ms after). A turn's unused
+// time does not carry over, so the budget is the whole window minus a safety
+// margin, trimmed for simple positions by complexity in [0, 1].
+//
+// Searches poll a SearchClock instead of the system clock: it reads the clock
+// every few iterations, spacing the reads by the iteration speed it observes
+// so they land about check_interval apart and never far past the deadline.
+
+struct TimeBudgetConfig {
+    double first_turn_ms = 1000.0;
+    double turn_ms = 50.0;
+    double safety_margin_ms = 6.0;        // Output, scheduling jitter, a slow judge
+    double first_turn_margin_ms = 50.0;
+    double min_budget_fraction = 0.7;     // Share of the window a trivial position gets
+};
+
+class TimeManager {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit TimeManager(const TimeBudgetConfig& config = TimeBudgetConfig()) : config(config) {}
+
+    // Call right after the first read of the game returns: the first turn's
+    // clock runs from here, across the initialisation input
+    void begin_game() {
+        turn = 1;
+        turn_start = Clock::now();
+        first_turn_pending = true;
+        calibrate();
+    }
+
+    // Call right after each turn's first read returns. The first turn's clock
+    // is already running from begin_game().
+    void start_turn() {
+        if (first_turn_pending) {
+            first_turn_pending = false;
+            return;
+        }
+        turn++;
+        turn_start = Clock::now();
+    }
+
+    int turn_number() const { return turn; }
+    double elapsed_ms() const { return std::chrono::duration<double, std::milli>(Clock::now() - turn_start).count(); }
+    double turn_limit_ms() const { return turn == 1 ? config.first_turn_ms : config.turn_ms; }
+
+    // When a search begun now must stop
+    Clock::time_point search_deadline(double complexity = 1.0) const {
+        double margin = turn == 1 ? config.first_turn_margin_ms : config.safety_margin_ms;
+        double usable = std::max(0.0, turn_limit_ms() - margin);
+        double fraction = config.min_budget_fraction
+                        + (1.0 - config.min_budget_fraction) * std::min(1.0, std::max(0.0, complexity));
+        auto offset = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double, std::milli>(usable * fraction));
+        return std::max(Clock::now(), turn_start + offset);
+    }
+
+    // Spacing of a SearchClock's reads, set from the clock's own cost
+    Clock::duration check_interval() const { return interval; }
+
+private:
+    TimeBudgetConfig config;
+    int turn = 0;
+    Clock::time_point turn_start = Clock::now();
+    bool first_turn_pending = false;
+    Clock::duration interval = std::chrono::microseconds(250);
+
+    // Times a burst of clock reads: checks are spaced so reading the clock
+    // costs about 1% of the search, but at most 250 us apart
+    void calibrate() {
+        const int reads = 1000;
+        auto start = Clock::now();
+        Clock::time_point last = start;
+        for (int i = 0; i < reads; i++) last = Clock::now();
+        auto per_read = (last - start) / reads;
+        interval = std::min<Clock::duration>(std::chrono::microseconds(250),
+                                             std::max<Clock::duration>(per_read * 100, std::chrono::microseconds(20)));
+    }
+};
+
+// Batched deadline check for one search loop (one per thread)
+class SearchClock {
+public:
+    using Clock = TimeManager::Clock;
+
+    SearchClock(Clock::time_point deadline, Clock::duration interval)
+        : deadline(deadline), interval(interval), last_read(Clock::now()) {}
+
+    // Call at the start of every iteration
+    bool expired() {
+        long long finished = started++;
+        if (finished < next_check) return false;
+        Clock::time_point now = Clock::now();
+        if (now >= deadline) return true;
+
+        // Iterations until the next read: one interval's worth at the speed
+        // seen since the last read, and no more than fit before the deadline
+        long long done = finished - finished_at_read;
+        auto spent = std::max<Clock::duration>(now - last_read, Clock::duration(1));
+        auto until = std::min(interval, deadline - now);
+        long long batch = done * until.count() / spent.count();
+        next_check = finished + std::max(1LL, batch);
+        finished_at_read = finished;
+        last_read = now;
+        return false;
+    }
+
+private:
+    Clock::time_point deadline;
+    Clock::duration interval;
+    Clock::time_point last_read;
+    long long started = 0;
+    long long finished_at_read = 0;
+    long long next_check = 0;
+};
@@ -0,0 +1,38 @@
+// RECORD TRACES
+// Plays full games through the Java referee with game/GameTrace.java switched
+// on, producing the reference trace tools/rules_replay.cpp checks the C++ rules
+// engine against. tools/record_traces.sh builds it inside a copy of the
+// referee's CodinGame SDK project (the game/ sources under src/main/java,
+// config/ at the root, and the gameengine core and runner artifacts on the
+// classpath), runs it and replays the result:
+//
+//   java -Dgame.trace=tools/traces/referee.trace -cp <sdk classpath> \
+//        RecordTraces [first_seed] [games] bot_a bot_b
+//
+// Each bot is a shell command; bots swap sides every game, and every game is
+// appended to the trace file. Re-record after any change to Game.java.
+
+import com.codingame.gameengine.runner.MultiplayerGameRunner;
+import com.codingame.gameengine.runner.simulate.GameResult;
+
+public class RecordTraces {
+    public static void main(String[] args) {
+        if (args.length != 2 && args.length != 4) {
+            System.err.println("usage: RecordTraces [first_seed] [games] bot_a bot_b");
+            System.exit(2);
+        }
+        long firstSeed = args.length == 4 ? Long.parseLong(args[0]) : 1;
+        int games = args.length == 4 ? Integer.parseInt(args[1]) : 8;
+        String botA = args[args.length - 2];
+        String botB = args[args.length - 1];
+
+        for (int game = 0; game < games; ++game) {
+            MultiplayerGameRunner runner = new MultiplayerGameRunner();
+            runner.setSeed(firstSeed + game);
+            runner.addAgent(game % 2 == 0 ? botA : botB);
+            runner.addAgent(game % 2 == 0 ? botB : botA);
+            GameResult result = runner.simulate();
+            System.err.println("seed " + (firstSeed + game) + ": scores " + result.scores);
+        }
+    }
+}
@@ -0,0 +1,714 @@
+// ARENA
+// Local self-play between two bot executables with the referee's protocol:
+// maps from GridMaker (tools/grid_maker.h), the global and per-turn input of
+// Serializer, commands parsed like CommandManager, turns played by
+// rules_engine.h, and the referee's time limits (1000 ms first turn, 50 ms
+// after). Bots swap sides every game so map and side bias cancel out.
+//
+//   g++ -std=c++17 -O2 -o arena tools/arena.cpp
+//   arena [-n games] [-s first_seed] [-j jobs] [--turn-ms 50] [--first-turn-ms 1000]
+//         [--sprt elo0 elo1] [-v] bot_a bot_b
+//
+// Each bot is a shell command, started fresh for every game. A bot that times
+// out, exits or sends an invalid command loses the game, as on CodinGame.
+// Reports bot_a's score rate (draws count half) with a 95% Wilson interval,
+// and each bot's mean and p99 turn latency measured from the first input line
+// written to the last command line read (first turns, with their 1000 ms
+// budget, are left out).
+//
+// Games run as separate processes, -j at a time (one per core by default),
+// each pinned to its own core. With --sprt the match stops early once a
+// sequential probability ratio test (alpha = beta = 0.05) decides between
+// bot_a being elo0 or elo1 Elo stronger than bot_b; -n is then the cap.
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cctype>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <poll.h>
+#include <sched.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "../rules_engine.h"
+#include "grid_maker.h"
+using namespace std;
+
+// AgentClass.values(): GUNNER, SNIPER, BOMBER, ASSAULT, BERSERKER
+static const int CLASS_COOLDOWN[5] = {1, 5, 2, 2, 5};
+static const int CLASS_SOAKING_POWER[5] = {16, 24, 8, 16, 32};
+static const int CLASS_OPTIMAL_RANGE[5] = {4, 6, 2, 4, 2};
+static const int CLASS_BALLOONS[5] = {1, 0, 3, 2, 1};
+
+// String.split(";"): trailing empty pieces are dropped, and a line with no
+// separator at all is one piece
+static vector<string> split_commands(const string& line) {
+    vector<string> pieces;
+    size_t begin = 0;
+    for (size_t end; (end = line.find(';', begin)) != string::npos; begin = end + 1) {
+        pieces.push_back(line.substr(begin, end - begin));
+    }
+    pieces.push_back(line.substr(begin));
+    if (pieces.size() > 1) {
+        while (!pieces.empty() && pieces.back().empty()) pieces.pop_back();
+    }
+    return pieces;
+}
+
+// String.trim(): strips every character up to and including ' '
+static string java_trim(const string& text) {
+    size_t begin = 0, end = text.size();
+    while (begin < end && (unsigned char)text[begin] <= ' ') begin++;
+    while (end > begin && (unsigned char)text[end - 1] <= ' ') end--;
+    return text.substr(begin, end - begin);
+}
+
+// An ASCII integer that fits in a Java int; `sign` allows a leading minus
+// (and a plus, as Integer.parseInt does for the agent id)
+static bool match_int(const string& text, size_t& at, bool sign, long long& value) {
+    bool negative = false;
+    if (sign && at < text.size() && (text[at] == '-' || text[at] == '+')) negative = text[at++] == '-';
+    size_t digits = at;
+    value = 0;
+    while (at < text.size() && isdigit((unsigned char)text[at])) {
+        value = value * 10 + (text[at++] - '0');
+        if (value > 2147483648LL) return false;
+    }
+    if (negative) value = -value;
+    return at > digits && value <= 2147483647LL;
+}
+
+// Matches a whole trimmed command against an ActionType pattern, ignoring
+// case: '#' is \d+, '~' is -?\d+ and '*' is the rest of the command; the
+// numbers land in a and b
+static bool match_command(const string& command, const char* pattern, int& a, int& b) {
+    size_t at = 0;
+    int captured = 0;
+    for (const char* c = pattern; *c; c++) {
+        if (*c == '*') return true;
+        if (*c == '#' || *c == '~') {
+            long long value;
+            if ((*c == '~' && at < command.size() && command[at] == '+') || !match_int(command, at, *c == '~', value)) return false;
+            (captured++ == 0 ? a : b) = (int)value;
+        } else if (at >= command.size() || toupper((unsigned char)command[at++]) != *c) {
+            return false;
+        }
+    }
+    return at == command.size();
+}
+
+class BotProcess {
+public:
+    ~BotProcess() { stop(); }
+
+    bool start(const string& command) {
+        int to_bot[2], from_bot[2];
+        if (pipe(to_bot) != 0 || pipe(from_bot) != 0) return false;
+        pid = fork();
+        if (pid < 0) return false;
+        if (pid == 0) {
+            dup2(to_bot[0], 0);
+            dup2(from_bot[1], 1);
+            // Both bots log heavily to cerr; an unread pipe would block them
+            int null_fd = open("/dev/null", O_WRONLY);
+            if (null_fd >= 0) dup2(null_fd, 2);
+            close(to_bot[0]);
+            close(to_bot[1]);
+            close(from_bot[0]);
+            close(from_bot[1]);
+            execl("/bin/sh", "sh", "-c", command.c_str(), (char*)nullptr);
+            _exit(127);
+        }
+        close(to_bot[0]);
+        close(from_bot[1]);
+        in_fd = to_bot[1];
+        out_fd = from_bot[0];
+        buffer.clear();
+        return true;
+    }
+
+    void stop() {
+        if (in_fd >= 0) close(in_fd);
+        if (out_fd >= 0) close(out_fd);
+        in_fd = out_fd = -1;
+        if (pid > 0) {
+            kill(pid, SIGKILL);
+            waitpid(pid, nullptr, 0);
+            pid = -1;
+        }
+    }
+
+    bool send(const string& text) {
+        size_t done = 0;
+        while (done < text.size()) {
+            ssize_t n = write(in_fd, text.data() + done, text.size() - done);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) return false;
+            done += n;
+        }
+        return true;
+    }
+
+    // Next output line, or false once the deadline passes or the bot exits
+    bool read_line(string& line, chrono::steady_clock::time_point deadline) {
+        while (true) {
+            size_t end = buffer.find('\n');
+            if (end != string::npos) {
+                line = buffer.substr(0, end);
+                if (!line.empty() && line.back() == '\r') line.pop_back();
+                buffer.erase(0, end + 1);
+                return true;
+            }
+            int wait_ms = (int)chrono::duration_cast<chrono::milliseconds>(deadline - chrono::steady_clock::now()).count();
+            if (wait_ms < 0) return false;
+            pollfd p = {out_fd, POLLIN, 0};
+            int ready = poll(&p, 1, wait_ms);
+            if (ready < 0 && errno == EINTR) continue;
+            if (ready <= 0) return false;
+            char chunk[4096];
+            ssize_t n = read(out_fd, chunk, sizeof(chunk));
+            if (n <= 0) return false;
+            buffer.append(chunk, n);
+        }
+    }
+
+private:
+    pid_t pid = -1;
+    int in_fd = -1, out_fd = -1;
+    string buffer;
+};
+
+struct ArenaOptions {
+    int games = 20;
+    long long first_seed = 1;
+    int turn_ms = 50;
+    int first_turn_ms = 1000;
+    bool verbose = false;
+    string bots[2];
+};
+
+struct GameResult {
+    int winner;          // Player index, -1 for a draw
+    int points[2];
+    int turns;
+    string reason;
+};
+
+class ArenaGame {
+public:
+    ArenaGame(const ArenaOptions& options, long long seed, vector<double>* latencies[2])
+        : options(options), latencies(latencies) {
+        GeneratedGrid grid = GeneratedGrid::make(seed);
+        table.init_map(grid.width, grid.height);
+        for (int y = 0; y < grid.height; y++) {
+            for (int x = 0; x < grid.width; x++) table.board.set_tile(x, y, grid.type(x, y));
+        }
+        table.build_map_tables();
+        width = grid.width;
+        height = grid.height;
+        tiles = grid.tiles;
+
+        // Game.initPlayers: ids count up over player 0's spawns, then player
+        // 1's, each spawn taking the next agent class
+        int n = (int)grid.spawns.size();
+        state.count = (uint8_t)(2 * n);
+        state.my_count = (uint8_t)n;
+        state.points[0] = state.points[1] = 0;
+        for (int s = 0; s < 2 * n; s++) {
+            int c = s % n;
+            pair<int, int> at = s < n ? grid.spawns[c] : grid.opposite(grid.spawns[c].first, grid.spawns[c].second);
+            table.agent_id[s] = s + 1;
+            table.shoot_cooldown[s] = CLASS_COOLDOWN[c];
+            table.optimal_range[s] = CLASS_OPTIMAL_RANGE[c];
+            table.soaking_power[s] = CLASS_SOAKING_POWER[c];
+            state.x[s] = (int8_t)at.first;
+            state.y[s] = (int8_t)at.second;
+            state.cooldown[s] = 0;
+            state.splash_bombs[s] = (uint8_t)CLASS_BALLOONS[c];
+            state.wetness[s] = 0;
+        }
+        state.rehash();
+    }
+
+    GameResult play() {
+        GameResult result = {-1, {0, 0}, 0, "turn limit"};
+        bool failed[2] = {false, false};
+        string why[2];
+        for (int p = 0; p < 2; p++) {
+            if (!bots[p].start(options.bots[p]) || !bots[p].send(global_info(p))) {
+                failed[p] = true;
+                why[p] = "failed to start";
+            }
+        }
+
+        int turn = 0;
+        while (!failed[0] && !failed[1]) {
+            turn++;
+            PackedAction orders[RULES_MAX_AGENTS];
+            for (int s = 0; s < state.count; s++) orders[s] = PackedAction::move(state.x[s], state.y[s]);
+            for (int p = 0; p < 2 && !failed[p]; p++) {
+                failed[p] = !play_turn(p, turn, orders, why[p]);
+            }
+            if (failed[0] || failed[1]) break;
+            engine.step(table, state, orders);
+            if (RulesEngine::game_over(state, turn)) break;
+        }
+
+        for (int p = 0; p < 2; p++) bots[p].stop();
+        result.turns = turn;
+        result.points[0] = state.points[0];
+        result.points[1] = state.points[1];
+        if (failed[0] || failed[1]) {
+            result.winner = failed[0] && failed[1] ? -1 : (failed[0] ? 1 : 0);
+            result.reason = failed[0] ? "player 0 " + why[0] : "player 1 " + why[1];
+            return result;
+        }
+        // Game.onEnd: a wiped out team scores -1 unless both are
+        int live[2] = {state.live_count(0), state.live_count(1)};
+        if (live[0] == 0 || live[1] == 0) {
+            result.reason = "wipe out";
+            if (live[0] != live[1]) {
+                result.winner = live[0] > 0 ? 0 : 1;
+                return result;
+            }
+        } else if (turn < RULES_MAX_TURNS) {
+            result.reason = "point lead";
+        }
+        if (state.points[0] != state.points[1]) result.winner = state.points[0] > state.points[1] ? 0 : 1;
+        return result;
+    }
+
+private:
+    const ArenaOptions& options;
+    vector<double>** latencies;
+    BotProcess bots[2];
+    RulesTable table;
+    RulesState state;
+    RulesEngine engine;
+    int width = 0, height = 0;
+    vector<int> tiles;
+
+    int team_begin(int p) const { return p == 0 ? 0 : state.my_count; }
+    int team_end(int p) const { return p == 0 ? state.my_count : state.count; }
+
+    // Serializer.serializeGlobalInfoFor
+    string global_info(int p) const {
+        ostringstream out;
+        out << p << "\n" << (int)state.count << "\n";
+        for (int s = 0; s < state.count; s++) {
+            out << table.agent_id[s] << " " << (s < state.my_count ? 0 : 1) << " " << table.shoot_cooldown[s] << " "
+                << table.optimal_range[s] << " " << table.soaking_power[s] << " " << (int)state.splash_bombs[s] << "\n";
+        }
+        out << width << " " << height << "\n";
+        for (int y = 0; y < height; y++) {
+            for (int x = 0; x < width; x++) {
+                out << x << " " << y << " " << tiles[y * width + x] << (x + 1 < width ? " " : "\n");
+            }
+        }
+        return out.str();
+    }
+
+    // Serializer.serializeFrameInfoFor: agents removed by the referee are gone
+    string frame_info(int p) const {
+        ostringstream out;
+        int live = 0;
+        for (int s = 0; s < state.count; s++) live += state.is_alive(s);
+        out << live << "\n";
+        for (int s = 0; s < state.count; s++) {
+            if (!state.is_alive(s)) continue;
+            out << table.agent_id[s] << " " << (int)state.x[s] << " " << (int)state.y[s] << " " << (int)state.cooldown[s]
+                << " " << (int)state.splash_bombs[s] << " " << state.wetness[s] << "\n";
+        }
+        out << state.live_count(p) << "\n";
+        return out.str();
+    }
+
+    bool play_turn(int p, int turn, PackedAction* orders, string& why) {
+        int expected = state.live_count(p);
+        auto start = chrono::steady_clock::now();
+        auto deadline = start + chrono::milliseconds(turn == 1 ? options.first_turn_ms : options.turn_ms);
+        if (!bots[p].send(frame_info(p))) {
+            why = "exited";
+            return false;
+        }
+        vector<int> live;
+        for (int s = team_begin(p); s < team_end(p); s++) {
+            if (state.is_alive(s)) live.push_back(s);
+        }
+        for (int line_index = 0; line_index < expected; line_index++) {
+            string line;
+            if (!bots[p].read_line(line, deadline)) {
+                why = "timed out on turn " + to_string(turn);
+                return false;
+            }
+            if (!parse_line(p, line, live[line_index], orders)) {
+                why = "sent an invalid command on turn " + to_string(turn) + ": " + line;
+                return false;
+            }
+        }
+        if (turn > 1) {
+            latencies[p]->push_back(chrono::duration<double, milli>(chrono::steady_clock::now() - start).count());
+        }
+        return true;
+    }
+
+    // CommandManager.parseCommands for one line: an optional agent id, then
+    // commands, each matched whole and case-insensitively against the
+    // ActionType patterns. Game.ALLOW_DOUBLE_MOVE is off, so the last MOVE and
+    // the last combat command win, and the line is cut short once the agent
+    // has a move, a combat action and a message
+    bool parse_line(int p, const string& line, int default_slot, PackedAction* orders) {
+        vector<string> commands = split_commands(line);
+
+        int slot = default_slot, first = 0;
+        long long id;
+        size_t at = 0;
+        if (commands.size() > 1 && match_int(commands[0], at, true, id) && at == commands[0].size()) {
+            slot = -1;
+            for (int s = team_begin(p); s < team_end(p); s++) {
+                if (table.agent_id[s] == id && state.is_alive(s)) slot = s;
+            }
+            if (slot < 0) return false;
+            first = 1;
+        }
+
+        int move_x = -1, move_y = -1;
+        char combat = 0;
+        bool message = false;
+        int arg1 = -1, arg2 = -1;
+        for (size_t i = first; i < commands.size(); i++) {
+            const string command = java_trim(commands[i]);
+            int a, b;
+            if (match_command(command, "MOVE # #", a, b)) {
+                move_x = min(a, 30);
+                move_y = min(b, 30);
+            } else if (match_command(command, "SHOOT #", a, b)) {
+                combat = 'S';
+                arg1 = a;
+            } else if (match_command(command, "THROW ~ ~", a, b)) {
+                combat = 'T';
+                arg1 = a;
+                arg2 = b;
+            } else if (match_command(command, "WAIT", a, b) || match_command(command, "HUNKER_DOWN", a, b)) {
+                combat = 'H';
+            } else if (match_command(command, "MESSAGE *", a, b)) {
+                message = true;
+            } else {
+                return false;
+            }
+            if (move_x >= 0 && combat && message) break;
+        }
+
+        // A throw off the map is rejected by Game.doThrows, leaving no combat action
+        if (combat == 'T' && (arg1 < 0 || arg1 >= width || arg2 < 0 || arg2 >= height)) combat = 0;
+        bool move = move_x >= 0;
+        if (combat == 'S') orders[slot] = move ? PackedAction::move_shoot(move_x, move_y, arg1) : PackedAction::shoot(arg1);
+        else if (combat == 'T') orders[slot] = move ? PackedAction::move_throw(move_x, move_y, arg1, arg2) : PackedAction::throw_at(arg1, arg2);
+        else if (combat == 'H') orders[slot] = move ? PackedAction::move_hunker(move_x, move_y) : PackedAction::hunker_down();
+        else if (move) orders[slot] = PackedAction::move(move_x, move_y);
+        return true;
+    }
+};
+
+static double percentile(vector<double> values, double q) {
+    if (values.empty()) return 0;
+    sort(values.begin(), values.end());
+    size_t index = (size_t)ceil(q * values.size());
+    return values[index > 0 ? index - 1 : 0];
+}
+
+// Wilson score interval for a proportion
+static void wilson_interval(double score, int n, double& low, double& high) {
+    const double z = 1.96;
+    double denominator = 1 + z * z / n;
+    double centre = (score + z * z / (2 * n)) / denominator;
+    double margin = z * sqrt(score * (1 - score) / n + z * z / (4.0 * n * n)) / denominator;
+    low = max(0.0, centre - margin);
+    high = min(1.0, centre + margin);
+}
+
+// One finished game from bot_a's point of view
+struct GameOutcome {
+    int game;
+    int score;           // bot_a: 2 win, 1 draw, 0 loss
+    int points[2];       // bot_a first
+    int turns;
+    int a_side;
+    string reason;
+    vector<double> latency[2];
+};
+
+// Plays game g in this process. Even games put bot_a on player 0.
+static GameOutcome play_game(const ArenaOptions& options, int g) {
+    GameOutcome outcome;
+    outcome.game = g;
+    outcome.a_side = g % 2;
+    ArenaOptions game_options = options;
+    game_options.bots[outcome.a_side] = options.bots[0];
+    game_options.bots[1 - outcome.a_side] = options.bots[1];
+    vector<double>* latencies[2];
+    latencies[outcome.a_side] = &outcome.latency[0];
+    latencies[1 - outcome.a_side] = &outcome.latency[1];
+
+    GameResult result = ArenaGame(game_options, options.first_seed + g, latencies).play();
+    outcome.score = result.winner < 0 ? 1 : (result.winner == outcome.a_side ? 2 : 0);
+    outcome.points[0] = result.points[outcome.a_side];
+    outcome.points[1] = result.points[1 - outcome.a_side];
+    outcome.turns = result.turns;
+    outcome.reason = result.reason;
+    return outcome;
+}
+
+static string encode_outcome(const GameOutcome& o) {
+    ostringstream out;
+    out << o.score << " " << o.points[0] << " " << o.points[1] << " " << o.turns << "\n" << o.reason << "\n";
+    for (int b = 0; b < 2; b++) {
+        out << o.latency[b].size();
+        for (double ms : o.latency[b]) out << " " << ms;
+        out << "\n";
+    }
+    return out.str();
+}
+
+static bool decode_outcome(const string& text, GameOutcome& o) {
+    istringstream in(text);
+    if (!(in >> o.score >> o.points[0] >> o.points[1] >> o.turns)) return false;
+    in.ignore(1);
+    getline(in, o.reason);
+    for (int b = 0; b < 2; b++) {
+        size_t n = 0;
+        in >> n;
+        o.latency[b].resize(n);
+        for (double& ms : o.latency[b]) in >> ms;
+    }
+    return (bool)in;
+}
+
+// Sequential probability ratio test on the score rate, with the trinomial
+// normal approximation fishtest used: H0 elo = elo0 against H1 elo = elo1
+struct Sprt {
+    bool enabled = false;
+    double elo0 = 0, elo1 = 5, alpha = 0.05, beta = 0.05;
+
+    static double expected_score(double elo) { return 1 / (1 + pow(10, -elo / 400)); }
+
+    double llr(int wins, int draws, int losses) const {
+        // Half a game in place of an empty outcome keeps the variance
+        // positive on one-sided records
+        double counts[3] = {wins > 0 ? wins : 0.5, draws > 0 ? draws : 0.5, losses > 0 ? losses : 0.5};
+        double n = counts[0] + counts[1] + counts[2];
+        double w = counts[0] / n, d = counts[1] / n;
+        double score = w + d / 2;
+        double variance = (w + d / 4 - score * score) / n;
+        if (variance <= 0) return 0;
+        double s0 = expected_score(elo0), s1 = expected_score(elo1);
+        return (s1 - s0) * (2 * score - s0 - s1) / (2 * variance);
+    }
+    double lower() const { return log(beta / (1 - alpha)); }
+    double upper() const { return log((1 - beta) / alpha); }
+};
+
+// Runs the games as isolated subprocesses, `jobs` at a time, each pinned to
+// its own core so both bots of a game share one core as they would share
+// one CodinGame worker. Results are folded in as they arrive.
+class TournamentScheduler {
+public:
+    TournamentScheduler(const ArenaOptions& options, int jobs, const Sprt& sprt)
+        : options(options), jobs(jobs), sprt(sprt) {}
+
+    void run() {
+        vector<Worker> workers(jobs);
+        int next_game = 0, running = 0;
+        bool stopping = false;
+        while (true) {
+            for (int w = 0; w < jobs && !stopping && next_game < options.games; w++) {
+                if (workers[w].pid > 0) continue;
+                if (!launch(workers[w], w, next_game)) {
+                    cerr << "cannot start game " << next_game + 1 << endl;
+                    stopping = true;
+                    break;
+                }
+                next_game++;
+                running++;
+            }
+            if (running == 0) break;
+
+            vector<pollfd> fds;
+            vector<int> owners;
+            for (int w = 0; w < jobs; w++) {
+                if (workers[w].pid <= 0) continue;
+                fds.push_back({workers[w].fd, POLLIN, 0});
+                owners.push_back(w);
+            }
+            if (poll(fds.data(), fds.size(), -1) < 0) {
+                if (errno == EINTR) continue;
+                break;
+            }
+            for (size_t i = 0; i < fds.size(); i++) {
+                if (!(fds[i].revents & (POLLIN | POLLHUP | POLLERR))) continue;
+                Worker& worker = workers[owners[i]];
+                char chunk[4096];
+                ssize_t n = read(worker.fd, chunk, sizeof(chunk));
+                if (n > 0) {
+                    worker.output.append(chunk, n);
+                    continue;
+                }
+                close(worker.fd);
+                waitpid(worker.pid, nullptr, 0);
+                worker.pid = -1;
+                running--;
+
+                GameOutcome outcome;
+                outcome.game = worker.game;
+                outcome.a_side = worker.game % 2;
+                if (!decode_outcome(worker.output, outcome)) {
+                    if (!stopping) cerr << "game " << worker.game + 1 << " worker died" << endl;
+                    continue;
+                }
+                if (record(outcome) && !stopping) {
+                    // The remaining games cannot change the verdict
+                    stopping = true;
+                    for (Worker& other : workers) {
+                        if (other.pid > 0) kill(-other.pid, SIGKILL);
+                    }
+                }
+            }
+        }
+        report();
+    }
+
+private:
+    struct Worker {
+        pid_t pid = -1;
+        int fd = -1;
+        int game = -1;
+        string output;
+    };
+
+    const ArenaOptions& options;
+    int jobs;
+    Sprt sprt;
+    int wins = 0, draws = 0, losses = 0;
+    vector<double> latency[2];
+    string verdict;
+
+    bool launch(Worker& worker, int slot, int game) {
+        int channel[2];
+        if (pipe(channel) != 0) return false;
+        pid_t pid = fork();
+        if (pid < 0) {
+            close(channel[0]);
+            close(channel[1]);
+            return false;
+        }
+        if (pid == 0) {
+            close(channel[0]);
+            // Start a process group so a stop signal reaches the bots too
+            setpgid(0, 0);
+            pin_to_core(slot);
+            string text = encode_outcome(play_game(options, game));
+            ssize_t written = write(channel[1], text.data(), text.size());
+            _exit(written == (ssize_t)text.size() ? 0 : 1);
+        }
+        close(channel[1]);
+        setpgid(pid, pid);
+        worker.pid = pid;
+        worker.fd = channel[0];
+        worker.game = game;
+        worker.output.clear();
+        return true;
+    }
+
+    static void pin_to_core(int slot) {
+#ifdef __linux__
+        long cores = sysconf(_SC_NPROCESSORS_ONLN);
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(slot % (cores > 0 ? cores : 1), &set);
+        sched_setaffinity(0, sizeof(set), &set);
+#else
+        (void)slot;
+#endif
+    }
+
+    // Folds one game in; true once the SPRT has accepted a hypothesis
+    bool record(const GameOutcome& o) {
+        if (o.score == 2) wins++;
+        else if (o.score == 1) draws++;
+        else losses++;
+        for (int b = 0; b < 2; b++) latency[b].insert(latency[b].end(), o.latency[b].begin(), o.latency[b].end());
+
+        static const char* NAMES[3] = {"loss", "draw", "win"};
+        if (options.verbose || o.reason.rfind("player", 0) == 0) {
+            cout << "game " << o.game + 1 << " seed " << options.first_seed + o.game << ": bot_a " << NAMES[o.score]
+                 << " as player " << o.a_side << ", " << o.points[0] << "-" << o.points[1] << " after " << o.turns
+                 << " turns (" << o.reason << ")" << endl;
+        }
+        if (!sprt.enabled) return false;
+        double llr = sprt.llr(wins, draws, losses);
+        if (options.verbose) printf("  +%d =%d -%d  LLR %.2f [%.2f, %.2f]\n", wins, draws, losses, llr, sprt.lower(), sprt.upper());
+        if (llr >= sprt.upper()) verdict = "H1 accepted";
+        else if (llr <= sprt.lower()) verdict = "H0 accepted";
+        return !verdict.empty();
+    }
+
+    void report() const {
+        int n = wins + draws + losses;
+        if (n == 0) return;
+        double score = (wins + 0.5 * draws) / n, low, high;
+        wilson_interval(score, n, low, high);
+        printf("bot_a %d wins, %d draws, %d losses over %d games\n", wins, draws, losses, n);
+        printf("bot_a score %.1f%% (95%% CI %.1f%% - %.1f%%)\n", 100 * score, 100 * low, 100 * high);
+        if (sprt.enabled) {
+            printf("SPRT elo0 %.1f elo1 %.1f: LLR %.2f [%.2f, %.2f], %s\n", sprt.elo0, sprt.elo1,
+                   sprt.llr(wins, draws, losses), sprt.lower(), sprt.upper(),
+                   verdict.empty() ? "inconclusive" : verdict.c_str());
+        }
+        for (int b = 0; b < 2; b++) {
+            const vector<double>& l = latency[b];
+            double mean = l.empty() ? 0 : accumulate(l.begin(), l.end(), 0.0) / l.size();
+            printf("bot_%c turn latency: mean %.2f ms, p99 %.2f ms over %zu turns\n", 'a' + b, mean, percentile(l, 0.99),
+                   l.size());
+        }
+    }
+};
+
+int main(int argc, char** argv) {
+    ArenaOptions options;
+    Sprt sprt;
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    int jobs = cores > 0 ? (int)cores : 1;
+    int bot_count = 0;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "-n" && i + 1 < argc) options.games = atoi(argv[++i]);
+        else if (arg == "-s" && i + 1 < argc) options.first_seed = atoll(argv[++i]);
+        else if (arg == "-j" && i + 1 < argc) jobs = max(1, atoi(argv[++i]));
+        else if (arg == "--turn-ms" && i + 1 < argc) options.turn_ms = atoi(argv[++i]);
+        else if (arg == "--first-turn-ms" && i + 1 < argc) options.first_turn_ms = atoi(argv[++i]);
+        else if (arg == "--sprt" && i + 2 < argc) {
+            sprt.enabled = true;
+            sprt.elo0 = atof(argv[++i]);
+            sprt.elo1 = atof(argv[++i]);
+        } else if (arg == "-v") options.verbose = true;
+        else if (bot_count < 2) options.bots[bot_count++] = arg;
+    }
+    if (bot_count < 2 || options.games <= 0) {
+        cerr << "usage: " << argv[0] << " [-n games] [-s first_seed] [-j jobs] [--turn-ms 50] [--first-turn-ms 1000]"
+             << " [--sprt elo0 elo1] [-v] bot_a bot_b" << endl;
+        return 2;
+    }
+    signal(SIGPIPE, SIG_IGN);
+
+    TournamentScheduler(options, jobs, sprt).run();
+    return 0;
+}
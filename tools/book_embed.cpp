@@ -0,0 +1,62 @@
+// BOOK EMBED
+// Turns an opening book file from tools/book_maker.cpp into
+// opening_book_data.h, the packed book semi_ai_smitmax.cpp compiles in, since
+// a submission is one source file. The literal is capped at max_chars, which
+// keeps the submission under the judge's source limit (tools/bundle.cpp checks
+// it): the earliest turns go in first, the deepest searches first within a turn.
+//
+//   g++ -std=c++17 -O2 -o book_embed tools/book_embed.cpp
+//   book_embed book.bin [max_chars] > opening_book_data.h
+
+#include <iostream>
+#include <string>
+#include "../opening_book.h"
+using namespace std;
+
+const size_t LINE_CHARS = 100;
+
+string pack_first(const vector<OpeningBookEntry>& by_priority, size_t count) {
+    vector<OpeningBookEntry> kept(by_priority.begin(), by_priority.begin() + count);
+    sort_opening_book(kept);
+    return pack_opening_book(kept);
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        cerr << "usage: book_embed book.bin [max_chars] > opening_book_data.h" << endl;
+        return 1;
+    }
+    size_t max_chars = argc > 2 ? stoul(argv[2]) : 20000;
+    OpeningBook book;
+    if (!book.open(argv[1])) {
+        cerr << "not an opening book: " << argv[1] << endl;
+        return 1;
+    }
+
+    vector<OpeningBookEntry> by_priority(book.begin(), book.end());
+    stable_sort(by_priority.begin(), by_priority.end(), [](const OpeningBookEntry& a, const OpeningBookEntry& b) {
+        return a.ply != b.ply ? a.ply < b.ply : a.visits > b.visits;
+    });
+
+    // Most entries that fit: packed length grows with the count
+    size_t low = 0, high = by_priority.size();
+    while (low < high) {
+        size_t mid = (low + high + 1) / 2;
+        if (pack_first(by_priority, mid).size() <= max_chars) low = mid;
+        else high = mid - 1;
+    }
+    string text = pack_first(by_priority, low);
+
+    cout << "#pragma once\n\n"
+         << "#include <cstddef>\n\n"
+         << "// OPENING BOOK DATA\n"
+         << "// Generated by tools/book_embed.cpp; do not edit. " << low << " of " << book.size()
+         << " positions,\n// packed as opening_book.h's pack_opening_book.\n\n"
+         << "constexpr char OPENING_BOOK_DATA[] =";
+    for (size_t i = 0; i < text.size(); i += LINE_CHARS) cout << "\n    \"" << text.substr(i, LINE_CHARS) << "\"";
+    if (text.empty()) cout << " \"\"";
+    cout << ";\n"
+         << "constexpr size_t OPENING_BOOK_DATA_LENGTH = sizeof(OPENING_BOOK_DATA) - 1;\n";
+    cerr << "embedded " << low << " of " << book.size() << " positions in " << text.size() << " characters" << endl;
+    return 0;
+}
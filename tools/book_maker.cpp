@@ -0,0 +1,133 @@
+// BOOK MAKER
+// Writes an opening book (opening_book.h) for semi_ai_smitmax.cpp. For each
+// referee seed it builds the map (tools/grid_maker.h, agents in the arena's
+// class order) and plays the opening against itself: every turn, each side's
+// view gets a long search_original, its choice goes in the book, and both
+// sides' orders, as the bot's output makes the referee apply them, step the
+// game to the next turn. Player 1's view of a turn is stored as the mirror of
+// a player 0 view, so a symmetric line costs one entry per turn.
+//
+//   g++ -std=c++17 -O2 -pthread -o book_maker tools/book_maker.cpp
+//   book_maker out.bin [first_seed] [seeds] [plies] [search_ms] [threads]
+//
+// The bot maps SMITSIMAX_BOOK, or opening_book.bin in its working directory.
+
+#define main semi_ai_main
+#include "../semi_ai_smitmax.cpp"
+#undef main
+#include "grid_maker.h"
+
+// Agent classes in AgentClass order, as the referee deals them out
+static const int CLASS_COOLDOWN[5] = {1, 5, 2, 2, 5};
+static const int CLASS_SOAKING_POWER[5] = {16, 24, 8, 16, 32};
+static const int CLASS_OPTIMAL_RANGE[5] = {4, 6, 2, 4, 2};
+static const int CLASS_BALLOONS[5] = {1, 0, 3, 2, 1};
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        cerr << "usage: book_maker out.bin [first_seed] [seeds] [plies] [search_ms] [threads]" << endl;
+        return 1;
+    }
+    const char* out_path = argv[1];
+    long long first_seed = argc > 2 ? atoll(argv[2]) : 1;
+    int seeds = argc > 3 ? atoi(argv[3]) : 100;
+    int plies = argc > 4 ? atoi(argv[4]) : 4;
+    int search_ms = argc > 5 ? atoi(argv[5]) : 1000;
+    int threads = argc > 6 ? atoi(argv[6]) : (int)max(1u, thread::hardware_concurrency());
+
+    // search_original narrates every decision; keep the progress readable
+    cerr.setstate(ios::failbit);
+    MergedSmitsimaxSearch search;
+    search.set_parallelism(threads, ROOT_PARALLEL);
+    search.set_tree_reuse(false);
+    RulesEngine engine;
+    vector<OpeningBookEntry> book;
+
+    for (long long seed = first_seed; seed < first_seed + seeds; seed++) {
+        GeneratedGrid grid = GeneratedGrid::make(seed);
+        RulesTable table;
+        table.init_map(grid.width, grid.height);
+        for (int y = 0; y < grid.height; y++) {
+            for (int x = 0; x < grid.width; x++) table.board.set_tile(x, y, grid.type(x, y));
+        }
+        table.build_map_tables();
+
+        // Game.initPlayers: ids 1..n on player 0's spawns, n+1..2n opposite
+        int n = (int)grid.spawns.size();
+        unordered_map<int, AgentData> agent_data;
+        RulesState state;
+        state.count = 2 * n;
+        state.my_count = n;
+        state.points[0] = state.points[1] = 0;
+        for (int s = 0; s < 2 * n; s++) {
+            int c = s % n;
+            AgentData data;
+            data.agent_id = s + 1;
+            data.player = s < n ? 0 : 1;
+            data.shoot_cooldown = CLASS_COOLDOWN[c];
+            data.optimal_range = CLASS_OPTIMAL_RANGE[c];
+            data.soaking_power = CLASS_SOAKING_POWER[c];
+            data.splash_bombs = CLASS_BALLOONS[c];
+            data.agent_class = determine_agent_class(data);
+            agent_data[data.agent_id] = data;
+
+            pair<int, int> at = s < n ? grid.spawns[c] : grid.opposite(grid.spawns[c].first, grid.spawns[c].second);
+            table.agent_id[s] = data.agent_id;
+            table.shoot_cooldown[s] = data.shoot_cooldown;
+            table.optimal_range[s] = data.optimal_range;
+            table.soaking_power[s] = data.soaking_power;
+            state.x[s] = (int8_t)at.first;
+            state.y[s] = (int8_t)at.second;
+            state.cooldown[s] = 0;
+            state.splash_bombs[s] = (uint8_t)data.splash_bombs;
+            state.wetness[s] = 0;
+        }
+        state.rehash();
+
+        for (int ply = 0; ply < plies && state.live_count(0) > 0 && state.live_count(1) > 0; ply++) {
+            PackedAction orders[RULES_MAX_AGENTS];
+            for (int s = 0; s < state.count; s++) orders[s] = PackedAction::move(state.x[s], state.y[s]);
+            for (int side = 0; side < 2; side++) {
+                // The turn input this side would read: live agents, mine first
+                vector<AgentState> mine, enemies;
+                vector<int> slots;
+                for (int pass = 0; pass < 2; pass++) {
+                    for (int s = 0; s < state.count; s++) {
+                        if (!state.is_alive(s) || (s < n) != ((pass == 0) == (side == 0))) continue;
+                        AgentState agent;
+                        agent.agent_id = table.agent_id[s];
+                        agent.x = state.x[s];
+                        agent.y = state.y[s];
+                        agent.cooldown = state.cooldown[s];
+                        agent.splash_bombs = state.splash_bombs[s];
+                        agent.wetness = state.wetness[s];
+                        (pass == 0 ? mine : enemies).push_back(agent);
+                        if (pass == 0) slots.push_back(s);
+                    }
+                }
+                search.initialize(mine, enemies, agent_data, table.board);
+                vector<SmitsimaxNode*> moves = search.search_original(search_ms);
+
+                PackedAction actions[OPENING_BOOK_MAX_SIDE];
+                int visits = INT_MAX;
+                for (size_t i = 0; i < mine.size() && i < (size_t)OPENING_BOOK_MAX_SIDE; i++) {
+                    actions[i] = moves[i] ? moves[i]->action : PackedAction::hunker_down();
+                    visits = min(visits, moves[i] ? moves[i]->visits : 0);
+                    orders[slots[i]] = issued_order(actions[i]);
+                }
+                book.push_back(make_opening_book_entry(search.rules_table(), search.root_state(), actions, visits, ply));
+            }
+            engine.step(table, state, orders);
+        }
+        cout << "seed " << seed << ": " << book.size() << " entries" << endl;
+    }
+
+    if (!OpeningBook::write(out_path, book)) {
+        cout << "could not write " << out_path << endl;
+        return 1;
+    }
+    OpeningBook written;
+    written.open(out_path);
+    cout << "wrote " << written.size() << " positions to " << out_path << endl;
+    return 0;
+}
@@ -0,0 +1,207 @@
+// BUNDLE
+// Turns a bot and the local headers it includes into the one source file
+// CodinGame accepts, and checks it against the judge's 100,000 character
+// limit. Each #include "..." is inlined where it first appears and dropped
+// after that, as #pragma once would; comments, indentation and blank lines
+// go, and a space is kept only where two tokens would otherwise run together.
+// String literals and preprocessor lines are copied as they are, except that
+// SUBMISSION counts as defined: #ifdef / #ifndef SUBMISSION blocks are
+// resolved here, so offline-only code never reaches the judge.
+//
+//   g++ -std=c++17 -O2 -o bundle tools/bundle.cpp
+//   bundle bot.cpp [max_chars] > submission.cpp
+//
+// Exits with 1 when the bundle is over max_chars (100000 by default, counted
+// in UTF-8 characters as the judge does), so both bots can be checked before
+// a change goes in:
+//
+//   bundle c.cpp > /dev/null && bundle semi_ai_smitmax.cpp > /dev/null
+
+#include <cctype>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+using namespace std;
+namespace fs = std::filesystem;
+
+static set<string> inlined;
+
+// One open #if: whether it tests SUBMISSION, and if so whether its current
+// branch is dropped
+struct Conditional {
+    bool submission;
+    bool dropped;
+};
+static vector<Conditional> conditionals;
+
+static bool dropping() {
+    for (const Conditional& c : conditionals) {
+        if (c.dropped) return true;
+    }
+    return false;
+}
+
+// Resolves the directives that test SUBMISSION; true when the line is one of
+// them and must not be copied
+static bool resolve_submission(const string& directive) {
+    istringstream words(directive);
+    string keyword, name;
+    words >> keyword >> name;
+    if (keyword == "#ifdef" || keyword == "#ifndef" || keyword == "#if") {
+        bool submission = keyword != "#if" && name == "SUBMISSION";
+        conditionals.push_back({submission, submission && keyword == "#ifndef"});
+        return submission;
+    }
+    if (conditionals.empty() || !conditionals.back().submission) {
+        if (keyword == "#endif" && !conditionals.empty()) conditionals.pop_back();
+        return false;
+    }
+    if (keyword == "#else") {
+        conditionals.back().dropped = !conditionals.back().dropped;
+        return true;
+    }
+    if (keyword == "#endif") {
+        conditionals.pop_back();
+        return true;
+    }
+    return false;
+}
+
+static bool read_file(const fs::path& path, string& text) {
+    ifstream in(path);
+    if (!in) return false;
+    stringstream buffer;
+    buffer << in.rdbuf();
+    text = buffer.str();
+    return true;
+}
+
+// The file with every local include replaced by the header's own expansion
+static bool expand(const fs::path& path, string& out) {
+    string text;
+    if (!read_file(path, text)) {
+        cerr << "cannot open " << path.string() << endl;
+        return false;
+    }
+    inlined.insert(fs::weakly_canonical(path).string());
+
+    istringstream lines(text);
+    for (string line; getline(lines, line);) {
+        size_t first = line.find_first_not_of(" \t");
+        string directive = first == string::npos ? "" : line.substr(first);
+        if (directive.rfind("#pragma once", 0) == 0) continue;
+        if (directive[0] == '#' && resolve_submission(directive)) continue;
+        if (dropping()) continue;
+        if (directive.rfind("#include \"", 0) == 0) {
+            size_t end = directive.find('"', 10);
+            fs::path header = path.parent_path() / directive.substr(10, end - 10);
+            if (inlined.count(fs::weakly_canonical(header).string())) continue;
+            if (!expand(header, out)) return false;
+            continue;
+        }
+        out += line;
+        out += '\n';
+    }
+    return true;
+}
+
+static bool is_word(char c) {
+    return isalnum((unsigned char)c) || c == '_' || (unsigned char)c >= 0x80;
+}
+
+// Two characters that would read as one token, or open a comment, if joined
+static bool would_merge(char a, char b) {
+    if (is_word(a) && is_word(b)) return true;
+    const char* operators = "+-*/%&|^<>=!:.#";
+    return a && b && strchr(operators, a) && strchr(operators, b);
+}
+
+static string minify(const string& source) {
+    string out;
+    bool pending_space = false;
+    size_t i = 0, n = source.size();
+
+    auto emit = [&](char c) {
+        if (pending_space && !out.empty() && out.back() != '\n' && would_merge(out.back(), c)) out += ' ';
+        pending_space = false;
+        out += c;
+    };
+
+    while (i < n) {
+        char c = source[i];
+        if (c == '/' && i + 1 < n && source[i + 1] == '/') {
+            while (i < n && source[i] != '\n') i++;
+            pending_space = true;
+        } else if (c == '/' && i + 1 < n && source[i + 1] == '*') {
+            size_t end = source.find("*/", i + 2);
+            i = end == string::npos ? n : end + 2;
+            pending_space = true;
+        } else if (c == '#' && (out.empty() || out.back() == '\n')) {
+            // A directive keeps its line, continuations included
+            if (!out.empty() && out.back() != '\n') out += '\n';
+            size_t end = i;
+            while (end < n && source[end] != '\n') {
+                end += source[end] == '\\' && end + 1 < n ? 2 : 1;
+            }
+            out.append(source, i, end - i);
+            out += '\n';
+            pending_space = false;
+            i = end;
+        } else if (c == '"' || c == '\'') {
+            emit(c);
+            for (i++; i < n && source[i] != c; i++) {
+                if (source[i] == '\\') out += source[i++];
+                out += source[i];
+            }
+            out += c;
+            i++;
+        } else if (isspace((unsigned char)c)) {
+            pending_space = true;
+            i++;
+            // A directive has to start its own line
+            size_t next = source.find_first_not_of(" \t\r\n", i);
+            if (next != string::npos && source[next] == '#' && source.find('\n', i - 1) < next) {
+                if (!out.empty() && out.back() != '\n') out += '\n';
+                pending_space = false;
+                i = next;
+            }
+        } else {
+            emit(c);
+            i++;
+        }
+    }
+    return out;
+}
+
+static size_t utf8_length(const string& text) {
+    size_t length = 0;
+    for (char c : text) length += ((unsigned char)c & 0xC0) != 0x80;
+    return length;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        cerr << "usage: bundle bot.cpp [max_chars] > submission.cpp" << endl;
+        return 2;
+    }
+    size_t max_chars = argc > 2 ? stoul(argv[2]) : 100000;
+
+    string source;
+    if (!expand(argv[1], source)) return 2;
+    string bundle = minify(source);
+    cout << bundle;
+
+    size_t chars = utf8_length(bundle);
+    cerr << argv[1] << ": " << inlined.size() << " files, " << utf8_length(source) << " characters, "
+         << chars << " bundled, limit " << max_chars << endl;
+    if (chars > max_chars) {
+        cerr << argv[1] << " is " << chars - max_chars << " characters over the limit" << endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,213 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// GRID MAKER
+// game/grid/GridMaker.initGrid driven by a port of java.util.Random, so a seed
+// gives the same map, spawns and symmetry as the referee seeded with it (the
+// league referee draws nothing from its Random before building the grid).
+
+class JavaRandom {
+public:
+    explicit JavaRandom(int64_t seed) : seed((seed ^ MULTIPLIER) & MASK) {}
+
+    int next_int() { return next(32); }
+    bool next_bool() { return next(1) != 0; }
+
+    // Random.nextInt(bound)
+    int next_int(int bound) {
+        if ((bound & -bound) == bound) return (int)((bound * (int64_t)next(31)) >> 31);
+        int bits, value;
+        do {
+            bits = next(31);
+            value = bits % bound;
+        } while (bits - value + (bound - 1) < 0);
+        return value;
+    }
+
+    // RandomGenerator.nextInt(origin, bound) as java.util.Random inherits it
+    int next_int(int origin, int bound) {
+        int r = next_int();
+        int n = bound - origin, m = n - 1;
+        if ((n & m) == 0) return (r & m) + origin;
+        for (uint32_t u = (uint32_t)r >> 1; (int)(u + m - (uint32_t)(r = (int)(u % (uint32_t)n))) < 0;
+             u = (uint32_t)next_int() >> 1) {
+        }
+        return r + origin;
+    }
+
+    // Collections.shuffle(list, random)
+    template <typename T>
+    void shuffle(std::vector<T>& list) {
+        for (int i = (int)list.size(); i > 1; i--) std::swap(list[i - 1], list[next_int(i)]);
+    }
+
+private:
+    static const int64_t MULTIPLIER = 0x5DEECE66DLL;
+    static const int64_t MASK = (1LL << 48) - 1;
+    int64_t seed;
+
+    int next(int bits) {
+        seed = (seed * MULTIPLIER + 0xB) & MASK;
+        return (int)(seed >> (48 - bits));
+    }
+};
+
+struct GeneratedGrid {
+    static const int MIN_SPAWN_COUNT = 3, MAX_SPAWN_COUNT = 5;
+    static const int MIN_HEIGHT = 6, MAX_HEIGHT = 10;
+
+    int width = 0, height = 0;
+    bool y_symmetry = false;
+    std::vector<int> tiles;                  // Tile type per y * width + x
+    std::vector<std::pair<int, int>> spawns; // Player 0 spawns; player 1 gets opposite()
+
+    int type(int x, int y) const { return tiles[y * width + x]; }
+    bool contains(int x, int y) const { return x >= 0 && x < width && y >= 0 && y < height; }
+    bool is_cover(int x, int y) const { return type(x, y) != 0; }
+
+    std::pair<int, int> opposite(int x, int y) const {
+        return {width - x - 1, y_symmetry ? height - y - 1 : y};
+    }
+
+    void set_mirrored(int x, int y, int tile_type) {
+        tiles[y * width + x] = tile_type;
+        std::pair<int, int> o = opposite(x, y);
+        tiles[o.second * width + o.first] = tile_type;
+    }
+
+    static GeneratedGrid make(int64_t seed) {
+        JavaRandom random(seed);
+        GeneratedGrid grid;
+        grid.height = random.next_int(MIN_HEIGHT, MAX_HEIGHT + 1);
+        grid.width = grid.height * 2;
+        // Evaluation order matters: the second draw only happens on false
+        grid.y_symmetry = random.next_bool() || random.next_bool();
+        grid.tiles.assign(grid.width * grid.height, 0);
+
+        for (int y = 1; y < grid.height - 1; y++) {
+            for (int x = 1; x < grid.width / 2 - 1; x++) {
+                int n = random.next_int(10);
+                grid.set_mirrored(x, y, n == 0 ? 2 : (n == 1 ? 1 : 0));
+            }
+        }
+
+        std::vector<std::pair<int, int>> left;
+        for (int y = 0; y < grid.height; y++) left.push_back({0, y});
+        int spawn_count = random.next_int(MIN_SPAWN_COUNT, MAX_SPAWN_COUNT + 1);
+        random.shuffle(left);
+        if (spawn_count == 5 && random.next_bool()) spawn_count--;
+        if (spawn_count == 4 && random.next_bool()) spawn_count--;
+        for (int i = 0; i < spawn_count; i++) {
+            grid.spawns.push_back(left[i]);
+            grid.set_mirrored(left[i].first, left[i].second, 0);
+        }
+
+        std::vector<int> walls;
+        for (int t = 0; t < grid.width * grid.height; t++) {
+            if (grid.tiles[t] != 0) walls.push_back(t);
+        }
+        grid.fix_islands(walls, random);
+        return grid;
+    }
+
+private:
+    // Grid.ADJACENCY: north, east, south, west
+    static constexpr int DX[4] = {0, 1, 0, -1};
+    static constexpr int DY[4] = {-1, 0, 1, 0};
+
+    // detectIslands: island label per floor tile, -1 on cover
+    int detect_islands(std::vector<int>& island) const {
+        island.assign(width * height, -1);
+        int count = 0;
+        std::vector<int> queue;
+        for (int t = 0; t < width * height; t++) {
+            if (tiles[t] != 0 || island[t] >= 0) continue;
+            queue.assign(1, t);
+            island[t] = count;
+            for (std::size_t head = 0; head < queue.size(); head++) {
+                int x = queue[head] % width, y = queue[head] / width;
+                for (int d = 0; d < 4; d++) {
+                    int nx = x + DX[d], ny = y + DY[d];
+                    if (!contains(nx, ny) || is_cover(nx, ny) || island[ny * width + nx] >= 0) continue;
+                    island[ny * width + nx] = count;
+                    queue.push_back(ny * width + nx);
+                }
+            }
+            count++;
+        }
+        return count;
+    }
+
+    void clear_wall(std::vector<int>& walls, int t) {
+        std::pair<int, int> o = opposite(t % width, t / width);
+        int ot = o.second * width + o.first;
+        tiles[t] = tiles[ot] = 0;
+        for (int w : {t, ot}) {
+            for (std::size_t i = 0; i < walls.size(); i++) {
+                if (walls[i] == w) {
+                    walls.erase(walls.begin() + i);
+                    break;
+                }
+            }
+        }
+    }
+
+    // closeIslandGap: the first wall touching two islands becomes floor and
+    // the islands merge. Like the Java sets, the bridge tile itself joins no
+    // island until the next detectIslands.
+    bool close_island_gap(std::vector<int>& walls, std::vector<int>& island, int& islands) {
+        for (int t : walls) {
+            int x = t % width, y = t / width, first = -1;
+            for (int d = 0; d < 4; d++) {
+                int nx = x + DX[d], ny = y + DY[d];
+                if (!contains(nx, ny)) continue;
+                int label = island[ny * width + nx];
+                if (label < 0) continue;
+                if (first < 0) {
+                    first = label;
+                } else if (label != first) {
+                    for (int b = 0; b < 4; b++) {
+                        int bx = x + DX[b], by = y + DY[b];
+                        if (!contains(bx, by)) continue;
+                        int merged = island[by * width + bx];
+                        if (merged < 0 || merged == first) continue;
+                        for (int& l : island) {
+                            if (l == merged) l = first;
+                        }
+                        islands--;
+                    }
+                    clear_wall(walls, t);
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    void fix_islands(std::vector<int> walls, JavaRandom& random) {
+        random.shuffle(walls);
+        std::vector<int> island;
+        int islands = detect_islands(island);
+        while (islands > 1) {
+            if (close_island_gap(walls, island, islands)) continue;
+            // findWallAdjacentToFreeSpace
+            for (int t : walls) {
+                int x = t % width, y = t / width;
+                bool free = false;
+                for (int d = 0; d < 4; d++) {
+                    int nx = x + DX[d], ny = y + DY[d];
+                    if (contains(nx, ny) && !is_cover(nx, ny)) free = true;
+                }
+                if (free) {
+                    clear_wall(walls, t);
+                    break;
+                }
+            }
+            islands = detect_islands(island);
+        }
+    }
+};
@@ -0,0 +1,49 @@
+#!/bin/sh
+# RECORD TRACES
+# Records tools/traces/referee.trace, the reference tools/rules_replay.cpp
+# checks rules_engine.h against, then replays it. This tree holds only the
+# referee's rules (game/); the Maven project they build in (the pom with the
+# CodinGame SDK, the event and view sources, config/) is the game's SDK
+# project, given as the first argument. A copy of it gets game/'s sources,
+# GameTrace.java included, tools/RecordTraces.java is compiled against it, and
+# semi_ai_smitmax.cpp and c.cpp play `games` games from `first_seed`, swapping
+# sides every game.
+#
+#   tools/record_traces.sh path/to/sdk-project [first_seed] [games]
+#
+# Needs a JDK, Maven and g++. The project itself is not modified; the trace is
+# replaced. Exits with rules_replay's status, so 0 means the engine matches.
+
+set -e
+
+repo=$(cd "$(dirname "$0")/.." && pwd)
+project=${1:?usage: tools/record_traces.sh path/to/sdk-project [first_seed] [games]}
+first_seed=${2:-1}
+games=${3:-8}
+trace="$repo/tools/traces/referee.trace"
+
+if [ ! -f "$project/pom.xml" ] || [ ! -d "$project/src/main/java/com/codingame/game" ]; then
+    echo "$project is not the referee's SDK project (no pom.xml or com/codingame/game sources)" >&2
+    exit 2
+fi
+
+work=$(mktemp -d)
+trap 'rm -rf "$work"' EXIT
+cp -R "$project"/. "$work"
+(cd "$repo/game" && find . -name '*.java' | tar -cf - -T -) | (cd "$work/src/main/java/com/codingame/game" && tar -xf -)
+
+g++ -std=c++17 -O2 -pthread -o "$work/bot_semi" "$repo/semi_ai_smitmax.cpp"
+g++ -std=c++17 -O2 -pthread -o "$work/bot_c" "$repo/c.cpp"
+g++ -std=c++17 -O2 -o "$work/rules_replay" "$repo/tools/rules_replay.cpp"
+
+(cd "$work" && mvn -q compile dependency:build-classpath -Dmdep.outputFile=classpath.txt)
+classpath="$work/target/classes:$(cat "$work/classpath.txt")"
+javac -d "$work/target/classes" -cp "$classpath" "$repo/tools/RecordTraces.java"
+
+# The runner reads config/ from the working directory
+mkdir -p "$(dirname "$trace")"
+rm -f "$trace"
+(cd "$work" && java -Dgame.trace="$trace" -cp "$classpath" RecordTraces "$first_seed" "$games" \
+    "$work/bot_semi" "$work/bot_c")
+
+"$work/rules_replay" "$trace"
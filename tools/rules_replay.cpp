@@ -0,0 +1,223 @@
+// RULES REPLAY
+// Differential test and throughput benchmark for rules_engine.h. Reads a trace
+// written by the Java referee (game/GameTrace.java, enabled with
+// -Dgame.trace=path), replays every recorded turn through RulesEngine::step
+// from the recorded input state and commands, and checks positions, wetness,
+// cooldowns, balloons, control zones and points against what Game.java
+// produced, and the engine's running Zobrist key against a fresh one. Then
+// replays the whole trace again to time the engine.
+//
+//   g++ -std=c++17 -O2 -o rules_replay tools/rules_replay.cpp
+//   rules_replay trace.txt [timing_passes]
+//
+// Exits with 1 when any turn differs, so it can gate changes to the engine.
+// The reference trace is meant to be tools/traces/referee.trace, recorded
+// with tools/record_traces.sh from the referee's SDK project. None is
+// committed yet, so the engine has not been checked against Game.java this
+// way. Once a trace is recorded, every change to rules_engine.h must pass
+//
+//   rules_replay tools/traces/referee.trace
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "../rules_engine.h"
+using namespace std;
+
+struct TraceAgent {
+    int id, x, y, cooldown, balloons, wetness;
+};
+
+struct AgentStats {
+    int owner, shoot_cooldown, optimal_range, soaking_power;
+};
+
+// One performGameUpdate: the input state and commands, and Java's result
+struct TraceTurn {
+    int game, turn;
+    shared_ptr<const RulesTable> table;   // Shared by turns with the same map and line-up
+    RulesState state;
+    PackedAction orders[RULES_MAX_AGENTS];
+    vector<TraceAgent> expected;
+    int expected_points[2];
+    int expected_zones[2];
+};
+
+static PackedAction parse_order(int x, int y, int move_x, int move_y, const string& combat, int arg1, int arg2) {
+    bool move = move_x >= 0;
+    if (combat == "SHOOT") return move ? PackedAction::move_shoot(move_x, move_y, arg1) : PackedAction::shoot(arg1);
+    if (combat == "THROW") return move ? PackedAction::move_throw(move_x, move_y, arg1, arg2) : PackedAction::throw_at(arg1, arg2);
+    if (combat == "HUNKER") return move ? PackedAction::move_hunker(move_x, move_y) : PackedAction::hunker_down();
+    // No combat action: a move alone, or an idle agent that must not hunker
+    return move ? PackedAction::move(move_x, move_y) : PackedAction::move(x, y);
+}
+
+static bool load_trace(const char* path, vector<TraceTurn>& turns) {
+    ifstream in(path);
+    if (!in) {
+        cerr << "cannot open " << path << endl;
+        return false;
+    }
+    RulesTable map_table;
+    shared_ptr<const RulesTable> last_table;
+    map<int, AgentStats> stats;
+    int game = -1;
+    string line, tag;
+    while (getline(in, line)) {
+        istringstream ss(line);
+        ss >> tag;
+        if (tag == "MAP") {
+            int width, height;
+            string tiles;
+            ss >> width >> height >> tiles;
+            map_table.init_map(width, height);
+            for (int i = 0; i < width * height && i < (int)tiles.size(); i++) {
+                map_table.board.set_tile(i % width, i / width, tiles[i] - '0');
+            }
+            map_table.build_map_tables();
+            last_table.reset();
+            stats.clear();
+            game++;
+        } else if (tag == "AGENT") {
+            int id;
+            AgentStats s;
+            ss >> id >> s.owner >> s.shoot_cooldown >> s.optimal_range >> s.soaking_power;
+            stats[id] = s;
+        } else if (tag == "TURN") {
+            turns.emplace_back();
+            TraceTurn& t = turns.back();
+            int n;
+            ss >> t.turn >> t.state.points[0] >> t.state.points[1] >> n;
+            if (game < 0 || n > RULES_MAX_AGENTS) {
+                cerr << "malformed trace at turn " << t.turn << endl;
+                return false;
+            }
+            t.game = game;
+            t.state.count = (uint8_t)n;
+            t.state.my_count = 0;
+            // Game.allAgentStream lists player 0's agents first
+            for (int s = 0; s < n && getline(in, line); s++) {
+                istringstream as(line);
+                int id, x, y, cooldown, balloons, wetness, move_x, move_y, arg1, arg2;
+                string combat;
+                as >> tag >> id >> x >> y >> cooldown >> balloons >> wetness >> move_x >> move_y >> combat >> arg1 >> arg2;
+                const AgentStats& st = stats[id];
+                map_table.agent_id[s] = id;
+                map_table.shoot_cooldown[s] = st.shoot_cooldown;
+                map_table.optimal_range[s] = st.optimal_range;
+                map_table.soaking_power[s] = st.soaking_power;
+                t.state.x[s] = (int8_t)x;
+                t.state.y[s] = (int8_t)y;
+                t.state.cooldown[s] = (uint8_t)cooldown;
+                t.state.splash_bombs[s] = (uint8_t)balloons;
+                t.state.wetness[s] = (int16_t)wetness;
+                if (st.owner == 0) t.state.my_count = (uint8_t)(s + 1);
+                t.orders[s] = parse_order(x, y, move_x, move_y, combat, arg1, arg2);
+            }
+            t.state.rehash();
+            bool same_line_up = last_table != nullptr;
+            for (int s = 0; s < n && same_line_up; s++) {
+                same_line_up = last_table->agent_id[s] == map_table.agent_id[s];
+            }
+            if (!same_line_up) last_table = make_shared<const RulesTable>(map_table);
+            t.table = last_table;
+        } else if (tag == "AFTER" && !turns.empty()) {
+            TraceTurn& t = turns.back();
+            int n;
+            ss >> t.expected_points[0] >> t.expected_points[1] >> t.expected_zones[0] >> t.expected_zones[1] >> n;
+            for (int s = 0; s < n && getline(in, line); s++) {
+                istringstream as(line);
+                TraceAgent a;
+                as >> tag >> a.id >> a.x >> a.y >> a.cooldown >> a.balloons >> a.wetness;
+                t.expected.push_back(a);
+            }
+        }
+    }
+    return true;
+}
+
+// Prints every difference between the engine's result and Java's
+static bool check_turn(const TraceTurn& t, const RulesState& state, int max_reports, int& reported) {
+    bool same = true;
+    auto report = [&](const string& what, int got, int want) {
+        same = false;
+        if (reported++ < max_reports) {
+            cerr << "game " << t.game << " turn " << t.turn << ": " << what << " engine " << got << " java " << want << endl;
+        }
+    };
+
+    if ((int)t.expected.size() != state.count) {
+        report("agent count", state.count, (int)t.expected.size());
+        return false;
+    }
+    for (int s = 0; s < state.count; s++) {
+        const TraceAgent& a = t.expected[s];
+        string agent = "agent " + to_string(a.id) + " ";
+        if (t.table->agent_id[s] != a.id) report(agent + "slot id", t.table->agent_id[s], a.id);
+        if (state.x[s] != a.x) report(agent + "x", state.x[s], a.x);
+        if (state.y[s] != a.y) report(agent + "y", state.y[s], a.y);
+        if (state.wetness[s] != a.wetness) report(agent + "wetness", state.wetness[s], a.wetness);
+        if (state.cooldown[s] != a.cooldown) report(agent + "cooldown", state.cooldown[s], a.cooldown);
+        if (state.splash_bombs[s] != a.balloons) report(agent + "balloons", state.splash_bombs[s], a.balloons);
+    }
+    // The incrementally kept Zobrist key must match one computed from scratch
+    RulesState fresh = state;
+    fresh.rehash();
+    if (fresh.hash != state.hash) report("zobrist hash matches rehash", 0, 1);
+    int owned[2];
+    RulesEngine::control_zones(*t.table, state, owned);
+    for (int team = 0; team < 2; team++) {
+        string side = "team " + to_string(team) + " ";
+        if (owned[team] != t.expected_zones[team]) report(side + "zones", owned[team], t.expected_zones[team]);
+        if (state.points[team] != t.expected_points[team]) report(side + "points", state.points[team], t.expected_points[team]);
+    }
+    return same;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        cerr << "usage: " << argv[0] << " trace.txt [timing_passes]" << endl;
+        return 2;
+    }
+    int passes = argc > 2 ? atoi(argv[2]) : 20;
+
+    vector<TraceTurn> turns;
+    if (!load_trace(argv[1], turns)) return 2;
+    if (turns.empty()) {
+        cerr << "no turns in " << argv[1] << endl;
+        return 2;
+    }
+
+    RulesEngine engine;
+    int failed = 0, reported = 0;
+    for (const TraceTurn& t : turns) {
+        RulesState state = t.state;
+        engine.step(*t.table, state, t.orders);
+        if (!check_turn(t, state, 50, reported)) failed++;
+    }
+    int games = turns.back().game + 1;
+    cout << games << " games, " << turns.size() << " turns, " << failed << " differ" << endl;
+
+    // Throughput over the same recorded turns; the checksum keeps the
+    // compiler from dropping the steps
+    long long checksum = 0;
+    auto start = chrono::steady_clock::now();
+    for (int pass = 0; pass < passes; pass++) {
+        for (const TraceTurn& t : turns) {
+            RulesState state = t.state;
+            engine.step(*t.table, state, t.orders);
+            checksum += state.points[0] + state.wetness[0];
+        }
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    double stepped = (double)passes * turns.size();
+    cout << "turns/s " << (long long)(stepped / seconds) << " (" << seconds * 1e9 / stepped << " ns/turn, checksum "
+         << checksum << ")" << endl;
+
+    return failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,132 @@
+// SCENARIO INDEX CHECK
+// Equivalence check for scenario_index.h. Random points are shaped like the
+// opening book's features: x, y and wetness for each of 10 slots, 30
+// dimensions. They are spread over a few groups. Each query asks for its k
+// nearest points in one group (k from 1 to 8). The k-d tree's answer must
+// match a brute-force scan of that group: the same squared distances in the
+// same order, and each returned id really at its reported distance. Ids may
+// differ only where distances tie. Some queries repeat a stored point, so
+// distance 0 and duplicate points are covered. Then times both searches.
+//
+//   g++ -std=c++17 -O2 -o scenario_index_check tools/scenario_index_check.cpp
+//   scenario_index_check [points] [queries] [seed]
+//
+// Exits with 1 on the first query where the two disagree.
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "../scenario_index.h"
+using namespace std;
+
+const int DIMENSIONS = 30;
+const int GROUPS = 4;
+const int MAX_K = 8;
+
+typedef ScenarioIndex<DIMENSIONS> Index;
+
+struct Point {
+    uint64_t group;
+    int16_t features[DIMENSIONS];
+};
+
+static int squared_distance(const int16_t* a, const int16_t* b) {
+    int sum = 0;
+    for (int d = 0; d < DIMENSIONS; d++) sum += (a[d] - b[d]) * (a[d] - b[d]);
+    return sum;
+}
+
+// Slot features as the book has them: x in [0, 20), y in [0, 10), wetness in
+// steps of 10 so that equal distances are common
+static void random_features(mt19937& rng, int16_t* features) {
+    for (int d = 0; d < DIMENSIONS; d += 3) {
+        features[d] = (int16_t)uniform_int_distribution<>(0, 19)(rng);
+        features[d + 1] = (int16_t)uniform_int_distribution<>(0, 9)(rng);
+        features[d + 2] = (int16_t)(10 * uniform_int_distribution<>(0, 10)(rng));
+    }
+}
+
+static int brute_force(const vector<Point>& points, uint64_t group, const int16_t* query, int k, Index::Match* out) {
+    vector<Index::Match> all;
+    for (int id = 0; id < (int)points.size(); id++) {
+        if (points[id].group == group) all.push_back({id, squared_distance(points[id].features, query)});
+    }
+    int found = min(k, (int)all.size());
+    partial_sort(all.begin(), all.begin() + found, all.end(),
+                 [](const Index::Match& a, const Index::Match& b) { return a.distance < b.distance; });
+    copy(all.begin(), all.begin() + found, out);
+    return found;
+}
+
+int main(int argc, char** argv) {
+    int point_count = argc > 1 ? atoi(argv[1]) : 3000;
+    int query_count = argc > 2 ? atoi(argv[2]) : 2000;
+    unsigned seed = argc > 3 ? (unsigned)atoi(argv[3]) : 1;
+
+    mt19937 rng(seed);
+    vector<Point> points(point_count);
+    Index index;
+    for (int id = 0; id < point_count; id++) {
+        Point& p = points[id];
+        p.group = uniform_int_distribution<>(0, GROUPS - 1)(rng);
+        if (id > 0 && uniform_int_distribution<>(0, 19)(rng) == 0) {
+            copy(points[id - 1].features, points[id - 1].features + DIMENSIONS, p.features);
+        } else {
+            random_features(rng, p.features);
+        }
+        index.add(p.group, p.features, id);
+    }
+    index.build();
+
+    vector<Point> queries(query_count);
+    vector<int> ks(query_count);
+    for (int q = 0; q < query_count; q++) {
+        // A quarter of the queries land exactly on a stored point
+        if (point_count > 0 && uniform_int_distribution<>(0, 3)(rng) == 0) {
+            queries[q] = points[uniform_int_distribution<>(0, point_count - 1)(rng)];
+        } else {
+            queries[q].group = uniform_int_distribution<>(0, GROUPS)(rng); // GROUPS itself is empty
+            random_features(rng, queries[q].features);
+        }
+        ks[q] = uniform_int_distribution<>(1, MAX_K)(rng);
+    }
+
+    for (int q = 0; q < query_count; q++) {
+        Index::Match tree[MAX_K], scan[MAX_K];
+        int tree_found = index.nearest(queries[q].group, queries[q].features, ks[q], tree);
+        int scan_found = brute_force(points, queries[q].group, queries[q].features, ks[q], scan);
+        bool same = tree_found == scan_found;
+        for (int i = 0; i < tree_found && same; i++) {
+            const Point& match = points[tree[i].id];
+            same = tree[i].distance == scan[i].distance && match.group == queries[q].group
+                && squared_distance(match.features, queries[q].features) == tree[i].distance;
+        }
+        if (same) continue;
+        cout << "query " << q << " (group " << queries[q].group << ", k " << ks[q] << "): k-d tree";
+        for (int i = 0; i < tree_found; i++) cout << " " << tree[i].id << "@" << tree[i].distance;
+        cout << ", brute force";
+        for (int i = 0; i < scan_found; i++) cout << " " << scan[i].id << "@" << scan[i].distance;
+        cout << endl;
+        return 1;
+    }
+    cout << query_count << " queries over " << index.size() << " points in " << GROUPS
+         << " groups, k-d tree matches brute force" << endl;
+
+    for (int pass = 0; pass < 2; pass++) {
+        long long checksum = 0;
+        auto start = chrono::steady_clock::now();
+        for (int q = 0; q < query_count; q++) {
+            Index::Match out[MAX_K];
+            int found = pass == 0 ? index.nearest(queries[q].group, queries[q].features, ks[q], out)
+                                  : brute_force(points, queries[q].group, queries[q].features, ks[q], out);
+            for (int i = 0; i < found; i++) checksum += out[i].distance;
+        }
+        double us = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count();
+        cout << (pass == 0 ? "  k-d tree: " : "brute force: ") << fixed << setprecision(2) << us / max(1, query_count)
+             << " us per query (checksum " << checksum << ")" << endl;
+    }
+    return 0;
+}
@@ -0,0 +1,188 @@
+// SEARCH BENCH
+// Throughput of semi_ai_smitmax.cpp's search_original against thread count,
+// root-parallel versus tree-parallel. Builds the opening position of a
+// referee-seeded map (tools/grid_maker.h, agents in the arena's class order),
+// runs a fixed-length search per configuration and reports iterations/s and
+// the size of the largest single tree set (the shared one for tree-parallel,
+// the biggest worker's for root-parallel). Rollouts stop at MAX_SEARCH_DEPTH,
+// so a tree grows deeper by filling in, not by getting longer. The cores the
+// machine has bound what can scale.
+//
+// The reuse mode plays consecutive turns instead: each side searches with its
+// own MergedSmitsimaxSearch, the rules engine plays both sides' orders, and
+// the next turn starts from the result. On every turn my trees are promoted,
+// each agent's new root must hold exactly the visits of the combat node it
+// played; a mismatch, or a game in which no turn promotes, exits with 1.
+//
+//   g++ -std=c++17 -O2 -pthread -o search_bench tools/search_bench.cpp
+//   search_bench [max_threads] [search_ms] [seed] [repeats]
+//   search_bench reuse [turns] [search_ms] [seed]
+
+#define main semi_ai_main
+#include "../semi_ai_smitmax.cpp"
+#undef main
+#include <iomanip>
+#include "grid_maker.h"
+
+// Agent classes in AgentClass order, as the referee deals them out
+static const int CLASS_COOLDOWN[5] = {1, 5, 2, 2, 5};
+static const int CLASS_SOAKING_POWER[5] = {16, 24, 8, 16, 32};
+static const int CLASS_OPTIMAL_RANGE[5] = {4, 6, 2, 4, 2};
+static const int CLASS_BALLOONS[5] = {1, 0, 3, 2, 1};
+
+// The turn input a side reads from a rules state: its live agents, then the
+// other side's, in slot order
+static void turn_input(const RulesTable& table, const RulesState& state, int side,
+                       vector<AgentState>& mine, vector<AgentState>& enemies) {
+    mine.clear();
+    enemies.clear();
+    for (int s = 0; s < state.count; s++) {
+        if (!state.is_alive(s)) continue;
+        AgentState agent;
+        agent.agent_id = table.agent_id[s];
+        agent.x = state.x[s];
+        agent.y = state.y[s];
+        agent.cooldown = state.cooldown[s];
+        agent.splash_bombs = state.splash_bombs[s];
+        agent.wetness = state.wetness[s];
+        (state.is_mine(s) == (side == 0) ? mine : enemies).push_back(agent);
+    }
+}
+
+static int check_tree_reuse(const vector<AgentState>& start_mine, const vector<AgentState>& start_enemies,
+                            const unordered_map<int, AgentData>& agent_data, const BoardLayers& board,
+                            int turns, int search_ms) {
+    MergedSmitsimaxSearch search, opponent;
+    opponent.set_tree_reuse(false);
+    RulesEngine engine;
+    RulesTable table;
+    RulesState state;
+    vector<AgentState> mine = start_mine, enemies = start_enemies;
+    int played_visits[MAX_AGENTS];
+    int promoted_turns = 0, mismatches = 0;
+
+    for (int turn = 1; turn <= turns && !mine.empty() && !enemies.empty(); turn++) {
+        search.initialize(mine, enemies, agent_data, board);
+        if (turn == 1) {
+            table = search.rules_table();
+            state = search.root_state();
+        }
+        if (search.reused_last_turn()) {
+            promoted_turns++;
+            for (int i = 0; i < (int)mine.size(); i++) {
+                if (search.root_visits(i) == played_visits[i]) continue;
+                cout << "turn " << turn << ": agent " << mine[i].agent_id << "'s root has " << search.root_visits(i)
+                     << " visits, the node it was played from had " << played_visits[i] << endl;
+                mismatches++;
+            }
+        }
+        opponent.initialize(enemies, mine, agent_data, board);
+        vector<SmitsimaxNode*> moves = search.search_original(search_ms);
+        vector<SmitsimaxNode*> replies = opponent.search_original(search_ms);
+        cout << "turn " << setw(3) << turn << ": " << (search.reused_last_turn() ? "promoted" : "fresh   ")
+             << setw(8) << search.iterations_last_search() << " iterations" << endl;
+
+        // Slots stay in input order, so my agents come first and the
+        // opponent's follow; both lists skip the dead
+        PackedAction orders[RULES_MAX_AGENTS];
+        int mine_seen = 0, theirs_seen = 0;
+        for (int s = 0; s < state.count; s++) {
+            orders[s] = PackedAction::hunker_down();
+            if (!state.is_alive(s)) continue;
+            SmitsimaxNode* move = state.is_mine(s) ? moves[mine_seen++] : replies[theirs_seen++];
+            if (move) orders[s] = move->action;
+        }
+        for (int i = 0; i < (int)moves.size(); i++) {
+            PackedAction action = moves[i] ? moves[i]->action : PackedAction::hunker_down();
+            search.note_played(i, action, issued_order(action));
+            played_visits[i] = moves[i] ? moves[i]->visits : 0;
+        }
+        for (int s = 0; s < state.count; s++) orders[s] = issued_order(orders[s]);
+        engine.step(table, state, orders);
+        turn_input(table, state, 0, mine, enemies);
+    }
+
+    cout << promoted_turns << " turn(s) promoted, " << mismatches << " root visit mismatch(es)" << endl;
+    if (promoted_turns == 0) cout << "tree reuse never promoted" << endl;
+    return mismatches == 0 && promoted_turns > 0 ? 0 : 1;
+}
+
+int main(int argc, char** argv) {
+    bool reuse = argc > 1 && string(argv[1]) == "reuse";
+    int turns = reuse && argc > 2 ? atoi(argv[2]) : 20;
+    int max_threads = !reuse && argc > 1 ? atoi(argv[1]) : (int)max(1u, thread::hardware_concurrency());
+    TimeBudgetConfig turn; // A later turn's budget by default
+    int search_ms = argc > 2 + reuse ? atoi(argv[2 + reuse]) : (int)(turn.turn_ms - turn.safety_margin_ms);
+    int seed = argc > 3 + reuse ? atoi(argv[3 + reuse]) : 1;
+    int repeats = !reuse && argc > 4 ? atoi(argv[4]) : 5;
+
+    GeneratedGrid grid = GeneratedGrid::make(seed);
+    BoardLayers board;
+    board.init(grid.width, grid.height);
+    for (int y = 0; y < grid.height; y++) {
+        for (int x = 0; x < grid.width; x++) board.set_tile(x, y, grid.type(x, y));
+    }
+
+    // Agent ids 1..n take player 0's spawns, n+1..2n the opposite tiles
+    int n = (int)grid.spawns.size();
+    unordered_map<int, AgentData> agent_data;
+    vector<AgentState> mine, enemies;
+    for (int i = 0; i < 2 * n; i++) {
+        int c = (i % n) % 5;
+        AgentData data;
+        data.agent_id = i + 1;
+        data.player = i < n ? 0 : 1;
+        data.shoot_cooldown = CLASS_COOLDOWN[c];
+        data.optimal_range = CLASS_OPTIMAL_RANGE[c];
+        data.soaking_power = CLASS_SOAKING_POWER[c];
+        data.splash_bombs = CLASS_BALLOONS[c];
+        data.agent_class = determine_agent_class(data);
+        agent_data[data.agent_id] = data;
+
+        pair<int, int> spawn = grid.spawns[i % n];
+        if (i >= n) spawn = grid.opposite(spawn.first, spawn.second);
+        AgentState agent;
+        agent.agent_id = data.agent_id;
+        agent.x = spawn.first;
+        agent.y = spawn.second;
+        agent.cooldown = 0;
+        agent.splash_bombs = data.splash_bombs;
+        agent.wetness = 0;
+        (i < n ? mine : enemies).push_back(agent);
+    }
+
+    // search_original narrates every decision; keep the table readable
+    cerr.setstate(ios::failbit);
+    if (reuse) return check_tree_reuse(mine, enemies, agent_data, board, turns, search_ms);
+
+    cout << "map " << grid.width << "x" << grid.height << ", " << 2 * n << " agents, " << search_ms << "ms searches, "
+         << thread::hardware_concurrency() << " hardware threads" << endl;
+    cout << "mode  threads  iterations/s  speedup  tree_nodes" << endl;
+
+    MergedSmitsimaxSearch search;
+    for (SearchParallelism mode : {ROOT_PARALLEL, TREE_PARALLEL}) {
+        double single_thread_rate = 0;
+        for (int threads = 1; threads <= max_threads; threads++) {
+            search.set_parallelism(threads, mode);
+            // Untimed warm-up: new workers allocate their arenas on first use
+            search.initialize(mine, enemies, agent_data, board);
+            search.search_original(1);
+            long long iterations = 0;
+            size_t nodes = 0;
+            auto start = chrono::steady_clock::now();
+            for (int r = 0; r < repeats; r++) {
+                search.initialize(mine, enemies, agent_data, board);
+                search.search_original(search_ms);
+                iterations += search.iterations_last_search();
+                nodes = max(nodes, search.tree_nodes_last_search());
+            }
+            double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+            double rate = iterations / seconds;
+            if (threads == 1) single_thread_rate = rate;
+            cout << (mode == ROOT_PARALLEL ? "root  " : "tree  ") << setw(7) << threads << setw(14)
+                 << (long long)rate << setw(9) << fixed << setprecision(2) << rate / single_thread_rate
+                 << setw(12) << nodes << endl;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,103 @@
+// ZONE KERNEL CHECK
+// Equivalence check for zone_kernel.h. Each random position is counted with
+// count_control_zones_scalar and with every SIMD kernel this CPU supports,
+// and the per-team tile counts must be identical. Maps range from 1x1 to
+// 21x12, so the last lane vector is often partly padding. Teams have 0 to 5
+// agents, and agents may share tiles. Wetness falls on both sides of 50 and
+// of 100, which covers weighted distances, ties, and teams with no live
+// agent. The tool then times each kernel on the same positions.
+//
+//   g++ -std=c++17 -O2 -o zone_kernel_check tools/zone_kernel_check.cpp
+//   zone_kernel_check [positions] [seed]
+//
+// Exits with 1 on the first position where a kernel disagrees.
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "../zone_kernel.h"
+using namespace std;
+
+struct Position {
+    int width, height, count, split;
+    int8_t x[ZoneAgents::MAX_AGENTS], y[ZoneAgents::MAX_AGENTS];
+    int16_t wetness[ZoneAgents::MAX_AGENTS];
+};
+
+struct NamedKernel {
+    const char* name;
+    ZoneKernel kernel;
+};
+
+int main(int argc, char** argv) {
+    int positions = argc > 1 ? atoi(argv[1]) : 20000;
+    unsigned seed = argc > 2 ? (unsigned)atoi(argv[2]) : 1;
+
+    vector<NamedKernel> kernels = {{"scalar", count_control_zones_scalar}};
+#ifdef ZONE_KERNEL_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("sse2")) kernels.push_back({"sse2", count_control_zones_sse2});
+    if (__builtin_cpu_supports("avx2")) kernels.push_back({"avx2", count_control_zones_avx2});
+#endif
+
+    mt19937 rng(seed);
+    const int16_t wetness_steps[] = {0, 1, 49, 50, 51, 99, 100, 120};
+    vector<Position> cases(positions);
+    for (Position& p : cases) {
+        p.height = uniform_int_distribution<>(1, 12)(rng);
+        p.width = uniform_int_distribution<>(1, 21)(rng);
+        int team_size[2] = {uniform_int_distribution<>(0, 5)(rng), uniform_int_distribution<>(0, 5)(rng)};
+        p.split = team_size[0];
+        p.count = team_size[0] + team_size[1];
+        for (int a = 0; a < p.count; a++) {
+            p.x[a] = (int8_t)uniform_int_distribution<>(0, p.width - 1)(rng);
+            p.y[a] = (int8_t)uniform_int_distribution<>(0, p.height - 1)(rng);
+            bool step = uniform_int_distribution<>(0, 1)(rng);
+            p.wetness[a] = step ? wetness_steps[uniform_int_distribution<>(0, 7)(rng)]
+                                : (int16_t)uniform_int_distribution<>(0, 100)(rng);
+        }
+    }
+
+    ZoneGrid grid;
+    for (int c = 0; c < positions; c++) {
+        const Position& p = cases[c];
+        grid.init(p.width, p.height);
+        ZoneAgents agents(p.count, p.split, p.x, p.y, p.wetness);
+        int expected[2];
+        count_control_zones_scalar(grid, agents, expected);
+        for (size_t k = 1; k < kernels.size(); k++) {
+            int owned[2];
+            kernels[k].kernel(grid, agents, owned);
+            if (owned[0] == expected[0] && owned[1] == expected[1]) continue;
+            cout << "position " << c << " (" << p.width << "x" << p.height << ", " << p.split << " vs "
+                 << p.count - p.split << " agents): " << kernels[k].name << " counts " << owned[0] << "/" << owned[1]
+                 << ", scalar " << expected[0] << "/" << expected[1] << endl;
+            return 1;
+        }
+    }
+    cout << positions << " positions, kernels agree:";
+    for (const NamedKernel& k : kernels) cout << " " << k.name;
+    cout << endl;
+
+    // The first positions' grids are built up front and cycled through, so
+    // only the kernels are timed
+    vector<ZoneGrid> grids(min(positions, 256));
+    for (size_t g = 0; g < grids.size(); g++) grids[g].init(cases[g].width, cases[g].height);
+    for (const NamedKernel& k : kernels) {
+        long long checksum = 0;
+        auto start = chrono::steady_clock::now();
+        for (int c = 0; c < positions; c++) {
+            const Position& p = cases[c % grids.size()];
+            const ZoneGrid& g = grids[c % grids.size()];
+            int owned[2];
+            k.kernel(g, ZoneAgents(p.count, p.split, p.x, p.y, p.wetness), owned);
+            checksum += owned[0] - owned[1];
+        }
+        double ns = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count();
+        cout << setw(7) << k.name << ": " << fixed << setprecision(1) << ns / positions << " ns per position"
+             << " (checksum " << checksum << ")" << endl;
+    }
+    return 0;
+}
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// TRANSPOSITION TABLE
+// Fixed-size table from Zobrist keys to a value and a visit count, shared by
+// every search thread without locks. Each entry is two 64-bit words, the data
+// and key ^ data (Hyatt's lockless hashing): a probe accepts an entry only if
+// the two words agree with its key, so an entry torn by concurrent writers
+// reads as a miss instead of as someone else's data.
+//
+// Entries sit in buckets of four, one cache line. A store overwrites its own
+// key's entry if the bucket has one; otherwise it takes an empty entry, then
+// one from an older generation, then the one with the fewest visits.
+
+struct TranspositionData {
+    float value = 0;       // Mean score, or a cached evaluation
+    uint32_t visits = 0;   // Saturates at 2^24 - 1
+};
+
+class TranspositionTable {
+public:
+    static const int BUCKET_ENTRIES = 4;
+
+    // 2^log2_buckets buckets of 64 bytes
+    explicit TranspositionTable(int log2_buckets) : buckets(size_t(1) << log2_buckets), mask((uint64_t(1) << log2_buckets) - 1) {}
+
+    // Entries from before the next call lose ties for replacement
+    void new_generation() { generation = generation == 255 ? 1 : (uint8_t)(generation + 1); }
+
+    // current_only skips entries stored before the last new_generation(),
+    // for data that goes stale between searches (node statistics) as opposed
+    // to data that never does (a position's evaluation)
+    bool probe(uint64_t key, TranspositionData& out, bool current_only = false) const {
+        const Bucket& bucket = buckets[key & mask];
+        for (int i = 0; i < BUCKET_ENTRIES; i++) {
+            uint64_t data = bucket.data[i].load(std::memory_order_relaxed);
+            uint64_t check = bucket.check[i].load(std::memory_order_relaxed);
+            if ((check ^ data) == key && data != 0) {
+                if (current_only && generation_of(data) != generation) return false;
+                out = unpack(data);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void store(uint64_t key, const TranspositionData& entry) {
+        Bucket& bucket = buckets[key & mask];
+        int victim = 0;
+        long long victim_priority = -1;
+        for (int i = 0; i < BUCKET_ENTRIES; i++) {
+            uint64_t data = bucket.data[i].load(std::memory_order_relaxed);
+            uint64_t check = bucket.check[i].load(std::memory_order_relaxed);
+            if (data == 0 || (check ^ data) == key) {
+                victim = i;
+                break;
+            }
+            long long priority = (long long)(visits_of(data)) + (generation_of(data) == generation ? (1LL << 32) : 0);
+            if (victim_priority < 0 || priority < victim_priority) {
+                victim = i;
+                victim_priority = priority;
+            }
+        }
+        uint64_t data = pack(entry);
+        bucket.data[victim].store(data, std::memory_order_relaxed);
+        bucket.check[victim].store(key ^ data, std::memory_order_relaxed);
+    }
+
+    // Only while no thread is probing or storing
+    void clear() {
+        for (Bucket& bucket : buckets) {
+            for (int i = 0; i < BUCKET_ENTRIES; i++) {
+                bucket.data[i].store(0, std::memory_order_relaxed);
+                bucket.check[i].store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+
+private:
+    struct alignas(64) Bucket {
+        std::atomic<uint64_t> data[BUCKET_ENTRIES];
+        std::atomic<uint64_t> check[BUCKET_ENTRIES];
+
+        Bucket() {
+            for (int i = 0; i < BUCKET_ENTRIES; i++) {
+                data[i].store(0, std::memory_order_relaxed);
+                check[i].store(0, std::memory_order_relaxed);
+            }
+        }
+    };
+
+    std::vector<Bucket> buckets;
+    uint64_t mask;
+    uint8_t generation = 1;  // Never 0, so a stored entry's data is never 0
+
+    static uint32_t visits_of(uint64_t data) { return (uint32_t)(data >> 8) & 0xFFFFFF; }
+    static uint8_t generation_of(uint64_t data) { return (uint8_t)data; }
+
+    // value:32 | visits:24 | generation:8
+    uint64_t pack(const TranspositionData& entry) const {
+        uint32_t bits;
+        std::memcpy(&bits, &entry.value, sizeof(bits));
+        uint32_t visits = entry.visits < 0xFFFFFF ? entry.visits : 0xFFFFFF;
+        return ((uint64_t)bits << 32) | ((uint64_t)visits << 8) | generation;
+    }
+
+    static TranspositionData unpack(uint64_t data) {
+        TranspositionData entry;
+        uint32_t bits = (uint32_t)(data >> 32);
+        std::memcpy(&entry.value, &bits, sizeof(bits));
+        entry.visits = visits_of(data);
+        return entry;
+    }
+};
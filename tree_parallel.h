@@ -0,0 +1,67 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+// TREE PARALLEL SEARCH
+// Building blocks for Smitsimax trees that every worker thread descends at
+// once: a node pool whose ranges are claimed with one fetch_add, an atomic
+// add for score sums, and a one-shot expansion claim so exactly one thread
+// creates a node's children without taking a lock. Virtual loss is the
+// searcher's business: it adds a visit and a pessimistic score to a node on
+// the way down and takes the pessimism back when the real score arrives, so
+// threads descending at the same time spread over different children.
+
+// fetch_add for doubles is C++20; a CAS loop does the same on C++17
+inline void atomic_add(std::atomic<double>& target, double value) {
+    double current = target.load(std::memory_order_relaxed);
+    while (!target.compare_exchange_weak(current, current + value, std::memory_order_relaxed)) {
+    }
+}
+
+// Expansion state of a shared node. A thread that wins the
+// EXPAND_NONE -> EXPAND_BUSY exchange writes the children and then publishes
+// their count with a release store; the others keep treating the node as a
+// leaf until they see the count.
+enum ExpandState { EXPAND_NONE = 0, EXPAND_BUSY = 1 };
+
+inline bool claim_expansion(std::atomic<int>& state) {
+    int expected = EXPAND_NONE;
+    return state.load(std::memory_order_relaxed) == EXPAND_NONE &&
+           state.compare_exchange_strong(expected, EXPAND_BUSY, std::memory_order_acq_rel);
+}
+
+// Fixed-capacity pool like NodeArena, but safe to allocate from concurrently.
+// Slots are handed out as contiguous ranges so siblings stay back to back.
+template <typename Node>
+class SharedNodeArena {
+public:
+    static const int NONE = -1;
+
+    explicit SharedNodeArena(size_t capacity) : nodes(capacity), used(0) {}
+
+    // First index of count fresh slots, or NONE once the pool is exhausted.
+    // A failed claim still advances the cursor, which only matters to size().
+    int allocate_range(int count) {
+        size_t first = used.fetch_add(count, std::memory_order_relaxed);
+        if (first + count > nodes.size()) return NONE;
+        return (int)first;
+    }
+
+    // Only while no worker is running
+    void reset() { used.store(0, std::memory_order_relaxed); }
+
+    Node& operator[](int index) { return nodes[index]; }
+    const Node& operator[](int index) const { return nodes[index]; }
+
+    size_t size() const {
+        size_t n = used.load(std::memory_order_relaxed);
+        return n < nodes.size() ? n : nodes.size();
+    }
+    size_t capacity() const { return nodes.size(); }
+
+private:
+    std::vector<Node> nodes;
+    std::atomic<size_t> used;
+};
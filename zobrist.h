@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+
+// ZOBRIST KEYS
+// One random 64-bit key per (agent slot, feature value); a state's hash is the
+// XOR of the keys of its current values, so changing one field costs two
+// XORs. The features are what a turn-start state holds per slot: position,
+// wetness, cooldown and balloons. Hunker flags only exist inside a turn
+// (Agent.reset clears them before the bots read the state), so they are not
+// part of it. Wetness is bucketed at 100: every soaked agent looks the same.
+//
+// Keys come from splitmix64 with a fixed seed, so hashes are stable across
+// runs and processes.
+
+const int ZOBRIST_MAX_SLOTS = 10;
+const int ZOBRIST_COORD_BITS = 5;                 // x < 32, y < 16
+const int ZOBRIST_POSITIONS = 32 * 16;
+const int ZOBRIST_WETNESS_BUCKETS = 101;
+const int ZOBRIST_COUNTER_VALUES = 16;            // Cooldowns and balloons
+
+struct ZobristKeys {
+    uint64_t position[ZOBRIST_MAX_SLOTS][ZOBRIST_POSITIONS];
+    uint64_t wetness[ZOBRIST_MAX_SLOTS][ZOBRIST_WETNESS_BUCKETS];
+    uint64_t cooldown[ZOBRIST_MAX_SLOTS][ZOBRIST_COUNTER_VALUES];
+    uint64_t balloons[ZOBRIST_MAX_SLOTS][ZOBRIST_COUNTER_VALUES];
+    uint64_t agent_id[ZOBRIST_MAX_SLOTS][256];    // Which agent a slot holds, for per-game salts
+    uint64_t side[ZOBRIST_MAX_SLOTS];             // Whose evaluation a cached score is
+
+    ZobristKeys() {
+        uint64_t seed = 0x5EED2025C0DE1234ULL;
+        fill(&position[0][0], ZOBRIST_MAX_SLOTS * ZOBRIST_POSITIONS, seed);
+        fill(&wetness[0][0], ZOBRIST_MAX_SLOTS * ZOBRIST_WETNESS_BUCKETS, seed);
+        fill(&cooldown[0][0], ZOBRIST_MAX_SLOTS * ZOBRIST_COUNTER_VALUES, seed);
+        fill(&balloons[0][0], ZOBRIST_MAX_SLOTS * ZOBRIST_COUNTER_VALUES, seed);
+        fill(&agent_id[0][0], ZOBRIST_MAX_SLOTS * 256, seed);
+        fill(side, ZOBRIST_MAX_SLOTS, seed);
+    }
+
+    uint64_t at(int slot, int x, int y) const {
+        return position[slot][((y & 15) << ZOBRIST_COORD_BITS) | (x & 31)];
+    }
+    uint64_t wet(int slot, int value) const {
+        return wetness[slot][value < 0 ? 0 : (value > 100 ? 100 : value)];
+    }
+    uint64_t cool(int slot, int value) const { return cooldown[slot][value & (ZOBRIST_COUNTER_VALUES - 1)]; }
+    uint64_t bombs(int slot, int value) const { return balloons[slot][value & (ZOBRIST_COUNTER_VALUES - 1)]; }
+
+private:
+    static void fill(uint64_t* keys, int count, uint64_t& seed) {
+        for (int i = 0; i < count; i++) {
+            uint64_t z = (seed += 0x9E3779B97F4A7C15ULL);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            keys[i] = z ^ (z >> 31);
+        }
+    }
+};
+
+// Built on first use; thread-safe static initialisation
+inline const ZobristKeys& zobrist_keys() {
+    static const ZobristKeys keys;
+    return keys;
+}
@@ -0,0 +1,175 @@
+#pragma once
+
+#include <cstdint>
+#include "bitboard.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define ZONE_KERNEL_X86 1
+#endif
+
+// CONTROL ZONE KERNEL
+// Full-board territory count with the Game.updateControlZones rules: a tile
+// belongs to a team when that team's closest live agent is strictly closer than
+// the other team's, Manhattan distance doubled for wetness >= 50, agents at 100
+// wetness ignored. Agents [0, split) are team 0 and [split, count) are team 1.
+//
+// Tiles are laid out flat (tile y * width + x) in int16 lanes: 16 per AVX2
+// register, 8 per SSE2 register. For every lane vector the kernel folds each
+// agent's weighted distance into a running per-team minimum, then counts lanes
+// where one minimum is strictly below the other. Distances never exceed
+// 2 * (19 + 11), so int16 is exact. The kernel is picked once at runtime from
+// the CPU features; the scalar loop is the reference and the fallback.
+
+struct ZoneGrid {
+    static const int MAX_TILES = BoardGeometry::MAX_TILES;
+    static const int16_t FAR = 0x7fff;    // Team without live agents
+
+    int width = 0, height = 0;
+    int tiles = 0;                        // width * height, capped at MAX_TILES
+    alignas(32) int16_t tx[MAX_TILES];
+    alignas(32) int16_t ty[MAX_TILES];
+    alignas(32) int16_t valid[MAX_TILES]; // -1 on map tiles, 0 on padding lanes
+
+    void init(int w, int h) {
+        width = w;
+        height = h;
+        tiles = w * h < MAX_TILES ? w * h : MAX_TILES;
+        for (int t = 0; t < MAX_TILES; t++) {
+            bool on_map = t < tiles;
+            tx[t] = (int16_t)(on_map ? t % w : 0);
+            ty[t] = (int16_t)(on_map ? t / w : 0);
+            valid[t] = (int16_t)(on_map ? -1 : 0);
+        }
+    }
+};
+
+// Live agents of both teams in the shape every kernel consumes
+struct ZoneAgents {
+    static const int MAX_AGENTS = 10;
+
+    int count[2] = {0, 0};
+    int16_t x[2][MAX_AGENTS], y[2][MAX_AGENTS], weight[2][MAX_AGENTS];
+
+    ZoneAgents(int agent_count, int split, const int8_t* ax, const int8_t* ay, const int16_t* wetness) {
+        for (int a = 0; a < agent_count && a < MAX_AGENTS; a++) {
+            if (wetness[a] >= 100) continue;
+            int team = a < split ? 0 : 1;
+            int i = count[team]++;
+            x[team][i] = ax[a];
+            y[team][i] = ay[a];
+            weight[team][i] = wetness[a] >= 50 ? 2 : 1;
+        }
+    }
+};
+
+inline void count_control_zones_scalar(const ZoneGrid& grid, const ZoneAgents& agents, int owned[2]) {
+    owned[0] = owned[1] = 0;
+    for (int t = 0; t < grid.tiles; t++) {
+        int best[2] = {ZoneGrid::FAR, ZoneGrid::FAR};
+        for (int team = 0; team < 2; team++) {
+            for (int i = 0; i < agents.count[team]; i++) {
+                int dx = grid.tx[t] - agents.x[team][i], dy = grid.ty[t] - agents.y[team][i];
+                int d = agents.weight[team][i] * ((dx < 0 ? -dx : dx) + (dy < 0 ? -dy : dy));
+                if (d < best[team]) best[team] = d;
+            }
+        }
+        if (best[0] < best[1]) owned[0]++;
+        else if (best[1] < best[0]) owned[1]++;
+    }
+}
+
+#ifdef ZONE_KERNEL_X86
+
+__attribute__((target("sse2")))
+inline void count_control_zones_sse2(const ZoneGrid& grid, const ZoneAgents& agents, int owned[2]) {
+    __m128i ax[2][ZoneAgents::MAX_AGENTS], ay[2][ZoneAgents::MAX_AGENTS], aw[2][ZoneAgents::MAX_AGENTS];
+    for (int team = 0; team < 2; team++) {
+        for (int i = 0; i < agents.count[team]; i++) {
+            ax[team][i] = _mm_set1_epi16(agents.x[team][i]);
+            ay[team][i] = _mm_set1_epi16(agents.y[team][i]);
+            aw[team][i] = _mm_set1_epi16(agents.weight[team][i]);
+        }
+    }
+
+    int wins[2] = {0, 0};
+    for (int t = 0; t < grid.tiles; t += 8) {
+        __m128i tx = _mm_load_si128((const __m128i*)(grid.tx + t));
+        __m128i ty = _mm_load_si128((const __m128i*)(grid.ty + t));
+        __m128i best[2];
+        for (int team = 0; team < 2; team++) {
+            best[team] = _mm_set1_epi16(ZoneGrid::FAR);
+            for (int i = 0; i < agents.count[team]; i++) {
+                // SSE2 has no 16-bit abs, so |a - b| is max(a - b, b - a)
+                __m128i dx = _mm_max_epi16(_mm_sub_epi16(tx, ax[team][i]), _mm_sub_epi16(ax[team][i], tx));
+                __m128i dy = _mm_max_epi16(_mm_sub_epi16(ty, ay[team][i]), _mm_sub_epi16(ay[team][i], ty));
+                __m128i d = _mm_mullo_epi16(_mm_add_epi16(dx, dy), aw[team][i]);
+                best[team] = _mm_min_epi16(best[team], d);
+            }
+        }
+        __m128i valid = _mm_load_si128((const __m128i*)(grid.valid + t));
+        __m128i mine = _mm_and_si128(_mm_cmplt_epi16(best[0], best[1]), valid);
+        __m128i theirs = _mm_and_si128(_mm_cmplt_epi16(best[1], best[0]), valid);
+        // movemask yields two bits per int16 lane
+        wins[0] += __builtin_popcount(_mm_movemask_epi8(mine));
+        wins[1] += __builtin_popcount(_mm_movemask_epi8(theirs));
+    }
+    owned[0] = wins[0] / 2;
+    owned[1] = wins[1] / 2;
+}
+
+__attribute__((target("avx2")))
+inline void count_control_zones_avx2(const ZoneGrid& grid, const ZoneAgents& agents, int owned[2]) {
+    __m256i ax[2][ZoneAgents::MAX_AGENTS], ay[2][ZoneAgents::MAX_AGENTS], aw[2][ZoneAgents::MAX_AGENTS];
+    for (int team = 0; team < 2; team++) {
+        for (int i = 0; i < agents.count[team]; i++) {
+            ax[team][i] = _mm256_set1_epi16(agents.x[team][i]);
+            ay[team][i] = _mm256_set1_epi16(agents.y[team][i]);
+            aw[team][i] = _mm256_set1_epi16(agents.weight[team][i]);
+        }
+    }
+
+    int wins[2] = {0, 0};
+    for (int t = 0; t < grid.tiles; t += 16) {
+        __m256i tx = _mm256_load_si256((const __m256i*)(grid.tx + t));
+        __m256i ty = _mm256_load_si256((const __m256i*)(grid.ty + t));
+        __m256i best[2];
+        for (int team = 0; team < 2; team++) {
+            best[team] = _mm256_set1_epi16(ZoneGrid::FAR);
+            for (int i = 0; i < agents.count[team]; i++) {
+                __m256i dx = _mm256_abs_epi16(_mm256_sub_epi16(tx, ax[team][i]));
+                __m256i dy = _mm256_abs_epi16(_mm256_sub_epi16(ty, ay[team][i]));
+                __m256i d = _mm256_mullo_epi16(_mm256_add_epi16(dx, dy), aw[team][i]);
+                best[team] = _mm256_min_epi16(best[team], d);
+            }
+        }
+        __m256i valid = _mm256_load_si256((const __m256i*)(grid.valid + t));
+        __m256i mine = _mm256_and_si256(_mm256_cmpgt_epi16(best[1], best[0]), valid);
+        __m256i theirs = _mm256_and_si256(_mm256_cmpgt_epi16(best[0], best[1]), valid);
+        wins[0] += __builtin_popcount((unsigned)_mm256_movemask_epi8(mine));
+        wins[1] += __builtin_popcount((unsigned)_mm256_movemask_epi8(theirs));
+    }
+    owned[0] = wins[0] / 2;
+    owned[1] = wins[1] / 2;
+}
+
+#endif
+
+typedef void (*ZoneKernel)(const ZoneGrid&, const ZoneAgents&, int[2]);
+
+// Best kernel this CPU supports, resolved on first use
+inline ZoneKernel select_zone_kernel() {
+#ifdef ZONE_KERNEL_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return count_control_zones_avx2;
+    if (__builtin_cpu_supports("sse2")) return count_control_zones_sse2;
+#endif
+    return count_control_zones_scalar;
+}
+
+// Tiles controlled by each team; owned[0] is the team of agents [0, split)
+inline void count_control_zones(const ZoneGrid& grid, int agent_count, int split, const int8_t* x,
+                                const int8_t* y, const int16_t* wetness, int owned[2]) {
+    static const ZoneKernel kernel = select_zone_kernel();
+    kernel(grid, ZoneAgents(agent_count, split, x, y, wetness), owned);
+}